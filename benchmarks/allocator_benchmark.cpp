@@ -0,0 +1,65 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../include/kernels/memory.hpp"
+#include "../include/types/vector.hpp"
+
+// c = a + b на векторах, выделенных с большими страницами и без них
+static void BM_StreamAdd(benchmark::State& state) {
+    const size_t n = state.range(0);
+    kernels::AlignedResource resource(state.range(1) ? kernels::kHugePageThreshold : SIZE_MAX);
+    Vector<double> a(n, &resource), b(n, &resource), c(n, &resource);
+    a += 1.0;
+    b += 2.0;
+    for (auto _ : state) {
+        c = a + b;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 3 * n * sizeof(double));
+}
+BENCHMARK(BM_StreamAdd)->ArgNames({"n", "huge"})->Args({1 << 23, 0})->Args({1 << 23, 1});
+
+// Тот же кернел на данных, сдвинутых на offset элементов от границы строки кэша
+static void BM_OffsetAdd(benchmark::State& state) {
+    const size_t n = 1 << 12;
+    const size_t offset = state.range(0);
+    Vector<float> a(n + offset), b(n + offset), c(n + offset);
+    a += 1.0f;
+    b += 2.0f;
+    for (auto _ : state) {
+        c.slice(offset, n) = a.slice(offset, n) + b.slice(offset, n);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 3 * n * sizeof(float));
+}
+BENCHMARK(BM_OffsetAdd)->ArgName("offset")->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,89 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/types/matrix.hpp"
+
+// Сумма элементов вектора через operator[] при разных политиках проверки индексов
+template<typename Bounds>
+static void BM_VectorSubscript(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Vector<double, Dynamic, Bounds> v(n);
+    v += 1.0;
+    for (auto _ : state) {
+        double sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            sum += v[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+}
+BENCHMARK_TEMPLATE(BM_VectorSubscript, Checked)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_VectorSubscript, Unchecked)->Arg(1 << 16);
+
+// Тот же цикл по сырым указателям begin()/end()
+static void BM_VectorPointer(benchmark::State& state) {
+    const size_t n = state.range(0);
+    Vector<double> v(n);
+    v += 1.0;
+    for (auto _ : state) {
+        double sum = 0;
+        for (const double* p = v.begin(); p != v.end(); ++p) {
+            sum += *p;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * n * sizeof(double));
+}
+BENCHMARK(BM_VectorPointer)->Arg(1 << 16);
+
+// Наивное произведение матриц через operator() при разных политиках
+template<typename Bounds>
+static void BM_MatrixElementLoop(benchmark::State& state) {
+    const int n = state.range(0);
+    Matrix<double, Dynamic, Dynamic, Bounds> a(n, n);
+    Matrix<double, Dynamic, Dynamic, Bounds> c(n, n);
+    ++a;
+    for (auto _ : state) {
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < n; ++k) {
+                const double aik = a(i, k);
+                for (int j = 0; j < n; ++j) {
+                    c(i, j) += aik * a(k, j);
+                }
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK_TEMPLATE(BM_MatrixElementLoop, Checked)->Arg(128);
+BENCHMARK_TEMPLATE(BM_MatrixElementLoop, Unchecked)->Arg(128);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,84 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include "../include/linalg/eigen.hpp"
+#include "../include/linalg/randomized_svd.hpp"
+#include "../include/linalg/svd.hpp"
+
+static Matrix<double> randomMatrix(int rows, int cols) {
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    Matrix<double> mat(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            mat(i, j) = dist(gen);
+        }
+    }
+    return mat;
+}
+
+// Собственные значения и векторы симметричной матрицы
+static void BM_SymmetricEigen(benchmark::State& state) {
+    const int n = state.range(0);
+    const bool vectors = state.range(1);
+    const Matrix<double> mat = randomMatrix(n, n);
+    for (auto _ : state) {
+        SymmetricEigen<double> eig(mat, vectors);
+        benchmark::DoNotOptimize(eig.getEigenvalues()[0]);
+    }
+}
+BENCHMARK(BM_SymmetricEigen)->Args({512, 0})->Args({512, 1})->Unit(benchmark::kMillisecond);
+
+// Тонкое SVD высокой матрицы
+static void BM_SVD(benchmark::State& state) {
+    const int m = state.range(0);
+    const int n = state.range(1);
+    const Matrix<double> mat = randomMatrix(m, n);
+    for (auto _ : state) {
+        SVD<double> svd(mat);
+        benchmark::DoNotOptimize(svd.getSingularValues()[0]);
+    }
+}
+BENCHMARK(BM_SVD)->Args({1024, 128})->Args({512, 512})->Unit(benchmark::kMillisecond);
+
+// Первые k сингулярных троек рандомизированным методом
+static void BM_RandomizedSVD(benchmark::State& state) {
+    const int m = state.range(0);
+    const int n = state.range(1);
+    const Matrix<double> mat = randomMatrix(m, n);
+    for (auto _ : state) {
+        RandomizedSVD<double> svd(mat, state.range(2));
+        benchmark::DoNotOptimize(svd.getError());
+    }
+}
+BENCHMARK(BM_RandomizedSVD)->Args({512, 512, 16})->Args({4096, 2048, 16})->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
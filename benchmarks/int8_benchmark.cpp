@@ -0,0 +1,106 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <random>
+#include "../include/types/quantized_matrix.hpp"
+
+namespace {
+
+Matrix<float> randomMatrix(int rows, int cols, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    Matrix<float> m(rows, cols);
+    for (float* p = m.begin(); p != m.end(); ++p) {
+        *p = dist(gen);
+    }
+    return m;
+}
+
+} // namespace
+
+// Произведение матриц во float для сравнения
+static void BM_FloatGemm(benchmark::State& state) {
+    const int n = state.range(0);
+    const Matrix<float> a = randomMatrix(n, n, 1);
+    const Matrix<float> b = randomMatrix(n, n, 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((a * b).begin());
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(n) * n * n);
+}
+BENCHMARK(BM_FloatGemm)->Arg(256)->Arg(512);
+
+// Квантованное произведение: ядро int8 и масштабирование результата;
+// counter "rel_error" — относительная ошибка по норме Фробениуса
+static void BM_QuantizedGemm(benchmark::State& state) {
+    const int n = state.range(0);
+    const Matrix<float> a = randomMatrix(n, n, 1);
+    const Matrix<float> b = randomMatrix(n, n, 2);
+    const auto qa = QuantizedMatrix<float>::quantize(a, QuantAxis::Row);
+    const auto qb = QuantizedMatrix<float>::quantize(b, QuantAxis::Column, QuantScheme::Symmetric);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((qa * qb).begin());
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(n) * n * n);
+
+    const Matrix<float> exact = a * b;
+    const Matrix<float> approx = qa * qb;
+    double err = 0;
+    double norm = 0;
+    for (size_t i = 0; i < size_t(n) * n; ++i) {
+        err += std::pow(approx.begin()[i] - exact.begin()[i], 2);
+        norm += std::pow(exact.begin()[i], 2);
+    }
+    state.counters["rel_error"] = std::sqrt(err / norm);
+}
+BENCHMARK(BM_QuantizedGemm)->Arg(256)->Arg(512);
+
+// Ядро int8 отдельно на каждом наборе инструкций
+static void BM_Int8Kernel(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const kernels::Isa isa = kernels::activeIsa();
+    kernels::setIsa(static_cast<kernels::Isa>(state.range(1)));
+    std::vector<std::int8_t> a(n * n, 3);
+    std::vector<std::int8_t> b(n * n, -5);
+    std::vector<std::int32_t> c(n * n);
+    for (auto _ : state) {
+        kernels::gemmInt8(n, n, n, a.data(), n, b.data(), n, c.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * int64_t(n) * n * n);
+    kernels::setIsa(isa);
+}
+BENCHMARK(BM_Int8Kernel)
+    ->Args({512, int(kernels::Isa::Scalar)})
+    ->Args({512, int(kernels::Isa::AVX2)})
+    ->Args({512, int(kernels::Isa::AVX512)});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,70 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/types/matrix.hpp"
+
+// Норма невязки ||A - 2B||: сначала матрица результата, потом редукция
+static void BM_ResidualMaterialized(benchmark::State& state) {
+    const int n = state.range(0);
+    Matrix<double> a(n, n), b(n, n);
+    ++a;
+    for (auto _ : state) {
+        const Matrix<double> r = a - b * 2.0;
+        benchmark::DoNotOptimize(r.frobeniusNorm());
+    }
+    state.SetBytesProcessed(state.iterations() * 2 * n * n * sizeof(double));
+}
+BENCHMARK(BM_ResidualMaterialized)->Arg(2048);
+
+// Та же норма по ленивому выражению, плитками в L1
+static void BM_ResidualFused(benchmark::State& state) {
+    const int n = state.range(0);
+    Matrix<double> a(n, n), b(n, n);
+    ++a;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize((a - b * 2.0).frobeniusNorm());
+    }
+    state.SetBytesProcessed(state.iterations() * 2 * n * n * sizeof(double));
+}
+BENCHMARK(BM_ResidualFused)->Arg(2048);
+
+// Обновление A += alpha * B на месте
+static void BM_UpdateInPlace(benchmark::State& state) {
+    const int n = state.range(0);
+    Matrix<double> a(n, n), b(n, n);
+    for (auto _ : state) {
+        a += b * 0.5;
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * 3 * n * n * sizeof(double));
+}
+BENCHMARK(BM_UpdateInPlace)->Arg(2048);
+
+BENCHMARK_MAIN();
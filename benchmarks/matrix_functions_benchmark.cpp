@@ -0,0 +1,89 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include "../include/linalg/matrix_functions.hpp"
+
+// Переходная матрица цепи Маркова: строки суммируются в единицу
+static Matrix<double> transitionMatrix(int n) {
+    Matrix<double> mat(n, n);
+    for (int i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < n; ++j) {
+            mat(i, j) = 1.0 + (i * 7 + j * 13) % 5;
+            sum += mat(i, j);
+        }
+        for (int j = 0; j < n; ++j) {
+            mat(i, j) /= sum;
+        }
+    }
+    return mat;
+}
+
+// k - 1 последовательных умножений
+static void BM_PowRepeated(benchmark::State& state) {
+    const int n = state.range(0);
+    const int k = state.range(1);
+    const Matrix<double> mat = transitionMatrix(n);
+    for (auto _ : state) {
+        Matrix<double> result = mat;
+        for (int i = 1; i < k; ++i) {
+            result = result * mat;
+        }
+        benchmark::DoNotOptimize(result(0, 0));
+    }
+}
+BENCHMARK(BM_PowRepeated)->Args({128, 1000});
+
+// Возведение в степень квадрированием
+static void BM_PowSquaring(benchmark::State& state) {
+    const int n = state.range(0);
+    const int k = state.range(1);
+    const Matrix<double> mat = transitionMatrix(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pow(mat, k)(0, 0));
+    }
+}
+BENCHMARK(BM_PowSquaring)->Args({128, 1000});
+
+// Экспонента генератора с нормой, требующей масштабирования
+static void BM_Expm(benchmark::State& state) {
+    const int n = state.range(0);
+    Matrix<double> mat = transitionMatrix(n);
+    for (int i = 0; i < n; ++i) {
+        mat(i, i) -= 1.0;
+    }
+    mat *= 20.0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(expm(mat)(0, 0));
+    }
+}
+BENCHMARK(BM_Expm)->Arg(128);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,436 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_BLAS_H
+#define KERNELS_BLAS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "convert.hpp"
+#include "thread_pool.hpp"
+
+/**
+ * Blocked level-3 kernels on raw row-major storage.
+ *
+ * Every matrix argument is a pointer to its first element plus a leading
+ * dimension (the distance between consecutive rows), so the kernels can
+ * work on sub-blocks of a larger buffer without copying.
+ */
+namespace kernels {
+
+enum class Op { NoTrans, Trans };
+enum class Uplo { Lower, Upper };
+enum class Diag { NonUnit, Unit };
+enum class Side { Left, Right };
+
+constexpr size_t kBlockSize = 64;          ///< Panel width used by the blocked factorizations.
+constexpr size_t kGemmMC = 64;             ///< Rows of op(A) packed per tile.
+constexpr size_t kGemmKC = 256;            ///< Inner dimension packed per tile.
+constexpr size_t kGemmNC = 512;            ///< Columns of op(B) packed per tile.
+constexpr size_t kParallelFlops = 1 << 18; ///< Below this many multiply-adds the kernels stay serial.
+constexpr size_t kStreamGrain = 1 << 15;   ///< Elements per task for memory-bound kernels.
+constexpr size_t kLanes = 8;               ///< Independent accumulators in reductions.
+
+/**
+ * @brief Dot product of two contiguous arrays.
+ *
+ * Keeps kLanes independent partial sums so the loop maps onto SIMD
+ * registers and is not serialized on a single accumulator. Half and
+ * BFloat16 products are summed in float.
+ */
+template<typename T>
+inline T dot(size_t n, const T* x, const T* y) {
+    using A = Widened<T>;
+    A acc[kLanes] = {};
+    size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            acc[l] += x[i + l] * y[i + l];
+        }
+    }
+    A sum = A(0);
+    for (; i < n; ++i) {
+        sum += x[i] * y[i];
+    }
+    for (size_t l = 0; l < kLanes; ++l) {
+        sum += acc[l];
+    }
+    return sum;
+}
+
+/**
+ * @brief y += alpha * x on contiguous arrays.
+ */
+template<typename T>
+inline void axpy(size_t n, T alpha, const T* x, T* y) {
+    for (size_t i = 0; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+/**
+ * @brief Matrix-vector product: y = alpha * op(A) * x + beta * y.
+ *
+ * A is m x n and is read through @p row, which returns a pointer to the
+ * first element of row i; rows must be contiguous but need not be
+ * adjacent. Each element of A is read exactly once. The plain product
+ * splits row blocks across the pool; the transposed product splits column
+ * stripes, so neither needs per-thread reduction buffers.
+ *
+ * @param row Callable mapping a row index to a const T*.
+ * @param x Input of length n (or m when transposed).
+ * @param y Output of length m (or n when transposed).
+ */
+template<typename T, typename RowFn>
+void gemv(Op op, size_t m, size_t n, T alpha, RowFn&& row, const T* x, T beta, T* y) {
+    const size_t outLength = op == Op::NoTrans ? m : n;
+    for (size_t i = 0; i < outLength; ++i) {
+        y[i] = beta == T(0) ? T(0) : T(beta * y[i]);
+    }
+    if (m == 0 || n == 0 || alpha == T(0)) {
+        return;
+    }
+    const bool serial = m * n < 2 * kStreamGrain;
+    if (op == Op::NoTrans) {
+        auto rows = [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                y[i] += alpha * dot(n, row(i), x);
+            }
+        };
+        if (serial) {
+            rows(0, m);
+        } else {
+            parallel_for(0, m, std::max<size_t>(1, kStreamGrain / n), rows);
+        }
+    } else {
+        auto stripe = [&](size_t lo, size_t hi) {
+            for (size_t i = 0; i < m; ++i) {
+                axpy(hi - lo, T(alpha * x[i]), row(i) + lo, y + lo);
+            }
+        };
+        if (serial) {
+            stripe(0, n);
+        } else {
+            const size_t width = std::max<size_t>(64, kStreamGrain / m) / kLanes * kLanes;
+            parallel_for(0, n, width, stripe);
+        }
+    }
+}
+
+/**
+ * @brief Returns a pointer to element (r, c) of op(A).
+ */
+template<typename T>
+inline const T* at(Op op, const T* A, size_t lda, size_t r, size_t c) {
+    return op == Op::NoTrans ? A + r * lda + c : A + c * lda + r;
+}
+
+/**
+ * @brief Copies a rows x cols block of op(A), scaled by alpha, into dst of type P.
+ */
+template<typename T, typename P>
+inline void pack(Op op, const T* A, size_t lda, size_t rows, size_t cols, P alpha, P* dst) {
+    if (op == Op::NoTrans) {
+        for (size_t i = 0; i < rows; ++i) {
+            const T* src = A + i * lda;
+            for (size_t j = 0; j < cols; ++j) {
+                dst[i * cols + j] = alpha * P(src[j]);
+            }
+        }
+    } else {
+        for (size_t j = 0; j < cols; ++j) {
+            const T* src = A + j * lda;
+            for (size_t i = 0; i < rows; ++i) {
+                dst[i * cols + j] = alpha * P(src[i]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief C += a * b on packed panels, four rows of C at a time.
+ */
+template<typename T>
+inline void gemmMicro(size_t mc, size_t nc, size_t kc, const T* a, const T* b, T* c, size_t ldc) {
+    size_t i = 0;
+    for (; i + 4 <= mc; i += 4) {
+        T* c0 = c + i * ldc;
+        T* c1 = c0 + ldc;
+        T* c2 = c1 + ldc;
+        T* c3 = c2 + ldc;
+        const T* a0 = a + i * kc;
+        for (size_t p = 0; p < kc; ++p) {
+            const T x0 = a0[p], x1 = a0[kc + p], x2 = a0[2 * kc + p], x3 = a0[3 * kc + p];
+            const T* bp = b + p * nc;
+            for (size_t j = 0; j < nc; ++j) {
+                const T bj = bp[j];
+                c0[j] += x0 * bj;
+                c1[j] += x1 * bj;
+                c2[j] += x2 * bj;
+                c3[j] += x3 * bj;
+            }
+        }
+    }
+    for (; i < mc; ++i) {
+        T* ci = c + i * ldc;
+        for (size_t p = 0; p < kc; ++p) {
+            const T x = a[i * kc + p];
+            const T* bp = b + p * nc;
+            for (size_t j = 0; j < nc; ++j) {
+                ci[j] += x * bp[j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief General matrix multiply: C = alpha * op(A) * op(B) + beta * C.
+ *
+ * C is split into MC x NC tiles that are computed independently, in
+ * parallel once the product is large enough.
+ *
+ * @param m Rows of op(A) and C.
+ * @param n Columns of op(B) and C.
+ * @param k Columns of op(A) and rows of op(B).
+ */
+template<typename T>
+void gemm(Op opA, Op opB, size_t m, size_t n, size_t k, T alpha, const T* A, size_t lda,
+          const T* B, size_t ldb, T beta, T* C, size_t ldc) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+    if (beta != T(1)) {
+        for (size_t i = 0; i < m; ++i) {
+            T* ci = C + i * ldc;
+            for (size_t j = 0; j < n; ++j) {
+                ci[j] = beta == T(0) ? T(0) : T(beta * ci[j]);
+            }
+        }
+    }
+    if (k == 0 || alpha == T(0)) {
+        return;
+    }
+
+    // Half and BFloat16 panels are widened while packing and each C tile
+    // is accumulated in float, so they are rounded once per element.
+    using P = Widened<T>;
+    const size_t rowTiles = (m + kGemmMC - 1) / kGemmMC;
+    const size_t colTiles = (n + kGemmNC - 1) / kGemmNC;
+    auto tile = [&](size_t t) {
+        thread_local std::vector<P> packA, packB, packC;
+        const size_t ic = (t / colTiles) * kGemmMC;
+        const size_t jc = (t % colTiles) * kGemmNC;
+        const size_t mc = std::min(kGemmMC, m - ic);
+        const size_t nc = std::min(kGemmNC, n - jc);
+        T* c = C + ic * ldc + jc;
+        P* acc;
+        size_t ldAcc;
+        if constexpr (kReducedFloat<T>) {
+            packC.resize(mc * nc);
+            for (size_t i = 0; i < mc; ++i) {
+                toFloat(nc, c + i * ldc, packC.data() + i * nc);
+            }
+            acc = packC.data();
+            ldAcc = nc;
+        } else {
+            acc = c;
+            ldAcc = ldc;
+        }
+        for (size_t pc = 0; pc < k; pc += kGemmKC) {
+            const size_t kc = std::min(kGemmKC, k - pc);
+            packA.resize(mc * kc);
+            packB.resize(kc * nc);
+            pack(opA, at(opA, A, lda, ic, pc), lda, mc, kc, P(alpha), packA.data());
+            pack(opB, at(opB, B, ldb, pc, jc), ldb, kc, nc, P(1), packB.data());
+            gemmMicro(mc, nc, kc, packA.data(), packB.data(), acc, ldAcc);
+        }
+        if constexpr (kReducedFloat<T>) {
+            for (size_t i = 0; i < mc; ++i) {
+                fromFloat(nc, packC.data() + i * nc, c + i * ldc);
+            }
+        }
+    };
+
+    const size_t tiles = rowTiles * colTiles;
+    if (m * n * k < kParallelFlops) {
+        for (size_t t = 0; t < tiles; ++t) {
+            tile(t);
+        }
+    } else {
+        ThreadPool::instance().run(tiles, tile);
+    }
+}
+
+/**
+ * @brief Symmetric rank-k update of the lower triangle: C = alpha * A * A^T + beta * C.
+ *
+ * C is n x n and A is n x k. Each block row of C is updated by gemm up to
+ * the end of its diagonal block, so entries above the diagonal inside the
+ * diagonal blocks are overwritten as well.
+ */
+template<typename T>
+void syrk(size_t n, size_t k, T alpha, const T* A, size_t lda, T beta, T* C, size_t ldc) {
+    if (n == 0) {
+        return;
+    }
+    const size_t blocks = (n + kBlockSize - 1) / kBlockSize;
+    auto blockRow = [&](size_t b) {
+        const size_t i0 = b * kBlockSize;
+        const size_t i1 = std::min(n, i0 + kBlockSize);
+        gemm(Op::NoTrans, Op::Trans, i1 - i0, i1, k, alpha, A + i0 * lda, lda, A, lda, beta,
+             C + i0 * ldc, ldc);
+    };
+    if (n * n * k / 2 < kParallelFlops) {
+        for (size_t b = 0; b < blocks; ++b) {
+            blockRow(b);
+        }
+    } else {
+        // The longest block rows come last; the pool hands them out dynamically.
+        ThreadPool::instance().run(blocks, [&](size_t b) { blockRow(blocks - 1 - b); });
+    }
+}
+
+/**
+ * @brief Solves a triangular system in place.
+ *
+ * Left side: op(A) * X = B, with A of size m x m.
+ * Right side: X * op(A) = B, with A of size n x n.
+ * B (m x n) is overwritten with X. Left-side solves are blocked so that
+ * the bulk of the work runs through gemm; right-side solves treat every
+ * row of B independently.
+ */
+template<typename T>
+void trsm(Side side, Uplo uplo, Op op, Diag diag, size_t m, size_t n, const T* A, size_t lda,
+          T* B, size_t ldb) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+    // After applying op, is the triangle stored below the diagonal?
+    const bool lower = (uplo == Uplo::Lower) != (op == Op::Trans);
+    const bool unit = diag == Diag::Unit;
+    auto a = [&](size_t r, size_t c) { return *at(op, A, lda, r, c); };
+
+    if (side == Side::Right) {
+        const size_t grain = std::max<size_t>(1, kParallelFlops / (n * n + 1));
+        parallel_for(0, m, grain, [&](size_t lo, size_t hi) {
+            for (size_t r = lo; r < hi; ++r) {
+                T* x = B + r * ldb;
+                // x * op(A) = b  <=>  op(A)^T * x^T = b^T
+                if (!lower) {
+                    for (size_t j = 0; j < n; ++j) {
+                        T sum = x[j];
+                        for (size_t p = 0; p < j; ++p) {
+                            sum -= x[p] * a(p, j);
+                        }
+                        x[j] = unit ? sum : sum / a(j, j);
+                    }
+                } else {
+                    for (size_t j = n; j-- > 0;) {
+                        T sum = x[j];
+                        for (size_t p = j + 1; p < n; ++p) {
+                            sum -= x[p] * a(p, j);
+                        }
+                        x[j] = unit ? sum : sum / a(j, j);
+                    }
+                }
+            }
+        });
+        return;
+    }
+
+    // Solves the diagonal block [k0, k1) for the columns [lo, hi) of B.
+    auto diagonal = [&](size_t k0, size_t k1, size_t lo, size_t hi) {
+        if (lower) {
+            for (size_t i = k0; i < k1; ++i) {
+                T* bi = B + i * ldb;
+                for (size_t p = k0; p < i; ++p) {
+                    const T f = a(i, p);
+                    const T* bp = B + p * ldb;
+                    for (size_t j = lo; j < hi; ++j) {
+                        bi[j] -= f * bp[j];
+                    }
+                }
+                if (!unit) {
+                    const T d = a(i, i);
+                    for (size_t j = lo; j < hi; ++j) {
+                        bi[j] /= d;
+                    }
+                }
+            }
+        } else {
+            for (size_t i = k1; i-- > k0;) {
+                T* bi = B + i * ldb;
+                for (size_t p = i + 1; p < k1; ++p) {
+                    const T f = a(i, p);
+                    const T* bp = B + p * ldb;
+                    for (size_t j = lo; j < hi; ++j) {
+                        bi[j] -= f * bp[j];
+                    }
+                }
+                if (!unit) {
+                    const T d = a(i, i);
+                    for (size_t j = lo; j < hi; ++j) {
+                        bi[j] /= d;
+                    }
+                }
+            }
+        }
+    };
+    auto solveBlock = [&](size_t k0, size_t k1) {
+        const size_t kb = k1 - k0;
+        const size_t grain = std::max<size_t>(64, kParallelFlops / (kb * kb + 1));
+        parallel_for(0, n, grain, [&](size_t lo, size_t hi) { diagonal(k0, k1, lo, hi); });
+    };
+
+    if (lower) {
+        for (size_t k0 = 0; k0 < m; k0 += kBlockSize) {
+            const size_t k1 = std::min(m, k0 + kBlockSize);
+            solveBlock(k0, k1);
+            if (k1 < m) {
+                gemm(op, Op::NoTrans, m - k1, n, k1 - k0, T(-1), at(op, A, lda, k1, k0), lda,
+                     B + k0 * ldb, ldb, T(1), B + k1 * ldb, ldb);
+            }
+        }
+    } else {
+        for (size_t k1 = m; k1 > 0;) {
+            const size_t k0 = k1 > kBlockSize ? k1 - kBlockSize : 0;
+            solveBlock(k0, k1);
+            if (k0 > 0) {
+                gemm(op, Op::NoTrans, k0, n, k1 - k0, T(-1), at(op, A, lda, 0, k0), lda,
+                     B + k0 * ldb, ldb, T(1), B, ldb);
+            }
+            k1 = k0;
+        }
+    }
+}
+
+} // namespace kernels
+
+#endif // KERNELS_BLAS_H
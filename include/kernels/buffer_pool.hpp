@@ -0,0 +1,317 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_BUFFER_POOL_H
+#define KERNELS_BUFFER_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+#include "memory.hpp"
+
+namespace kernels {
+
+constexpr size_t kPoolMinClassShift = 8;             ///< Smallest size class, 256 bytes.
+constexpr size_t kPoolMaxBlockBytes = size_t(64) << 20; ///< Larger blocks bypass the pool.
+
+/**
+ * @brief Counters of a BufferPool, updated by its owning thread only.
+ */
+struct PoolStats {
+    size_t requests = 0;      ///< Allocations made by the owning thread.
+    size_t reused = 0;        ///< Allocations served from a held block.
+    size_t bytesHeld = 0;     ///< Bytes in free blocks waiting for reuse.
+    size_t blocksHeld = 0;    ///< Free blocks waiting for reuse.
+    size_t peakBytesHeld = 0; ///< Largest bytesHeld seen.
+    size_t bytesTrimmed = 0;  ///< Bytes handed back upstream by trim() or the caps.
+
+    /**
+     * @brief Fraction of requests served without going upstream.
+     */
+    double reuseRate() const noexcept {
+        return requests ? static_cast<double>(reused) / static_cast<double>(requests) : 0.0;
+    }
+};
+
+/**
+ * @brief Caps on the free blocks a BufferPool keeps.
+ */
+struct PoolLimits {
+    size_t maxBytesHeld = size_t(256) << 20; ///< Free bytes kept across all size classes.
+    size_t maxBlocksPerClass = 16;           ///< Free blocks kept in one size class.
+};
+
+/**
+ * @class BufferPool
+ * @brief Size-classed memory resource that keeps freed blocks for reuse.
+ *
+ * Expressions evaluated in a loop free and allocate buffers of the same
+ * sizes over and over; the pool keeps them in free lists instead of
+ * returning them upstream. Sizes are rounded to four classes per power of
+ * two (at most 25% slack), blocks are cache-line aligned, and blocks over
+ * kPoolMaxBlockBytes or with a stricter alignment go straight upstream.
+ *
+ * A pool belongs to the thread that created it and needs no locks. A block
+ * allocated or freed on another thread (a copy detached inside a parallel
+ * task, a vector handed to a worker) goes straight upstream and is not
+ * counted. Route an evaluation through the pool with
+ * `ScopedResource scope(&BufferPool::local());`.
+ */
+class BufferPool final : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param limits Caps on the free blocks kept.
+     * @param upstream Where blocks come from; must outlive the pool.
+     */
+    explicit BufferPool(PoolLimits limits = {}, std::pmr::memory_resource* upstream = alignedResource())
+        : caps(limits), upstream(upstream), bins(classIndex(kPoolMaxBlockBytes) + 1) {
+        reserveBins(caps.maxBlocksPerClass);
+    }
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Destructor, hands every free block back upstream.
+     *
+     * A pool must outlive the buffers allocated from it; local() takes care
+     * of that itself.
+     */
+    ~BufferPool() override {
+        trim();
+    }
+
+    /**
+     * @brief Returns the calling thread's pool.
+     *
+     * It is released at thread exit once the last block allocated from it
+     * has been freed, so buffers may outlive the thread.
+     */
+    static BufferPool& local() {
+        struct Holder {
+            BufferPool* pool = new BufferPool();
+
+            ~Holder() {
+                pool->retire();
+            }
+        };
+        static thread_local Holder holder;
+        return *holder.pool;
+    }
+
+    /**
+     * @brief Returns the counters.
+     */
+    const PoolStats& stats() const noexcept {
+        return counters;
+    }
+
+    /**
+     * @brief Zeroes the request counters; the held totals stay.
+     */
+    void resetStats() noexcept {
+        counters.requests = 0;
+        counters.reused = 0;
+        counters.bytesTrimmed = 0;
+        counters.peakBytesHeld = counters.bytesHeld;
+    }
+
+    /**
+     * @brief Returns the caps.
+     */
+    const PoolLimits& limits() const noexcept {
+        return caps;
+    }
+
+    /**
+     * @brief Changes the caps and trims the free lists to fit them.
+     *
+     * @throws std::bad_alloc or std::length_error if the free lists cannot
+     *         be reserved for maxBlocksPerClass blocks; the caps are then unchanged.
+     */
+    void setLimits(PoolLimits limits) {
+        reserveBins(limits.maxBlocksPerClass);
+        caps = limits;
+        for (size_t c = 0; c < bins.size(); ++c) {
+            while (bins[c].size() > caps.maxBlocksPerClass) {
+                drop(c);
+            }
+        }
+        trim(caps.maxBytesHeld);
+    }
+
+    /**
+     * @brief Hands free blocks back upstream, largest first, until at most keepBytes are held.
+     *
+     * Must be called on the owning thread.
+     */
+    void trim(size_t keepBytes = 0) {
+        for (size_t c = bins.size(); c-- > 0 && counters.bytesHeld > keepBytes;) {
+            while (!bins[c].empty() && counters.bytesHeld > keepBytes) {
+                drop(c);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the size class a request of bytes is rounded up to.
+     */
+    static size_t classBytes(size_t bytes) noexcept {
+        if (bytes <= size_t(1) << kPoolMinClassShift) {
+            return size_t(1) << kPoolMinClassShift;
+        }
+        const size_t step = classStep(bytes);
+        return (bytes + step - 1) / step * step;
+    }
+
+private:
+    PoolLimits caps;
+    PoolStats counters;
+    std::pmr::memory_resource* upstream;
+    std::vector<std::vector<void*>> bins; ///< Free blocks, one list per size class.
+    const std::thread::id owner = std::this_thread::get_id();
+    /// One reference per outstanding block, plus one for local()'s holder.
+    std::atomic<size_t> refs{1};
+    bool retired = false;
+
+    /// A quarter of the power of two below bytes, so each octave has four classes.
+    static size_t classStep(size_t bytes) noexcept {
+        return size_t(1) << (std::bit_width(bytes - 1) - 3);
+    }
+
+    static size_t classIndex(size_t bytes) noexcept {
+        if (bytes <= size_t(1) << kPoolMinClassShift) {
+            return 0;
+        }
+        const size_t octave = std::bit_width(bytes - 1) - 1;
+        const size_t quarters = classBytes(bytes) / classStep(bytes);
+        return 1 + 4 * (octave - kPoolMinClassShift) + (quarters - 5);
+    }
+
+    static bool pooled(size_t bytes, size_t alignment) noexcept {
+        return bytes <= kPoolMaxBlockBytes && alignment <= kBufferAlignment;
+    }
+
+    bool onOwner() const noexcept {
+        // Other threads never read retired, which only the owner writes.
+        return std::this_thread::get_id() == owner && !retired;
+    }
+
+    /// Free lists never grow past their capacity, so deallocation, reached
+    /// from noexcept buffer destructors, cannot throw.
+    void reserveBins(size_t blocks) {
+        for (auto& bin : bins) {
+            bin.reserve(blocks);
+        }
+    }
+
+    void drop(size_t c) {
+        const size_t size = sizeFor(c);
+        upstream->deallocate(bins[c].back(), size, kBufferAlignment);
+        bins[c].pop_back();
+        counters.bytesHeld -= size;
+        counters.bytesTrimmed += size;
+        --counters.blocksHeld;
+    }
+
+    /// Block size of class c.
+    static size_t sizeFor(size_t c) noexcept {
+        if (c == 0) {
+            return size_t(1) << kPoolMinClassShift;
+        }
+        const size_t octave = (c - 1) / 4 + kPoolMinClassShift;
+        return (size_t(1) << octave) / 4 * ((c - 1) % 4 + 5);
+    }
+
+    void retire() {
+        trim();
+        retired = true;
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        refs.fetch_add(1, std::memory_order_relaxed);
+        if (!pooled(bytes, alignment)) {
+            counters.requests += onOwner();
+            return upstream->allocate(bytes, alignment);
+        }
+        const size_t size = classBytes(bytes);
+        if (!onOwner()) {
+            return upstream->allocate(size, kBufferAlignment);
+        }
+        ++counters.requests;
+        auto& bin = bins[classIndex(bytes)];
+        if (bin.empty()) {
+            return upstream->allocate(size, kBufferAlignment);
+        }
+        void* p = bin.back();
+        bin.pop_back();
+        ++counters.reused;
+        counters.bytesHeld -= size;
+        --counters.blocksHeld;
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        if (!pooled(bytes, alignment)) {
+            upstream->deallocate(p, bytes, alignment);
+        } else {
+            const size_t size = classBytes(bytes);
+            auto& bin = bins[classIndex(bytes)];
+            if (onOwner() && bin.size() < caps.maxBlocksPerClass &&
+                counters.bytesHeld + size <= caps.maxBytesHeld) {
+                bin.push_back(p);
+                counters.bytesHeld += size;
+                ++counters.blocksHeld;
+                counters.peakBytesHeld = std::max(counters.peakBytesHeld, counters.bytesHeld);
+            } else {
+                upstream->deallocate(p, size, kBufferAlignment);
+            }
+        }
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace kernels
+
+#endif // KERNELS_BUFFER_POOL_H
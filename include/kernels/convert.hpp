@@ -0,0 +1,321 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_CONVERT_H
+#define KERNELS_CONVERT_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "simd.hpp"
+#include "../types/half.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Conversion kernels between float and the two-byte storage types Half
+ * and BFloat16.
+ *
+ * Kernels that take Half or BFloat16 operands convert kConvertBlock
+ * elements at a time into a float buffer on the stack, run the float
+ * kernel on it, and narrow the result once, so values are stored in two
+ * bytes but every sum is accumulated in float.
+ */
+namespace kernels {
+
+constexpr size_t kConvertBlock = 512; ///< Elements widened to float per step.
+
+/**
+ * @brief True for the two-byte floating-point storage types.
+ */
+template<typename T>
+constexpr bool kReducedFloat = std::is_same_v<T, Half> || std::is_same_v<T, BFloat16>;
+
+/**
+ * @brief Type that kernels compute and accumulate T in: float for Half and BFloat16, T otherwise.
+ */
+template<typename T>
+using Widened = std::conditional_t<kReducedFloat<T>, float, T>;
+
+namespace detail {
+
+inline bool detectF16c() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("f16c");
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Widens bfloat16 bit patterns with Bytes-wide vectors: a 16-bit shift per lane.
+ *
+ * The lane types are template parameters because GCC rejects
+ * __builtin_convertvector on vectors whose size is the only dependent part.
+ */
+template<size_t Bytes, typename U16 = std::uint16_t, typename U32 = std::uint32_t>
+[[gnu::always_inline]] inline void widenBf16Loop(size_t n, const BFloat16* x, float* out) {
+    typedef U16 Narrow __attribute__((vector_size(Bytes / 2)));
+    typedef U32 Wide __attribute__((vector_size(Bytes)));
+    constexpr size_t lanes = Bytes / sizeof(float);
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        Narrow h;
+        std::memcpy(&h, x + i, Bytes / 2);
+        const Wide w = __builtin_convertvector(h, Wide) << 16;
+        std::memcpy(out + i, &w, Bytes);
+    }
+    for (; i < n; ++i) {
+        out[i] = x[i];
+    }
+}
+
+/**
+ * @brief Narrows floats to bfloat16 with Bytes-wide vectors, ties to even, NaN kept quiet.
+ */
+template<size_t Bytes, typename U16 = std::uint16_t, typename U32 = std::uint32_t>
+[[gnu::always_inline]] inline void narrowBf16Loop(size_t n, const float* x, BFloat16* out) {
+    typedef U16 Narrow __attribute__((vector_size(Bytes / 2)));
+    typedef U32 Wide __attribute__((vector_size(Bytes)));
+    constexpr size_t lanes = Bytes / sizeof(float);
+    const size_t full = n - n % lanes;
+    size_t i = 0;
+    for (; i < full; i += lanes) {
+        Wide w;
+        std::memcpy(&w, x + i, Bytes);
+        const Wide rounded = (w + 0x7FFFu + ((w >> 16) & 1u)) >> 16;
+        const Wide quiet = (w >> 16) | 0x40u;
+        const Wide r = (w & 0x7FFFFFFFu) > 0x7F800000u ? quiet : rounded;
+        const Narrow h = __builtin_convertvector(r, Narrow);
+        // BFloat16 is a 16-bit pattern; copying through bytes keeps -Wclass-memaccess quiet.
+        std::memcpy(reinterpret_cast<unsigned char*>(out + i), &h, Bytes / 2);
+    }
+    for (; i < n; ++i) {
+        out[i] = x[i];
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2"))) inline void widenBf16Sse2(size_t n, const BFloat16* x, float* out) {
+    widenBf16Loop<16>(n, x, out);
+}
+
+__attribute__((target("avx2"))) inline void widenBf16Avx2(size_t n, const BFloat16* x, float* out) {
+    widenBf16Loop<32>(n, x, out);
+}
+
+__attribute__((target("avx512f"))) inline void widenBf16Avx512(size_t n, const BFloat16* x, float* out) {
+    widenBf16Loop<64>(n, x, out);
+}
+
+__attribute__((target("sse2"))) inline void narrowBf16Sse2(size_t n, const float* x, BFloat16* out) {
+    narrowBf16Loop<16>(n, x, out);
+}
+
+__attribute__((target("avx2"))) inline void narrowBf16Avx2(size_t n, const float* x, BFloat16* out) {
+    narrowBf16Loop<32>(n, x, out);
+}
+
+__attribute__((target("avx512f"))) inline void narrowBf16Avx512(size_t n, const float* x, BFloat16* out) {
+    narrowBf16Loop<64>(n, x, out);
+}
+
+__attribute__((target("avx2,f16c"))) inline void widenHalfF16c(size_t n, const Half* x, float* out) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+    }
+    for (; i < n; ++i) {
+        out[i] = x[i];
+    }
+}
+
+__attribute__((target("avx512f"))) inline void widenHalfAvx512(size_t n, const Half* x, float* out) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+        // The zero-masked forms avoid the undefined source GCC 12 reports as uninitialized.
+        _mm512_storeu_ps(out + i, _mm512_maskz_cvtph_ps(0xFFFF, h));
+    }
+    widenHalfF16c(n - i, x + i, out + i);
+}
+
+__attribute__((target("avx2,f16c"))) inline void narrowHalfF16c(size_t n, const float* x, Half* out) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(x + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+    }
+    for (; i < n; ++i) {
+        out[i] = x[i];
+    }
+}
+
+__attribute__((target("avx512f"))) inline void narrowHalfAvx512(size_t n, const float* x, Half* out) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i h = _mm512_maskz_cvtps_ph(0xFFFF, _mm512_loadu_ps(x + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), h);
+    }
+    narrowHalfF16c(n - i, x + i, out + i);
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Returns true if the CPU has the F16C half-precision conversion instructions.
+ */
+inline bool supportsF16c() {
+    static const bool f16c = detail::detectF16c();
+    return f16c;
+}
+
+/**
+ * @brief out[i] = float(x[i]) for i < n, on the active instruction set.
+ *
+ * Half uses the F16C (AVX2) or AVX-512 conversion instructions, BFloat16
+ * a vector shift; without them both fall back to the exact scalar
+ * conversion.
+ */
+template<typename T>
+    requires kReducedFloat<T>
+void toFloat(size_t n, const T* x, float* out) {
+#if defined(__x86_64__) || defined(__i386__)
+    const Isa isa = activeIsa();
+    if constexpr (std::is_same_v<T, Half>) {
+        if (isa == Isa::AVX512) {
+            return detail::widenHalfAvx512(n, x, out);
+        }
+        if (isa == Isa::AVX2 && supportsF16c()) {
+            return detail::widenHalfF16c(n, x, out);
+        }
+    } else {
+        switch (isa) {
+        case Isa::AVX512:
+            return detail::widenBf16Avx512(n, x, out);
+        case Isa::AVX2:
+            return detail::widenBf16Avx2(n, x, out);
+        case Isa::SSE2:
+            return detail::widenBf16Sse2(n, x, out);
+        case Isa::Scalar:
+            break;
+        }
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = x[i];
+    }
+}
+
+/**
+ * @brief out[i] = T(x[i]) for i < n, rounding to nearest even, on the active instruction set.
+ */
+template<typename T>
+    requires kReducedFloat<T>
+void fromFloat(size_t n, const float* x, T* out) {
+#if defined(__x86_64__) || defined(__i386__)
+    const Isa isa = activeIsa();
+    if constexpr (std::is_same_v<T, Half>) {
+        if (isa == Isa::AVX512) {
+            return detail::narrowHalfAvx512(n, x, out);
+        }
+        if (isa == Isa::AVX2 && supportsF16c()) {
+            return detail::narrowHalfF16c(n, x, out);
+        }
+    } else {
+        switch (isa) {
+        case Isa::AVX512:
+            return detail::narrowBf16Avx512(n, x, out);
+        case Isa::AVX2:
+            return detail::narrowBf16Avx2(n, x, out);
+        case Isa::SSE2:
+            return detail::narrowBf16Sse2(n, x, out);
+        case Isa::Scalar:
+            break;
+        }
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = x[i];
+    }
+}
+
+/**
+ * @brief out[i] = a[i] op b[i] for Half or BFloat16 arrays, computed in float.
+ *
+ * out may be the same array as a or b.
+ */
+template<BinaryOp op, typename T>
+    requires kReducedFloat<T>
+void binary(size_t n, const T* a, const T* b, T* out) {
+    float fa[kConvertBlock];
+    float fb[kConvertBlock];
+    for (size_t lo = 0; lo < n; lo += kConvertBlock) {
+        const size_t count = std::min(kConvertBlock, n - lo);
+        toFloat(count, a + lo, fa);
+        toFloat(count, b + lo, fb);
+        binary<op>(count, fa, fb, fa);
+        fromFloat(count, fa, out + lo);
+    }
+}
+
+/**
+ * @brief Fused operation on Half or BFloat16 arrays, computed in float; see FusedOp.
+ */
+template<FusedOp op, typename T>
+    requires kReducedFloat<T>
+void fused(size_t n, T alpha, T beta, const T* x, const T* y, const T* z, T* out) {
+    constexpr bool readsY = op == FusedOp::Axpy || op == FusedOp::Axpby || op == FusedOp::Fma;
+    float fx[kConvertBlock];
+    float fy[kConvertBlock];
+    float fz[kConvertBlock];
+    for (size_t lo = 0; lo < n; lo += kConvertBlock) {
+        const size_t count = std::min(kConvertBlock, n - lo);
+        toFloat(count, x + lo, fx);
+        if constexpr (readsY) {
+            toFloat(count, y + lo, fy);
+        }
+        if constexpr (op == FusedOp::Fma) {
+            toFloat(count, z + lo, fz);
+        }
+        fused<op, float>(count, alpha, beta, fx, fy, fz, fx);
+        fromFloat(count, fx, out + lo);
+    }
+}
+
+} // namespace kernels
+
+#endif // KERNELS_CONVERT_H
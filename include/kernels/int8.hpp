@@ -0,0 +1,290 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_INT8_H
+#define KERNELS_INT8_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "blas.hpp"
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+/**
+ * Int8 matrix multiply with exact int32 accumulation.
+ *
+ * Both operands are stored so that the shared dimension is contiguous:
+ * C = A * B^T with A m x k and B n x k, row-major. Every element of C is
+ * then a dot product of two contiguous int8 rows, which is what the
+ * multiply-add instructions want. The result is exact as long as
+ * k * 128 * 128 fits in an int32, that is for k below 131072.
+ *
+ * Kernels, picked at run time:
+ *  - AVX-512 VNNI: vpdpbusd multiplies unsigned by signed bytes and adds
+ *    four products straight into int32 lanes. A is biased to unsigned by
+ *    flipping its sign bit and the bias, 128 * sum(B row), is subtracted.
+ *  - AVX2: bytes are sign-extended to int16 and combined with vpmaddwd.
+ *    vpmaddubsw is not used because it saturates pairs of products at
+ *    int16, which is wrong for full-range int8 data.
+ *  - Otherwise, a portable int32 loop.
+ */
+namespace kernels {
+
+constexpr size_t kInt8Cols = 128; ///< Rows of B kept hot in cache while a block of A streams past.
+constexpr size_t kInt8MaxDepth = 131072; ///< First shared dimension whose products can overflow int32.
+
+namespace detail {
+
+inline bool detectVnni() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512vnni") && __builtin_cpu_supports("avx512bw");
+#else
+    return false;
+#endif
+}
+
+inline std::int32_t dotInt8Scalar(size_t k, const std::int8_t* a, const std::int8_t* b) {
+    std::int32_t sum = 0;
+    for (size_t p = 0; p < k; ++p) {
+        sum += static_cast<std::int32_t>(a[p]) * b[p];
+    }
+    return sum;
+}
+
+/**
+ * @brief C[i][j] for rows [lo, hi) of A and rows [jlo, jhi) of B, with the portable loop.
+ */
+inline void gemmInt8Scalar(size_t lo, size_t hi, size_t jlo, size_t jhi, size_t k, const std::int8_t* A, size_t lda,
+                           const std::int8_t* B, size_t ldb, std::int32_t* C, size_t ldc) {
+    for (size_t i = lo; i < hi; ++i) {
+        for (size_t j = jlo; j < jhi; ++j) {
+            C[i * ldc + j] = dotInt8Scalar(k, A + i * lda, B + j * ldb);
+        }
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2"))) inline std::int32_t sumLanes(__m256i v) {
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+}
+
+__attribute__((target("avx2"))) inline __m256i widenInt8(const std::int8_t* p) {
+    return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+/**
+ * @brief AVX2 kernel: one row of A against four rows of B, 16 bytes per step.
+ */
+__attribute__((target("avx2"))) inline void gemmInt8Avx2(size_t lo, size_t hi, size_t jlo, size_t jhi, size_t k,
+                                                          const std::int8_t* A, size_t lda, const std::int8_t* B,
+                                                          size_t ldb, std::int32_t* C, size_t ldc) {
+    for (size_t i = lo; i < hi; ++i) {
+        const std::int8_t* a = A + i * lda;
+        std::int32_t* c = C + i * ldc;
+        size_t j = jlo;
+        for (; j + 4 <= jhi; j += 4) {
+            const std::int8_t* b = B + j * ldb;
+            __m256i acc0 = _mm256_setzero_si256(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+            size_t p = 0;
+            for (; p + 16 <= k; p += 16) {
+                const __m256i va = widenInt8(a + p);
+                acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(va, widenInt8(b + p)));
+                acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(va, widenInt8(b + ldb + p)));
+                acc2 = _mm256_add_epi32(acc2, _mm256_madd_epi16(va, widenInt8(b + 2 * ldb + p)));
+                acc3 = _mm256_add_epi32(acc3, _mm256_madd_epi16(va, widenInt8(b + 3 * ldb + p)));
+            }
+            c[j] = sumLanes(acc0) + dotInt8Scalar(k - p, a + p, b + p);
+            c[j + 1] = sumLanes(acc1) + dotInt8Scalar(k - p, a + p, b + ldb + p);
+            c[j + 2] = sumLanes(acc2) + dotInt8Scalar(k - p, a + p, b + 2 * ldb + p);
+            c[j + 3] = sumLanes(acc3) + dotInt8Scalar(k - p, a + p, b + 3 * ldb + p);
+        }
+        for (; j < jhi; ++j) {
+            const std::int8_t* b = B + j * ldb;
+            __m256i acc = _mm256_setzero_si256();
+            size_t p = 0;
+            for (; p + 16 <= k; p += 16) {
+                acc = _mm256_add_epi32(acc, _mm256_madd_epi16(widenInt8(a + p), widenInt8(b + p)));
+            }
+            c[j] = sumLanes(acc) + dotInt8Scalar(k - p, a + p, b + p);
+        }
+    }
+}
+
+/**
+ * @brief Removes the bias in wrapping arithmetic: the biased sum may leave the
+ *        int32 range even when the true one does not.
+ */
+inline std::int32_t unbias(std::int32_t sum, std::int32_t bias) {
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(sum) - static_cast<std::uint32_t>(bias));
+}
+
+/**
+ * @brief Horizontal sum of 16 int32 lanes.
+ *
+ * Used instead of _mm512_reduce_add_epi32: in GCC 12 it and the 512-to-256
+ * cast go through extracts with an undefined source vector, which
+ * -Wmaybe-uninitialized reports. The zero-masked extracts take a zero one.
+ */
+__attribute__((target("avx512f"))) inline std::int32_t sumLanes(__m512i v) {
+    return sumLanes(_mm256_add_epi32(_mm512_maskz_extracti64x4_epi64(0xF, v, 0),
+                                     _mm512_maskz_extracti64x4_epi64(0xF, v, 1)));
+}
+
+/**
+ * @brief AVX-512 VNNI kernel: one row of A against four rows of B, 64 bytes per step.
+ *
+ * @param bias 128 * sum of each row of B, indexed by j.
+ */
+__attribute__((target("avx512f,avx512bw,avx512vnni"))) inline void gemmInt8Vnni(
+        size_t lo, size_t hi, size_t jlo, size_t jhi, size_t k, const std::int8_t* A, size_t lda,
+        const std::int8_t* B, size_t ldb, std::int32_t* C, size_t ldc, const std::int32_t* bias) {
+    const __m512i flip = _mm512_set1_epi8(static_cast<char>(0x80));
+    const size_t body = k / 64 * 64;
+    const __mmask64 tail = k == body ? 0 : ~0ULL >> (64 - (k - body));
+    for (size_t i = lo; i < hi; ++i) {
+        const std::int8_t* a = A + i * lda;
+        std::int32_t* c = C + i * ldc;
+        size_t j = jlo;
+        for (; j + 4 <= jhi; j += 4) {
+            const std::int8_t* b = B + j * ldb;
+            __m512i acc0 = _mm512_setzero_si512(), acc1 = acc0, acc2 = acc0, acc3 = acc0;
+            for (size_t p = 0; p < body; p += 64) {
+                const __m512i va = _mm512_xor_si512(_mm512_loadu_si512(a + p), flip);
+                acc0 = _mm512_dpbusd_epi32(acc0, va, _mm512_loadu_si512(b + p));
+                acc1 = _mm512_dpbusd_epi32(acc1, va, _mm512_loadu_si512(b + ldb + p));
+                acc2 = _mm512_dpbusd_epi32(acc2, va, _mm512_loadu_si512(b + 2 * ldb + p));
+                acc3 = _mm512_dpbusd_epi32(acc3, va, _mm512_loadu_si512(b + 3 * ldb + p));
+            }
+            if (tail) {
+                // Masked-off bytes of B are zero, so the biased A bytes there add nothing.
+                const __m512i va = _mm512_xor_si512(_mm512_maskz_loadu_epi8(tail, a + body), flip);
+                acc0 = _mm512_dpbusd_epi32(acc0, va, _mm512_maskz_loadu_epi8(tail, b + body));
+                acc1 = _mm512_dpbusd_epi32(acc1, va, _mm512_maskz_loadu_epi8(tail, b + ldb + body));
+                acc2 = _mm512_dpbusd_epi32(acc2, va, _mm512_maskz_loadu_epi8(tail, b + 2 * ldb + body));
+                acc3 = _mm512_dpbusd_epi32(acc3, va, _mm512_maskz_loadu_epi8(tail, b + 3 * ldb + body));
+            }
+            c[j] = unbias(sumLanes(acc0), bias[j]);
+            c[j + 1] = unbias(sumLanes(acc1), bias[j + 1]);
+            c[j + 2] = unbias(sumLanes(acc2), bias[j + 2]);
+            c[j + 3] = unbias(sumLanes(acc3), bias[j + 3]);
+        }
+        for (; j < jhi; ++j) {
+            const std::int8_t* b = B + j * ldb;
+            __m512i acc = _mm512_setzero_si512();
+            for (size_t p = 0; p < body; p += 64) {
+                const __m512i va = _mm512_xor_si512(_mm512_loadu_si512(a + p), flip);
+                acc = _mm512_dpbusd_epi32(acc, va, _mm512_loadu_si512(b + p));
+            }
+            if (tail) {
+                const __m512i va = _mm512_xor_si512(_mm512_maskz_loadu_epi8(tail, a + body), flip);
+                acc = _mm512_dpbusd_epi32(acc, va, _mm512_maskz_loadu_epi8(tail, b + body));
+            }
+            c[j] = unbias(sumLanes(acc), bias[j]);
+        }
+    }
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Returns true if the CPU has the AVX-512 VNNI byte dot-product instructions.
+ */
+inline bool supportsVnni() {
+    static const bool vnni = detail::detectVnni();
+    return vnni;
+}
+
+/**
+ * @brief Int8 matrix multiply: C = A * B^T with int32 accumulation.
+ *
+ * @param m Rows of A and C.
+ * @param n Rows of B and columns of C.
+ * @param k Length of the rows of A and B.
+ * @param A m x k int8 matrix, row-major with leading dimension lda.
+ * @param B n x k int8 matrix, row-major with leading dimension ldb.
+ * @param C m x n int32 result, overwritten.
+ */
+inline void gemmInt8(size_t m, size_t n, size_t k, const std::int8_t* A, size_t lda, const std::int8_t* B, size_t ldb,
+                     std::int32_t* C, size_t ldc) {
+    if (m == 0 || n == 0) {
+        return;
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    const Isa isa = activeIsa();
+    const bool vnni = isa == Isa::AVX512 && supportsVnni();
+    std::vector<std::int32_t> bias;
+    if (vnni) {
+        bias.resize(n);
+        for (size_t j = 0; j < n; ++j) {
+            std::int32_t sum = 0;
+            for (size_t p = 0; p < k; ++p) {
+                sum += B[j * ldb + p];
+            }
+            bias[j] = 128 * sum;
+        }
+    }
+#endif
+    // Column blocks of kInt8Cols rows of B stay in cache while the rows of A stream past.
+    auto rows = [&](size_t lo, size_t hi) {
+        for (size_t jlo = 0; jlo < n; jlo += kInt8Cols) {
+            const size_t jhi = std::min(n, jlo + kInt8Cols);
+#if defined(__x86_64__) || defined(__i386__)
+            if (vnni) {
+                detail::gemmInt8Vnni(lo, hi, jlo, jhi, k, A, lda, B, ldb, C, ldc, bias.data());
+                continue;
+            }
+            if (isa >= Isa::AVX2) {
+                detail::gemmInt8Avx2(lo, hi, jlo, jhi, k, A, lda, B, ldb, C, ldc);
+                continue;
+            }
+#endif
+            detail::gemmInt8Scalar(lo, hi, jlo, jhi, k, A, lda, B, ldb, C, ldc);
+        }
+    };
+    if (m * n * k < kParallelFlops) {
+        rows(0, m);
+    } else {
+        parallel_for(0, m, std::max<size_t>(1, kParallelFlops / (n * k + 1)), rows);
+    }
+}
+
+} // namespace kernels
+
+#endif // KERNELS_INT8_H
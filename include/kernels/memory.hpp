@@ -0,0 +1,191 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_MEMORY_H
+#define KERNELS_MEMORY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+/**
+ * Where Vector and Matrix elements are allocated.
+ *
+ * Every buffer comes from a std::pmr::memory_resource. The default one
+ * aligns blocks to a cache line, so no SIMD load of an aligned index
+ * splits a line, and advises very large blocks onto transparent huge
+ * pages. Arenas plug in as any other resource, process-wide through
+ * setDefaultResource() or for one thread and scope through ScopedResource.
+ */
+namespace kernels {
+
+constexpr size_t kBufferAlignment = 64;                   ///< One cache line, the widest SIMD register.
+constexpr size_t kHugePageBytes = size_t(2) << 20;        ///< Transparent huge page size on x86-64.
+constexpr size_t kHugePageThreshold = 4 * kHugePageBytes; ///< Smallest block advised onto huge pages.
+
+/**
+ * @class AlignedResource
+ * @brief Memory resource handing out cache-line aligned blocks.
+ *
+ * Blocks of at least hugePageThreshold() bytes are aligned and padded to
+ * whole huge pages and, on Linux, advised with MADV_HUGEPAGE, so a long
+ * streaming kernel needs one TLB entry per 2 MiB instead of 512. The
+ * advice is given before the first write, so the pages are placed by the
+ * kernel that fills them.
+ */
+class AlignedResource final : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param hugePageThreshold Smallest block backed by huge pages; SIZE_MAX disables them.
+     */
+    explicit AlignedResource(size_t hugePageThreshold = kHugePageThreshold) noexcept
+        : threshold(hugePageThreshold) {}
+
+    /**
+     * @brief Returns the smallest block size backed by huge pages.
+     */
+    size_t hugePageThreshold() const noexcept {
+        return threshold;
+    }
+
+private:
+    size_t threshold;
+
+    bool huge(size_t bytes) const noexcept {
+        return bytes >= threshold;
+    }
+
+    static size_t hugeBytes(size_t bytes) noexcept {
+        return (bytes + kHugePageBytes - 1) / kHugePageBytes * kHugePageBytes;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (huge(bytes)) {
+            void* p = ::operator new(hugeBytes(bytes), std::align_val_t(kHugePageBytes));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+            // Only advice: without THP support the block is simply backed by small pages.
+            (void)::madvise(p, hugeBytes(bytes), MADV_HUGEPAGE);
+#endif
+            return p;
+        }
+        return ::operator new(bytes, std::align_val_t(std::max(alignment, kBufferAlignment)));
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        if (huge(bytes)) {
+            ::operator delete(p, hugeBytes(bytes), std::align_val_t(kHugePageBytes));
+        } else {
+            ::operator delete(p, bytes, std::align_val_t(std::max(alignment, kBufferAlignment)));
+        }
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+namespace detail {
+
+/// Never destroyed: buffers in static objects may be released after main returns.
+inline AlignedResource& defaultAlignedResource() {
+    static AlignedResource* resource = new AlignedResource();
+    return *resource;
+}
+
+inline std::atomic<std::pmr::memory_resource*>& selectedResource() {
+    static std::atomic<std::pmr::memory_resource*> resource{&defaultAlignedResource()};
+    return resource;
+}
+
+inline std::pmr::memory_resource*& scopedResource() {
+    static thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns the process-wide aligned resource used unless another one is set.
+ */
+inline std::pmr::memory_resource* alignedResource() {
+    return &detail::defaultAlignedResource();
+}
+
+/**
+ * @brief Returns the resource new buffers are allocated from on this thread.
+ */
+inline std::pmr::memory_resource* defaultResource() {
+    std::pmr::memory_resource* scoped = detail::scopedResource();
+    return scoped ? scoped : detail::selectedResource().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the process-wide resource for new buffers; nullptr restores alignedResource().
+ *
+ * The resource must outlive every buffer allocated from it.
+ */
+inline void setDefaultResource(std::pmr::memory_resource* resource) {
+    detail::selectedResource().store(resource ? resource : alignedResource(), std::memory_order_relaxed);
+}
+
+/**
+ * @class ScopedResource
+ * @brief Routes the calling thread's new buffers to a resource, such as an arena, for one scope.
+ *
+ * Buffers keep the resource they were allocated from, so copies detached
+ * later still go to the arena; the arena must outlive them.
+ */
+class ScopedResource final {
+public:
+    explicit ScopedResource(std::pmr::memory_resource* resource) noexcept
+        : previous(std::exchange(detail::scopedResource(), resource)) {}
+
+    ScopedResource(const ScopedResource&) = delete;
+    ScopedResource& operator=(const ScopedResource&) = delete;
+
+    ~ScopedResource() {
+        detail::scopedResource() = previous;
+    }
+
+private:
+    std::pmr::memory_resource* previous;
+};
+
+} // namespace kernels
+
+#endif // KERNELS_MEMORY_H
@@ -0,0 +1,166 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_PARALLEL_H
+#define KERNELS_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "thread_pool.hpp"
+
+/**
+ * Execution policy for elementwise kernels and reductions on long arrays.
+ *
+ * Work is cut into chunks whose boundaries depend only on the array (its
+ * length and, for outputs, its address), never on the number of threads,
+ * so every run does the same arithmetic in the same order. Output chunks
+ * start on page boundaries: a freshly allocated result is first written
+ * by the thread that computes it, and with a first-touch NUMA policy each
+ * page lands on that thread's node. Arrays below kParallelBytes never
+ * touch the pool.
+ */
+namespace kernels {
+
+/**
+ * @brief How elementwise kernels and reductions use the thread pool.
+ */
+enum class Execution {
+    Serial,   ///< Always run on the calling thread.
+    Parallel, ///< Split every array with more than one chunk across the pool.
+    Auto      ///< Split arrays of at least kParallelBytes; the default.
+};
+
+constexpr size_t kPageBytes = 4096;           ///< Granularity of first-touch placement.
+constexpr size_t kChunkBytes = 64 * kPageBytes; ///< Bytes of output per elementwise task.
+constexpr size_t kParallelBytes = 1 << 20;    ///< Smallest array split under Execution::Auto.
+
+namespace detail {
+
+inline std::atomic<Execution>& selectedExecution() {
+    static std::atomic<Execution> execution{Execution::Auto};
+    return execution;
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns the current execution policy.
+ */
+inline Execution activeExecution() {
+    return detail::selectedExecution().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sets the execution policy for all subsequent kernels.
+ */
+inline void setExecution(Execution execution) {
+    detail::selectedExecution().store(execution, std::memory_order_relaxed);
+}
+
+/**
+ * @brief True if an array of the given size should be split across the pool.
+ */
+inline bool runsInParallel(size_t bytes) {
+    switch (activeExecution()) {
+    case Execution::Serial:
+        return false;
+    case Execution::Parallel:
+        return true;
+    case Execution::Auto:
+        break;
+    }
+    return bytes >= kParallelBytes;
+}
+
+/**
+ * @brief Like parallel_for over [0, n), but serial when the policy says so.
+ *
+ * Chunks and their order are the same either way, so reductions that
+ * combine per-chunk results give identical answers under every policy.
+ *
+ * @param n Number of indices.
+ * @param grain Number of indices per chunk.
+ * @param bytes Size of the data the loop streams, for Execution::Auto.
+ * @param fn Callable taking a half-open sub-range (lo, hi).
+ */
+template<typename F>
+void chunked_for(size_t n, size_t grain, size_t bytes, F&& fn) {
+    if (runsInParallel(bytes)) {
+        parallel_for(0, n, grain, fn);
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    for (size_t lo = 0; lo < n; lo += grain) {
+        fn(lo, std::min(n, lo + grain));
+    }
+}
+
+/**
+ * @brief Runs fn(lo, hi) over the elements of out[0..n), in page-aligned chunks.
+ *
+ * Small arrays take a single direct call. Otherwise the first chunk ends
+ * on the first page boundary past kChunkBytes, and every later chunk
+ * covers exactly kChunkBytes, so no page is written by two tasks.
+ *
+ * @param n Number of elements.
+ * @param out Output array, used for alignment and the size heuristic.
+ * @param fn Callable taking a half-open element range (lo, hi).
+ */
+template<typename T, typename F>
+void forEachChunk(size_t n, const T* out, F&& fn) {
+    constexpr size_t grain = std::max<size_t>(1, kChunkBytes / sizeof(T));
+    if (n <= grain || !runsInParallel(n * sizeof(T))) {
+        fn(size_t(0), n);
+        return;
+    }
+    const size_t skew = reinterpret_cast<std::uintptr_t>(out) % kPageBytes / sizeof(T);
+    const size_t first = std::min(n, grain - skew);
+    const size_t chunks = 1 + (n - first + grain - 1) / grain;
+    ThreadPool::instance().run(chunks, [&](size_t c) {
+        const size_t lo = c == 0 ? 0 : first + (c - 1) * grain;
+        const size_t hi = c == 0 ? first : std::min(n, lo + grain);
+        fn(lo, hi);
+    });
+}
+
+/**
+ * @brief out[0..n) = value, split like the elementwise kernels.
+ */
+template<typename T>
+void fill(size_t n, T* out, const T& value) {
+    forEachChunk(n, out, [&](size_t lo, size_t hi) {
+        std::fill(out + lo, out + hi, value);
+    });
+}
+
+} // namespace kernels
+
+#endif // KERNELS_PARALLEL_H
@@ -0,0 +1,575 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_REDUCE_H
+#define KERNELS_REDUCE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "convert.hpp"
+#include "parallel.hpp"
+#include "simd.hpp"
+
+/**
+ * Vectorized reductions on contiguous arrays: sums, dot products, norms
+ * and extrema.
+ *
+ * Every reduction splits its input into fixed chunks of kReduceChunk
+ * elements. Each chunk is reduced with several SIMD accumulators on the
+ * active instruction set, chunks run on the thread pool when the
+ * execution policy allows it, and the per-chunk results are combined in
+ * chunk order. The result therefore depends only on the data, never on
+ * the number of threads or the policy. Half and BFloat16 inputs are
+ * widened block by block and summed in float, and sums are returned as
+ * Widened<T>.
+ */
+namespace kernels {
+
+constexpr size_t kReduceChunk = 1 << 15; ///< Elements reduced by one task.
+
+/**
+ * @brief How sums are accumulated.
+ */
+enum class Summation {
+    Plain,      ///< Independent SIMD partial sums; fastest.
+    Compensated ///< Kahan summation in every lane and across chunks; error independent of length.
+};
+
+namespace detail {
+
+enum class Term { Value, Abs, Square, Product };
+
+/**
+ * @brief A running sum and the low-order part it has lost so far.
+ */
+template<typename T>
+struct Partial {
+    T sum{};
+    T carry{};
+};
+
+/**
+ * @brief One Kahan step, for scalars and SIMD vectors alike.
+ */
+template<typename V>
+[[gnu::always_inline]] inline void kahan(V& sum, V& carry, const V& term) {
+    const V y = term - carry;
+    const V t = sum + y;
+    carry = (t - sum) - y;
+    sum = t;
+}
+
+template<Term term, typename T>
+[[gnu::always_inline]] inline Widened<T> scalarTerm(const T* x, const T* y, size_t i) {
+    using A = Widened<T>;
+    const A a = x[i];
+    if constexpr (term == Term::Value) {
+        return a;
+    } else if constexpr (term == Term::Abs) {
+        return a < A(0) ? -a : a;
+    } else if constexpr (term == Term::Square) {
+        return a * a;
+    } else {
+        return a * A(y[i]);
+    }
+}
+
+template<Term term, size_t Bytes, typename T, typename V>
+[[gnu::always_inline]] inline void vectorTerm(const T* x, const T* y, size_t i, V& v) {
+    std::memcpy(&v, x + i, Bytes);
+    if constexpr (term == Term::Abs) {
+        v = v < V{} ? -v : v;
+    } else if constexpr (term == Term::Square) {
+        v = v * v;
+    } else if constexpr (term == Term::Product) {
+        V w;
+        std::memcpy(&w, y + i, Bytes);
+        v = v * w;
+    }
+}
+
+template<Summation mode, typename T>
+[[gnu::always_inline]] inline void add(Partial<T>& p, const T& value) {
+    if constexpr (mode == Summation::Plain) {
+        p.sum += value;
+    } else {
+        kahan(p.sum, p.carry, value);
+    }
+}
+
+/**
+ * @brief Sums term(i) over [0, n) with four Bytes-wide accumulators.
+ */
+template<size_t Bytes, Term term, Summation mode, typename T>
+[[gnu::always_inline]] inline Partial<T> sumLoop(size_t n, const T* x, const T* y) {
+    typedef T V __attribute__((vector_size(Bytes)));
+    constexpr size_t lanes = Bytes / sizeof(T);
+    constexpr size_t ways = 4;
+    V s[ways] = {};
+    V c[ways] = {};
+    size_t i = 0;
+    for (; i + ways * lanes <= n; i += ways * lanes) {
+        for (size_t w = 0; w < ways; ++w) {
+            V v;
+            vectorTerm<term, Bytes>(x, y, i + w * lanes, v);
+            if constexpr (mode == Summation::Plain) {
+                s[w] += v;
+            } else {
+                kahan(s[w], c[w], v);
+            }
+        }
+    }
+    Partial<T> p;
+    for (size_t w = 0; w < ways; ++w) {
+        for (size_t l = 0; l < lanes; ++l) {
+            add<mode>(p, T(s[w][l]));
+            add<mode>(p, T(-c[w][l]));
+        }
+    }
+    for (; i < n; ++i) {
+        add<mode>(p, scalarTerm<term>(x, y, i));
+    }
+    return p;
+}
+
+template<Term term, Summation mode, typename T>
+Partial<Widened<T>> sumScalar(size_t n, const T* x, const T* y) {
+    Partial<Widened<T>> p;
+    for (size_t i = 0; i < n; ++i) {
+        add<mode>(p, scalarTerm<term>(x, y, i));
+    }
+    return p;
+}
+
+template<Term term, Summation mode, typename T>
+Widened<T> sumStrided(size_t n, const T* x, size_t incx, const T* y, size_t incy) {
+    Partial<Widened<T>> p;
+    for (size_t i = 0; i < n; ++i) {
+        add<mode>(p, scalarTerm<term>(x + i * incx, y + i * incy, 0));
+    }
+    return p.sum - p.carry;
+}
+
+/**
+ * @brief Smallest and largest element of a chunk.
+ */
+template<typename T>
+struct Extrema {
+    T min;
+    T max;
+};
+
+template<size_t Bytes, bool absolute, typename T>
+[[gnu::always_inline]] inline Extrema<T> extremaLoop(size_t n, const T* x) {
+    typedef T V __attribute__((vector_size(Bytes)));
+    constexpr size_t lanes = Bytes / sizeof(T);
+    const T first = scalarTerm<absolute ? Term::Abs : Term::Value>(x, x, 0);
+    V lo = V{} + first;
+    V hi = lo;
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        V v;
+        vectorTerm<absolute ? Term::Abs : Term::Value, Bytes>(x, x, i, v);
+        lo = v < lo ? v : lo;
+        hi = v > hi ? v : hi;
+    }
+    Extrema<T> e{first, first};
+    for (size_t l = 0; l < lanes; ++l) {
+        e.min = lo[l] < e.min ? T(lo[l]) : e.min;
+        e.max = hi[l] > e.max ? T(hi[l]) : e.max;
+    }
+    for (; i < n; ++i) {
+        const T v = scalarTerm<absolute ? Term::Abs : Term::Value>(x, x, i);
+        e.min = v < e.min ? v : e.min;
+        e.max = v > e.max ? v : e.max;
+    }
+    return e;
+}
+
+template<bool absolute, typename T>
+Extrema<T> extremaScalar(size_t n, const T* x) {
+    const T first = scalarTerm<absolute ? Term::Abs : Term::Value>(x, x, 0);
+    Extrema<T> e{first, first};
+    for (size_t i = 1; i < n; ++i) {
+        const T v = scalarTerm<absolute ? Term::Abs : Term::Value>(x, x, i);
+        e.min = v < e.min ? v : e.min;
+        e.max = v > e.max ? v : e.max;
+    }
+    return e;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template<Term term, Summation mode, typename T>
+__attribute__((target("sse2"))) Partial<T> sumSse2(size_t n, const T* x, const T* y) {
+    return sumLoop<16, term, mode>(n, x, y);
+}
+
+template<Term term, Summation mode, typename T>
+__attribute__((target("avx2"))) Partial<T> sumAvx2(size_t n, const T* x, const T* y) {
+    return sumLoop<32, term, mode>(n, x, y);
+}
+
+template<Term term, Summation mode, typename T>
+__attribute__((target("avx512f"))) Partial<T> sumAvx512(size_t n, const T* x, const T* y) {
+    return sumLoop<64, term, mode>(n, x, y);
+}
+
+template<bool absolute, typename T>
+__attribute__((target("sse2"))) Extrema<T> extremaSse2(size_t n, const T* x) {
+    return extremaLoop<16, absolute>(n, x);
+}
+
+template<bool absolute, typename T>
+__attribute__((target("avx2"))) Extrema<T> extremaAvx2(size_t n, const T* x) {
+    return extremaLoop<32, absolute>(n, x);
+}
+
+template<bool absolute, typename T>
+__attribute__((target("avx512f"))) Extrema<T> extremaAvx512(size_t n, const T* x) {
+    return extremaLoop<64, absolute>(n, x);
+}
+#endif
+
+template<Term term, Summation mode, typename T>
+Partial<Widened<T>> sumChunk(size_t n, const T* x, const T* y);
+
+/**
+ * @brief Reduces a Half or BFloat16 chunk by widening kConvertBlock elements at a time.
+ */
+template<Term term, Summation mode, typename T>
+Partial<float> sumWidened(size_t n, const T* x, const T* y) {
+    float bx[kConvertBlock];
+    float by[kConvertBlock];
+    const bool twoInputs = term == Term::Product && y != x;
+    Partial<float> total;
+    for (size_t lo = 0; lo < n; lo += kConvertBlock) {
+        const size_t count = std::min(kConvertBlock, n - lo);
+        toFloat(count, x + lo, bx);
+        if (twoInputs) {
+            toFloat(count, y + lo, by);
+        }
+        const Partial<float> p = sumChunk<term, mode>(count, bx, twoInputs ? by : bx);
+        add<mode>(total, p.sum);
+        add<mode>(total, -p.carry);
+    }
+    return total;
+}
+
+template<bool absolute, typename T>
+Extrema<T> extremaChunk(size_t n, const T* x);
+
+/**
+ * @brief Extrema of a Half or BFloat16 chunk, found in float; narrowing them back is exact.
+ */
+template<bool absolute, typename T>
+Extrema<T> extremaWidened(size_t n, const T* x) {
+    float bx[kConvertBlock];
+    Extrema<float> e{};
+    for (size_t lo = 0; lo < n; lo += kConvertBlock) {
+        const size_t count = std::min(kConvertBlock, n - lo);
+        toFloat(count, x + lo, bx);
+        const Extrema<float> p = extremaChunk<absolute>(count, bx);
+        e.min = lo == 0 || p.min < e.min ? p.min : e.min;
+        e.max = lo == 0 || p.max > e.max ? p.max : e.max;
+    }
+    return {T(e.min), T(e.max)};
+}
+
+/**
+ * @brief Reduces one chunk on the active instruction set.
+ */
+template<Term term, Summation mode, typename T>
+Partial<Widened<T>> sumChunk(size_t n, const T* x, const T* y) {
+    if constexpr (kReducedFloat<T>) {
+        return sumWidened<term, mode>(n, x, y);
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    if constexpr (kSimdElement<T>) {
+        switch (activeIsa()) {
+        case Isa::AVX512:
+            return sumAvx512<term, mode>(n, x, y);
+        case Isa::AVX2:
+            return sumAvx2<term, mode>(n, x, y);
+        case Isa::SSE2:
+            return sumSse2<term, mode>(n, x, y);
+        case Isa::Scalar:
+            break;
+        }
+    }
+#endif
+    return sumScalar<term, mode>(n, x, y);
+}
+
+template<bool absolute, typename T>
+Extrema<T> extremaChunk(size_t n, const T* x) {
+    if constexpr (kReducedFloat<T>) {
+        return extremaWidened<absolute>(n, x);
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    if constexpr (kSimdElement<T>) {
+        switch (activeIsa()) {
+        case Isa::AVX512:
+            return extremaAvx512<absolute>(n, x);
+        case Isa::AVX2:
+            return extremaAvx2<absolute>(n, x);
+        case Isa::SSE2:
+            return extremaSse2<absolute>(n, x);
+        case Isa::Scalar:
+            break;
+        }
+    }
+#endif
+    return extremaScalar<absolute>(n, x);
+}
+
+/**
+ * @brief Sums term(i) over [0, n) chunk by chunk, in parallel for long inputs.
+ */
+template<Term term, Summation mode, typename T>
+Widened<T> reduceSum(size_t n, const T* x, const T* y) {
+    using A = Widened<T>;
+    if (n <= kReduceChunk) {
+        const Partial<A> p = sumChunk<term, mode>(n, x, y);
+        return p.sum - p.carry;
+    }
+    std::vector<A> partial((n + kReduceChunk - 1) / kReduceChunk);
+    chunked_for(n, kReduceChunk, n * sizeof(T) * (y && y != x ? 2 : 1), [&](size_t lo, size_t hi) {
+        const Partial<A> p = sumChunk<term, mode>(hi - lo, x + lo, y ? y + lo : nullptr);
+        partial[lo / kReduceChunk] = p.sum - p.carry;
+    });
+    Partial<A> total;
+    for (const A& value : partial) {
+        add<mode>(total, value);
+    }
+    return total.sum - total.carry;
+}
+
+/**
+ * @brief Extrema of x[0..n), or of |x|, chunk by chunk; n must be positive.
+ */
+template<bool absolute, typename T>
+Extrema<T> reduceExtrema(size_t n, const T* x) {
+    if (n <= kReduceChunk) {
+        return extremaChunk<absolute>(n, x);
+    }
+    std::vector<Extrema<T>> partial((n + kReduceChunk - 1) / kReduceChunk);
+    chunked_for(n, kReduceChunk, n * sizeof(T), [&](size_t lo, size_t hi) {
+        partial[lo / kReduceChunk] = extremaChunk<absolute>(hi - lo, x + lo);
+    });
+    Extrema<T> e = partial[0];
+    for (const Extrema<T>& p : partial) {
+        e.min = p.min < e.min ? p.min : e.min;
+        e.max = p.max > e.max ? p.max : e.max;
+    }
+    return e;
+}
+
+} // namespace detail
+
+/**
+ * @brief Sum of x[0..n).
+ */
+template<typename T>
+Widened<T> sum(size_t n, const T* x, Summation mode = Summation::Plain) {
+    return mode == Summation::Plain ? detail::reduceSum<detail::Term::Value, Summation::Plain>(n, x, x)
+                                    : detail::reduceSum<detail::Term::Value, Summation::Compensated>(n, x, x);
+}
+
+/**
+ * @brief Dot product of x[0..n) and y[0..n), split across the pool for long inputs.
+ *
+ * dot(n, x, y) without a mode is the serial building block used inside
+ * the level-2 and level-3 kernels.
+ */
+template<typename T>
+Widened<T> dot(size_t n, const T* x, const T* y, Summation mode) {
+    return mode == Summation::Plain ? detail::reduceSum<detail::Term::Product, Summation::Plain>(n, x, y)
+                                    : detail::reduceSum<detail::Term::Product, Summation::Compensated>(n, x, y);
+}
+
+/**
+ * @brief Sum of absolute values, the L1 norm.
+ */
+template<typename T>
+Widened<T> asum(size_t n, const T* x, Summation mode = Summation::Plain) {
+    return mode == Summation::Plain ? detail::reduceSum<detail::Term::Abs, Summation::Plain>(n, x, x)
+                                    : detail::reduceSum<detail::Term::Abs, Summation::Compensated>(n, x, x);
+}
+
+/**
+ * @brief Euclidean (L2) norm.
+ */
+template<typename T>
+    requires std::is_floating_point_v<Widened<T>>
+Widened<T> nrm2(size_t n, const T* x, Summation mode = Summation::Plain) {
+    const Widened<T> squares = mode == Summation::Plain
+        ? detail::reduceSum<detail::Term::Square, Summation::Plain>(n, x, x)
+        : detail::reduceSum<detail::Term::Square, Summation::Compensated>(n, x, x);
+    return std::sqrt(squares);
+}
+
+/**
+ * @brief Largest absolute value, the L-infinity norm; zero for an empty array.
+ */
+template<typename T>
+T amax(size_t n, const T* x) {
+    return n == 0 ? T(0) : detail::reduceExtrema<true>(n, x).max;
+}
+
+/**
+ * @brief Smallest and largest element with the index of their first occurrence.
+ */
+template<typename T>
+struct MinMax {
+    T min;
+    T max;
+    size_t argmin;
+    size_t argmax;
+};
+
+/**
+ * @brief Returns the extrema of x[0..n) and where they first occur; n must be positive.
+ *
+ * The values come from the SIMD pass; the indices from a scan that stops
+ * at the first match. Results with NaN elements are unspecified.
+ */
+template<typename T>
+MinMax<T> minmax(size_t n, const T* x) {
+    const detail::Extrema<T> e = detail::reduceExtrema<false>(n, x);
+    MinMax<T> result{e.min, e.max, n, n};
+    for (size_t i = 0; i < n && (result.argmin == n || result.argmax == n); ++i) {
+        if (result.argmin == n && x[i] == e.min) {
+            result.argmin = i;
+        }
+        if (result.argmax == n && x[i] == e.max) {
+            result.argmax = i;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Sum of x[0], x[incx], ..., x[(n - 1) * incx].
+ *
+ * The strided overloads take BLAS-style increments so that matrix columns
+ * and diagonals can be reduced in place; with unit increments they are
+ * the contiguous kernels above, otherwise a serial loop.
+ */
+template<typename T>
+Widened<T> sum(size_t n, const T* x, size_t incx, Summation mode) {
+    if (incx == 1) {
+        return sum(n, x, mode);
+    }
+    return mode == Summation::Plain ? detail::sumStrided<detail::Term::Value, Summation::Plain>(n, x, incx, x, incx)
+                                    : detail::sumStrided<detail::Term::Value, Summation::Compensated>(n, x, incx, x, incx);
+}
+
+/**
+ * @brief Strided dot product.
+ */
+template<typename T>
+Widened<T> dot(size_t n, const T* x, size_t incx, const T* y, size_t incy, Summation mode) {
+    if (incx == 1 && incy == 1) {
+        return dot(n, x, y, mode);
+    }
+    return mode == Summation::Plain ? detail::sumStrided<detail::Term::Product, Summation::Plain>(n, x, incx, y, incy)
+                                    : detail::sumStrided<detail::Term::Product, Summation::Compensated>(n, x, incx, y, incy);
+}
+
+/**
+ * @brief Strided sum of absolute values.
+ */
+template<typename T>
+Widened<T> asum(size_t n, const T* x, size_t incx, Summation mode) {
+    if (incx == 1) {
+        return asum(n, x, mode);
+    }
+    return mode == Summation::Plain ? detail::sumStrided<detail::Term::Abs, Summation::Plain>(n, x, incx, x, incx)
+                                    : detail::sumStrided<detail::Term::Abs, Summation::Compensated>(n, x, incx, x, incx);
+}
+
+/**
+ * @brief Strided Euclidean norm.
+ */
+template<typename T>
+    requires std::is_floating_point_v<Widened<T>>
+Widened<T> nrm2(size_t n, const T* x, size_t incx, Summation mode) {
+    if (incx == 1) {
+        return nrm2(n, x, mode);
+    }
+    return std::sqrt(mode == Summation::Plain
+        ? detail::sumStrided<detail::Term::Square, Summation::Plain>(n, x, incx, x, incx)
+        : detail::sumStrided<detail::Term::Square, Summation::Compensated>(n, x, incx, x, incx));
+}
+
+/**
+ * @brief Strided largest absolute value.
+ */
+template<typename T>
+T amax(size_t n, const T* x, size_t incx) {
+    if (incx == 1) {
+        return amax(n, x);
+    }
+    T best = T(0);
+    for (size_t i = 0; i < n; ++i) {
+        const T v = detail::scalarTerm<detail::Term::Abs>(x + i * incx, x, 0);
+        best = v > best ? v : best;
+    }
+    return best;
+}
+
+/**
+ * @brief Strided extrema and their first indices; n must be positive.
+ */
+template<typename T>
+MinMax<T> minmax(size_t n, const T* x, size_t incx) {
+    if (incx == 1) {
+        return minmax(n, x);
+    }
+    MinMax<T> result{x[0], x[0], 0, 0};
+    for (size_t i = 1; i < n; ++i) {
+        const T v = x[i * incx];
+        if (v < result.min) {
+            result.min = v;
+            result.argmin = i;
+        }
+        if (v > result.max) {
+            result.max = v;
+            result.argmax = i;
+        }
+    }
+    return result;
+}
+
+} // namespace kernels
+
+#endif // KERNELS_REDUCE_H
@@ -0,0 +1,395 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_SIMD_H
+#define KERNELS_SIMD_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Explicit SIMD kernels for elementwise work on contiguous arrays.
+ *
+ * Each kernel is compiled once per instruction set with a target
+ * attribute, so the binary runs on any x86-64 CPU while still using
+ * AVX2 or AVX-512 where cpuid reports them. The vector width comes from
+ * GCC/Clang vector extensions, which lower to plain SSE2/AVX2/AVX-512
+ * loads, stores and arithmetic for float, double, int32 and int64.
+ */
+namespace kernels {
+
+/**
+ * @brief Instruction sets the kernels are compiled for, in increasing order.
+ */
+enum class Isa { Scalar, SSE2, AVX2, AVX512 };
+
+/**
+ * @brief Elementwise operations with a SIMD kernel.
+ */
+enum class BinaryOp { Add, Sub, Mul, Div };
+
+/**
+ * @brief Fused BLAS-1 style operations, each a single pass over memory.
+ */
+enum class FusedOp {
+    Scal,  ///< out = alpha * x
+    Axpy,  ///< out = alpha * x + y
+    Axpby, ///< out = alpha * x + beta * y
+    Fma,   ///< out = x * y + z
+    Clamp  ///< out = min(max(x, alpha), beta)
+};
+
+namespace detail {
+
+inline Isa detectIsa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return Isa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return Isa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return Isa::SSE2;
+    }
+#endif
+    return Isa::Scalar;
+}
+
+inline std::atomic<Isa>& selectedIsa() {
+    static std::atomic<Isa> isa{detectIsa()};
+    return isa;
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns the widest instruction set this CPU supports.
+ */
+inline Isa supportedIsa() {
+    static const Isa isa = detail::detectIsa();
+    return isa;
+}
+
+/**
+ * @brief Returns the instruction set the kernels currently dispatch to.
+ */
+inline Isa activeIsa() {
+    return detail::selectedIsa().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Limits dispatch to isa, or to the widest supported set below it.
+ *
+ * Meant for tests and benchmarks that compare code paths.
+ */
+inline void setIsa(Isa isa) {
+    detail::selectedIsa().store(std::min(isa, supportedIsa()), std::memory_order_relaxed);
+}
+
+/**
+ * @brief True for element types with SIMD kernels.
+ */
+template<typename T>
+constexpr bool kSimdElement = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                              std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::int64_t>;
+
+/**
+ * @brief True if binary<op, T> is vectorized; integer division has no SIMD instruction.
+ */
+template<BinaryOp op, typename T>
+constexpr bool kSimdBinary = kSimdElement<T> && (op != BinaryOp::Div || std::is_floating_point_v<T>);
+
+namespace detail {
+
+template<BinaryOp op, typename T>
+inline T apply(T a, T b) {
+    if constexpr (op == BinaryOp::Add) {
+        return a + b;
+    } else if constexpr (op == BinaryOp::Sub) {
+        return a - b;
+    } else if constexpr (op == BinaryOp::Mul) {
+        return a * b;
+    } else {
+        return a / b;
+    }
+}
+
+/**
+ * @brief out[i] = a[i] op b[i] with Bytes-wide vectors; out may alias a or b.
+ */
+template<size_t Bytes, BinaryOp op, typename T>
+[[gnu::always_inline]] inline void binaryLoop(size_t n, const T* a, const T* b, T* out) {
+    typedef T V __attribute__((vector_size(Bytes)));
+    constexpr size_t lanes = Bytes / sizeof(T);
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        V x, y, r;
+        std::memcpy(&x, a + i, Bytes);
+        std::memcpy(&y, b + i, Bytes);
+        if constexpr (op == BinaryOp::Add) {
+            r = x + y;
+        } else if constexpr (op == BinaryOp::Sub) {
+            r = x - y;
+        } else if constexpr (op == BinaryOp::Mul) {
+            r = x * y;
+        } else {
+            r = x / y;
+        }
+        std::memcpy(out + i, &r, Bytes);
+    }
+    for (; i < n; ++i) {
+        out[i] = apply<op>(a[i], b[i]);
+    }
+}
+
+/**
+ * @brief Returns true if any of x[0..n) equals zero; the vector part has no early exit.
+ */
+template<size_t Bytes, typename T>
+[[gnu::always_inline]] inline bool anyZeroLoop(size_t n, const T* x) {
+    typedef T V __attribute__((vector_size(Bytes)));
+    using Mask = decltype(V{} == V{});
+    constexpr size_t lanes = Bytes / sizeof(T);
+    Mask hits = {};
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        V v;
+        std::memcpy(&v, x + i, Bytes);
+        hits |= v == V{};
+    }
+    bool zero = false;
+    for (size_t l = 0; l < lanes; ++l) {
+        zero |= hits[l] != 0;
+    }
+    for (; i < n; ++i) {
+        zero |= x[i] == T(0);
+    }
+    return zero;
+}
+
+template<FusedOp op, typename T>
+inline T fusedApply(T alpha, T beta, T x, T y, T z) {
+    if constexpr (op == FusedOp::Scal) {
+        return alpha * x;
+    } else if constexpr (op == FusedOp::Axpy) {
+        return alpha * x + y;
+    } else if constexpr (op == FusedOp::Axpby) {
+        return alpha * x + beta * y;
+    } else if constexpr (op == FusedOp::Fma) {
+        return x * y + z;
+    } else {
+        const T low = x < alpha ? alpha : x;
+        return low > beta ? beta : low;
+    }
+}
+
+/**
+ * @brief out[i] = op(x[i], y[i], z[i]) with Bytes-wide vectors; out may alias any input.
+ *
+ * Inputs the operation does not use may be null.
+ */
+template<size_t Bytes, FusedOp op, typename T>
+[[gnu::always_inline]] inline void fusedLoop(size_t n, T alpha, T beta, const T* x, const T* y, const T* z,
+                                             T* out) {
+    typedef T V __attribute__((vector_size(Bytes)));
+    constexpr size_t lanes = Bytes / sizeof(T);
+    constexpr bool readsY = op == FusedOp::Axpy || op == FusedOp::Axpby || op == FusedOp::Fma;
+    const V a = V{} + alpha;
+    const V b = V{} + beta;
+    size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+        V vx, vy = {}, vz = {}, r;
+        std::memcpy(&vx, x + i, Bytes);
+        if constexpr (readsY) {
+            std::memcpy(&vy, y + i, Bytes);
+        }
+        if constexpr (op == FusedOp::Fma) {
+            std::memcpy(&vz, z + i, Bytes);
+        }
+        if constexpr (op == FusedOp::Scal) {
+            r = a * vx;
+        } else if constexpr (op == FusedOp::Axpy) {
+            r = a * vx + vy;
+        } else if constexpr (op == FusedOp::Axpby) {
+            r = a * vx + b * vy;
+        } else if constexpr (op == FusedOp::Fma) {
+            r = vx * vy + vz;
+        } else {
+            r = vx < a ? a : vx;
+            r = r > b ? b : r;
+        }
+        std::memcpy(out + i, &r, Bytes);
+    }
+    for (; i < n; ++i) {
+        out[i] = fusedApply<op>(alpha, beta, x[i], readsY ? y[i] : T(0), op == FusedOp::Fma ? z[i] : T(0));
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+template<FusedOp op, typename T>
+__attribute__((target("sse2"))) void fusedSse2(size_t n, T alpha, T beta, const T* x, const T* y, const T* z,
+                                               T* out) {
+    fusedLoop<16, op>(n, alpha, beta, x, y, z, out);
+}
+
+template<FusedOp op, typename T>
+__attribute__((target("avx2"))) void fusedAvx2(size_t n, T alpha, T beta, const T* x, const T* y, const T* z,
+                                               T* out) {
+    fusedLoop<32, op>(n, alpha, beta, x, y, z, out);
+}
+
+template<FusedOp op, typename T>
+__attribute__((target("avx512f"))) void fusedAvx512(size_t n, T alpha, T beta, const T* x, const T* y, const T* z,
+                                                    T* out) {
+    fusedLoop<64, op>(n, alpha, beta, x, y, z, out);
+}
+
+template<BinaryOp op, typename T>
+__attribute__((target("sse2"))) void binarySse2(size_t n, const T* a, const T* b, T* out) {
+    binaryLoop<16, op>(n, a, b, out);
+}
+
+template<BinaryOp op, typename T>
+__attribute__((target("avx2"))) void binaryAvx2(size_t n, const T* a, const T* b, T* out) {
+    binaryLoop<32, op>(n, a, b, out);
+}
+
+template<BinaryOp op, typename T>
+__attribute__((target("avx512f"))) void binaryAvx512(size_t n, const T* a, const T* b, T* out) {
+    binaryLoop<64, op>(n, a, b, out);
+}
+
+template<typename T>
+__attribute__((target("sse2"))) bool anyZeroSse2(size_t n, const T* x) {
+    return anyZeroLoop<16>(n, x);
+}
+
+template<typename T>
+__attribute__((target("avx2"))) bool anyZeroAvx2(size_t n, const T* x) {
+    return anyZeroLoop<32>(n, x);
+}
+
+template<typename T>
+__attribute__((target("avx512f"))) bool anyZeroAvx512(size_t n, const T* x) {
+    return anyZeroLoop<64>(n, x);
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief out[i] = a[i] op b[i] for i < n, on the active instruction set.
+ *
+ * out may be the same array as a or b, which gives in-place updates.
+ */
+template<BinaryOp op, typename T>
+    requires kSimdBinary<op, T>
+void binary(size_t n, const T* a, const T* b, T* out) {
+#if defined(__x86_64__) || defined(__i386__)
+    switch (activeIsa()) {
+    case Isa::AVX512:
+        return detail::binaryAvx512<op>(n, a, b, out);
+    case Isa::AVX2:
+        return detail::binaryAvx2<op>(n, a, b, out);
+    case Isa::SSE2:
+        return detail::binarySse2<op>(n, a, b, out);
+    case Isa::Scalar:
+        break;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = detail::apply<op>(a[i], b[i]);
+    }
+}
+
+/**
+ * @brief out[i] = op(x[i], y[i], z[i]) for i < n, on the active instruction set.
+ *
+ * See FusedOp for what each operation reads; unused inputs may be null
+ * and out may be the same array as any input.
+ */
+template<FusedOp op, typename T>
+void fused(size_t n, T alpha, T beta, const T* x, const T* y, const T* z, T* out) {
+    if constexpr (kSimdElement<T>) {
+#if defined(__x86_64__) || defined(__i386__)
+        switch (activeIsa()) {
+        case Isa::AVX512:
+            return detail::fusedAvx512<op>(n, alpha, beta, x, y, z, out);
+        case Isa::AVX2:
+            return detail::fusedAvx2<op>(n, alpha, beta, x, y, z, out);
+        case Isa::SSE2:
+            return detail::fusedSse2<op>(n, alpha, beta, x, y, z, out);
+        case Isa::Scalar:
+            break;
+        }
+#endif
+    }
+    constexpr bool readsY = op == FusedOp::Axpy || op == FusedOp::Axpby || op == FusedOp::Fma;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = detail::fusedApply<op>(alpha, beta, x[i], readsY ? y[i] : T(0), op == FusedOp::Fma ? z[i] : T(0));
+    }
+}
+
+/**
+ * @brief Returns true if any of x[0..n) equals zero.
+ *
+ * Used as the divide-by-zero pre-scan, so the division loop itself has
+ * no per-element branch.
+ */
+template<typename T>
+    requires kSimdElement<T>
+bool anyZero(size_t n, const T* x) {
+#if defined(__x86_64__) || defined(__i386__)
+    switch (activeIsa()) {
+    case Isa::AVX512:
+        return detail::anyZeroAvx512(n, x);
+    case Isa::AVX2:
+        return detail::anyZeroAvx2(n, x);
+    case Isa::SSE2:
+        return detail::anyZeroSse2(n, x);
+    case Isa::Scalar:
+        break;
+    }
+#endif
+    bool zero = false;
+    for (size_t i = 0; i < n; ++i) {
+        zero |= x[i] == T(0);
+    }
+    return zero;
+}
+
+} // namespace kernels
+
+#endif // KERNELS_SIMD_H
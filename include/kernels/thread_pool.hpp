@@ -0,0 +1,264 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef KERNELS_THREAD_POOL_H
+#define KERNELS_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kernels {
+
+/**
+ * @class ThreadPool
+ * @brief A fixed set of worker threads shared by all parallel kernels.
+ *
+ * The calling thread always takes part in the work, so a pool of size N
+ * owns N - 1 workers. Calls made from inside a running task, or while
+ * another thread holds the pool, fall back to a serial loop instead of
+ * blocking.
+ */
+class ThreadPool final {
+public:
+    /**
+     * @brief Returns the process-wide pool, sized to the hardware concurrency.
+     */
+    static ThreadPool& instance() {
+        static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+        return pool;
+    }
+
+    /**
+     * @brief Constructor.
+     *
+     * @param threads Total number of threads, including the caller.
+     */
+    explicit ThreadPool(size_t threads) {
+        start(threads);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Destructor. Stops and joins all workers.
+     */
+    ~ThreadPool() {
+        stop();
+    }
+
+    /**
+     * @brief Returns the number of threads, including the caller.
+     */
+    size_t size() const noexcept {
+        return workers.size() + 1;
+    }
+
+    /**
+     * @brief Changes the number of threads.
+     *
+     * @param threads Total number of threads, including the caller.
+     */
+    void resize(size_t threads) {
+        std::lock_guard<std::mutex> runLock(runMutex);
+        stop();
+        start(threads);
+    }
+
+    /**
+     * @brief Runs fn(0) ... fn(tasks - 1) across the pool and waits for them.
+     *
+     * The first exception thrown by a task is rethrown to the caller once
+     * all tasks have finished.
+     *
+     * @param tasks Number of tasks.
+     * @param fn Callable taking the task index.
+     */
+    template<typename F>
+    void run(size_t tasks, F&& fn) {
+        if (tasks == 0) {
+            return;
+        }
+        if (tasks == 1 || insideTask()) {
+            runSerial(tasks, fn);
+            return;
+        }
+        // resize() replaces the workers under runMutex, so they are only counted once it is held.
+        std::unique_lock<std::mutex> runLock(runMutex, std::try_to_lock);
+        if (!runLock.owns_lock() || workers.empty()) {
+            runSerial(tasks, fn);
+            return;
+        }
+
+        using Fn = std::remove_reference_t<F>;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job.invoke = [](void* ctx, size_t i) { (*static_cast<Fn*>(ctx))(i); };
+            job.ctx = const_cast<void*>(static_cast<const void*>(&fn));
+            job.tasks = tasks;
+            job.next.store(0, std::memory_order_relaxed);
+            job.error = nullptr;
+            pending = workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+
+        work();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        if (job.error) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+private:
+    struct Job {
+        void (*invoke)(void*, size_t) = nullptr;
+        void* ctx = nullptr;
+        size_t tasks = 0;
+        std::atomic<size_t> next{0};
+        std::exception_ptr error;
+    };
+
+    std::vector<std::thread> workers; ///< Worker threads (the caller is not included).
+    std::mutex runMutex;              ///< Held by the thread currently driving a job.
+    std::mutex mutex;                 ///< Protects the job and the counters below.
+    std::condition_variable wake;     ///< Signals workers that a new job is ready.
+    std::condition_variable done;     ///< Signals the caller that all workers finished.
+    Job job;
+    size_t generation = 0;
+    size_t pending = 0;
+    bool stopping = false;
+
+    static bool& insideTask() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    template<typename F>
+    static void runSerial(size_t tasks, F& fn) {
+        for (size_t i = 0; i < tasks; ++i) {
+            fn(i);
+        }
+    }
+
+    void start(size_t threads) {
+        size_t current;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = false;
+            current = generation;
+        }
+        // New workers must not take the last job, which already finished, for a new one.
+        for (size_t i = 1; i < threads; ++i) {
+            workers.emplace_back([this, current] { loop(current); });
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+    }
+
+    void work() {
+        insideTask() = true;
+        size_t i;
+        while ((i = job.next.fetch_add(1, std::memory_order_relaxed)) < job.tasks) {
+            try {
+                job.invoke(job.ctx, i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!job.error) {
+                    job.error = std::current_exception();
+                }
+            }
+        }
+        insideTask() = false;
+    }
+
+    void loop(size_t seen) {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            work();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        }
+    }
+};
+
+/**
+ * @brief Splits [begin, end) into chunks of @p grain and runs them in parallel.
+ *
+ * Chunk boundaries depend only on the range and the grain, never on the
+ * number of threads.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param grain Number of indices per chunk.
+ * @param fn Callable taking a half-open sub-range (lo, hi).
+ */
+template<typename F>
+void parallel_for(size_t begin, size_t end, size_t grain, F&& fn) {
+    if (end <= begin) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (end - begin + grain - 1) / grain;
+    ThreadPool::instance().run(chunks, [&](size_t c) {
+        const size_t lo = begin + c * grain;
+        fn(lo, std::min(end, lo + grain));
+    });
+}
+
+} // namespace kernels
+
+#endif // KERNELS_THREAD_POOL_H
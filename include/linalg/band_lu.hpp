@@ -0,0 +1,245 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_BAND_LU_H
+#define LINALG_BAND_LU_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "common.hpp"
+#include "../types/band_matrix.hpp"
+
+/**
+ * @class BandLU
+ * @brief LU factorization of a band matrix with partial pivoting.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * Row interchanges can push U up to kl + ku superdiagonals, so every row
+ * of the working storage holds 2 * kl + ku + 1 slots around the diagonal.
+ * The multipliers of each step are kept apart from U, as in LAPACK's
+ * gbtrf, so the factorization and each solve cost O(n * kl * (kl + ku))
+ * instead of O(n^3).
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class BandLU final {
+public:
+    /**
+     * @brief Factors a band matrix.
+     *
+     * @param matrix The matrix to factor.
+     */
+    explicit BandLU(const BandMatrix<T>& matrix)
+        : n(matrix.size()), kl(matrix.getLower()), ku(matrix.getUpper()),
+          width(2 * kl + ku + 1), u(n * width), multipliers(n * kl), pivots(n) {
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(matrix.element(i, matrix.first(i)), matrix.element(i, matrix.last(i)),
+                      element(i, matrix.first(i)));
+        }
+        factor();
+    }
+
+    /**
+     * @brief Returns the order of the factored matrix.
+     */
+    size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns true if a zero pivot was met during factorization.
+     */
+    bool isSingular() const {
+        return singular;
+    }
+
+    /**
+     * @brief Returns the determinant of the factored matrix.
+     */
+    T det() const {
+        if (singular) {
+            return T(0);
+        }
+        T result = oddSwaps ? T(-1) : T(1);
+        for (size_t i = 0; i < n; ++i) {
+            result *= *element(i, i);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Solves A * x = b.
+     */
+    Vector<T> solve(const Vector<T>& b) const {
+        if (b.size() != n) {
+            throw std::invalid_argument("Right-hand side size does not match the matrix.");
+        }
+        Vector<T> x(b);
+        solveInPlace(x.mutableData(), 1, 1);
+        return x;
+    }
+
+    /**
+     * @brief Solves A * X = B for all columns of B at once.
+     */
+    Matrix<T> solve(const Matrix<T>& b) const {
+        if (static_cast<size_t>(b.getRows()) != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the matrix.");
+        }
+        const size_t nrhs = b.getCols();
+        std::vector<T> x = kernels::toBuffer(b);
+        solveInPlace(x.data(), nrhs, nrhs);
+        return kernels::fromBuffer(x.data(), n, nrhs, nrhs);
+    }
+
+    /**
+     * @brief Solves A * X = B in place on a row-major buffer.
+     *
+     * Right-hand sides are independent, so wide B is split into column
+     * stripes that are solved in parallel.
+     *
+     * @param b Pointer to the first element of B, overwritten with X.
+     * @param nrhs Number of columns of B.
+     * @param ldb Distance between consecutive rows of B.
+     */
+    void solveInPlace(T* b, size_t nrhs, size_t ldb) const {
+        if (singular) {
+            throw std::invalid_argument("Matrix is singular.");
+        }
+        const size_t grain = std::max<size_t>(64, kernels::kStreamGrain / (n * (width - kl) + 1));
+        kernels::parallel_for(0, nrhs, grain, [&](size_t lo, size_t hi) {
+            const size_t k = hi - lo;
+            // Forward: replay the interchanges and eliminations of each step.
+            for (size_t j = 0; j < n; ++j) {
+                T* bj = b + j * ldb + lo;
+                if (pivots[j] != j) {
+                    std::swap_ranges(bj, bj + k, b + pivots[j] * ldb + lo);
+                }
+                const T* m = multipliers.data() + j * kl;
+                for (size_t r = j + 1; r < std::min(n, j + kl + 1); ++r) {
+                    kernels::axpy(k, -m[r - j - 1], bj, b + r * ldb + lo);
+                }
+            }
+            // Backward: U has at most kl + ku superdiagonals.
+            for (size_t i = n; i-- > 0;) {
+                T* bi = b + i * ldb + lo;
+                const T* ui = element(i, i);
+                for (size_t c = i + 1; c < std::min(n, i + kl + ku + 1); ++c) {
+                    kernels::axpy(k, -ui[c - i], b + c * ldb + lo, bi);
+                }
+                for (size_t j = 0; j < k; ++j) {
+                    bi[j] /= ui[0];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Returns the pivot rows: row i was swapped with row getPivots()[i].
+     */
+    const std::vector<size_t>& getPivots() const {
+        return pivots;
+    }
+
+private:
+    size_t n;                   ///< Order of the matrix.
+    size_t kl;                  ///< Number of subdiagonals.
+    size_t ku;                  ///< Number of superdiagonals.
+    size_t width;               ///< Slots per row of u.
+    std::vector<T> u;           ///< U, kl + ku superdiagonals wide, plus kl slots on the left.
+    std::vector<T> multipliers; ///< kl multipliers per elimination step.
+    std::vector<size_t> pivots; ///< LAPACK-style row interchanges.
+    bool oddSwaps = false;      ///< Parity of the permutation.
+    bool singular = false;      ///< True if a zero pivot was met.
+
+    T* element(size_t i, size_t j) {
+        return u.data() + i * width + (j + kl - i);
+    }
+
+    const T* element(size_t i, size_t j) const {
+        return u.data() + i * width + (j + kl - i);
+    }
+
+    void factor() {
+        for (size_t j = 0; j < n; ++j) {
+            const size_t rows = std::min(n, j + kl + 1);
+            const size_t cols = std::min(n, j + kl + ku + 1);
+            size_t p = j;
+            T best = std::abs(*element(j, j));
+            for (size_t i = j + 1; i < rows; ++i) {
+                const T value = std::abs(*element(i, j));
+                if (value > best) {
+                    best = value;
+                    p = i;
+                }
+            }
+            pivots[j] = p;
+            if (p != j) {
+                // Row p ends at column p + ku <= cols, row j fits in row p's slots likewise.
+                std::swap_ranges(element(j, j), element(j, cols), element(p, j));
+                oddSwaps = !oddSwaps;
+            }
+            const T pivot = *element(j, j);
+            if (pivot == T(0)) {
+                singular = true;
+                continue;
+            }
+            const T* uj = element(j, j + 1);
+            T* m = multipliers.data() + j * kl;
+            for (size_t i = j + 1; i < rows; ++i) {
+                T* ri = element(i, j);
+                const T l = m[i - j - 1] = ri[0] / pivot;
+                ri[0] = T(0);
+                kernels::axpy(cols - j - 1, -l, uj, ri + 1);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Solves A * x = b for a band matrix A.
+ */
+template<typename T>
+Vector<T> solve(const BandMatrix<T>& a, const Vector<T>& b) {
+    return BandLU<T>(a).solve(b);
+}
+
+/**
+ * @brief Solves A * X = B for a band matrix A and every column of B.
+ */
+template<typename T>
+Matrix<T> solve(const BandMatrix<T>& a, const Matrix<T>& b) {
+    return BandLU<T>(a).solve(b);
+}
+
+#endif // LINALG_BAND_LU_H
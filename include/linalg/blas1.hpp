@@ -0,0 +1,156 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_BLAS1_H
+#define LINALG_BLAS1_H
+
+#include <stdexcept>
+#include <type_traits>
+#include "../types/vector.hpp"
+#include "../kernels/parallel.hpp"
+#include "../kernels/simd.hpp"
+
+/**
+ * In-place level-1 operations on vectors and contiguous views.
+ *
+ * Each call is one pass over memory that writes straight into its
+ * destination: no temporaries, no allocation. Long vectors are split
+ * across the thread pool like every other elementwise kernel. The same
+ * updates can be written as expressions (`y = a * x + y`); these
+ * functions name them and guarantee the fused SIMD kernel.
+ */
+
+template<typename X>
+struct IsContiguousVector : std::false_type {};
+
+template<typename T>
+struct IsContiguousVector<Vector<T>> : std::true_type {};
+
+template<typename T, typename B>
+struct IsContiguousVector<VectorView<T, B>> : std::true_type {};
+
+/**
+ * @brief A Vector or a VectorView, possibly const.
+ */
+template<typename X>
+concept ContiguousVector = IsContiguousVector<std::remove_cvref_t<X>>::value;
+
+/**
+ * @brief A Vector or VectorView whose elements may be written.
+ */
+template<typename X>
+concept WritableVector = ContiguousVector<X> &&
+    !std::is_const_v<std::remove_pointer_t<decltype(std::declval<X&>().view().begin())>>;
+
+template<typename X>
+using ElementType = typename std::remove_cvref_t<X>::value_type;
+
+namespace kernels {
+
+/**
+ * @brief Runs the fused kernel op over out, split like the elementwise kernels.
+ *
+ * @throws std::invalid_argument if an input used by op differs in size from out.
+ */
+template<FusedOp op, typename T>
+void fusedInto(T alpha, T beta, VectorView<const T> x, VectorView<const T> y, VectorView<const T> z,
+               VectorView<T> out) {
+    constexpr bool readsY = op == FusedOp::Axpy || op == FusedOp::Axpby || op == FusedOp::Fma;
+    if (x.size() != out.size() || (readsY && y.size() != out.size()) ||
+        (op == FusedOp::Fma && z.size() != out.size())) {
+        throw std::invalid_argument("Vectors must have the same size.");
+    }
+    forEachChunk(out.size(), out.begin(), [&](size_t lo, size_t hi) {
+        fused<op>(hi - lo, alpha, beta, x.begin() + lo, readsY ? y.begin() + lo : nullptr,
+                  op == FusedOp::Fma ? z.begin() + lo : nullptr, out.begin() + lo);
+    });
+}
+
+} // namespace kernels
+
+/**
+ * @brief y = alpha * x + y.
+ *
+ * @throws std::invalid_argument if the sizes differ.
+ */
+template<ContiguousVector X, WritableVector Y>
+    requires std::same_as<ElementType<X>, ElementType<Y>>
+void axpy(const ElementType<Y>& alpha, const X& x, Y&& y) {
+    const auto out = y.view();
+    kernels::fusedInto<kernels::FusedOp::Axpy, ElementType<Y>>(alpha, {}, x.view(), out, {}, out);
+}
+
+/**
+ * @brief y = alpha * x + beta * y.
+ *
+ * @throws std::invalid_argument if the sizes differ.
+ */
+template<ContiguousVector X, WritableVector Y>
+    requires std::same_as<ElementType<X>, ElementType<Y>>
+void axpby(const ElementType<Y>& alpha, const X& x, const ElementType<Y>& beta, Y&& y) {
+    const auto out = y.view();
+    kernels::fusedInto<kernels::FusedOp::Axpby, ElementType<Y>>(alpha, beta, x.view(), out, {}, out);
+}
+
+/**
+ * @brief x = alpha * x.
+ */
+template<WritableVector X>
+void scal(const ElementType<X>& alpha, X&& x) {
+    const auto out = x.view();
+    kernels::fusedInto<kernels::FusedOp::Scal, ElementType<X>>(alpha, {}, out, {}, {}, out);
+}
+
+/**
+ * @brief out = x * y + z, elementwise; out may be any of the inputs.
+ *
+ * @throws std::invalid_argument if the sizes differ.
+ */
+template<ContiguousVector X, ContiguousVector Y, ContiguousVector Z, WritableVector Out>
+    requires std::same_as<ElementType<X>, ElementType<Out>> && std::same_as<ElementType<Y>, ElementType<Out>> &&
+             std::same_as<ElementType<Z>, ElementType<Out>>
+void fma(const X& x, const Y& y, const Z& z, Out&& out) {
+    kernels::fusedInto<kernels::FusedOp::Fma, ElementType<Out>>({}, {}, x.view(), y.view(), z.view(), out.view());
+}
+
+/**
+ * @brief Limits every element of x to [lo, hi] in place.
+ *
+ * @throws std::invalid_argument if lo > hi.
+ */
+template<WritableVector X>
+void clamp(X&& x, const ElementType<X>& lo, const ElementType<X>& hi) {
+    if (hi < lo) {
+        throw std::invalid_argument("Lower bound must not exceed upper bound.");
+    }
+    const auto out = x.view();
+    kernels::fusedInto<kernels::FusedOp::Clamp, ElementType<X>>(lo, hi, out, {}, {}, out);
+}
+
+#endif // LINALG_BLAS1_H
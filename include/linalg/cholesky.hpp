@@ -0,0 +1,179 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_CHOLESKY_H
+#define LINALG_CHOLESKY_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "common.hpp"
+
+/**
+ * @class Cholesky
+ * @brief Cholesky factorization of a symmetric positive definite matrix, A = L * L^T.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * Only the lower triangle of the input is read. The factorization is
+ * blocked and right-looking: each diagonal block is factored, the panel
+ * below it is solved with trsm and the trailing matrix is updated with
+ * syrk, in parallel for large sizes.
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class Cholesky final {
+public:
+    /**
+     * @brief Factors a symmetric positive definite matrix.
+     *
+     * @param matrix The matrix to factor.
+     * @throws std::invalid_argument if the matrix is not square or not positive definite.
+     */
+    explicit Cholesky(const Matrix<T>& matrix) : n(matrix.getRows()), l(kernels::toBuffer(matrix)) {
+        if (matrix.getRows() != matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        factor();
+    }
+
+    /**
+     * @brief Returns the order of the factored matrix.
+     */
+    size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns the determinant of the factored matrix.
+     */
+    T det() const {
+        T result = T(1);
+        for (size_t i = 0; i < n; ++i) {
+            result *= l[i * n + i] * l[i * n + i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Solves A * x = b.
+     */
+    Vector<T> solve(const Vector<T>& b) const {
+        if (b.size() != n) {
+            throw std::invalid_argument("Right-hand side size does not match the matrix.");
+        }
+        Vector<T> x(b);
+        solveInPlace(x.mutableData(), 1, 1);
+        return x;
+    }
+
+    /**
+     * @brief Solves A * X = B for all columns of B at once.
+     */
+    Matrix<T> solve(const Matrix<T>& b) const {
+        if (static_cast<size_t>(b.getRows()) != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the matrix.");
+        }
+        const size_t nrhs = b.getCols();
+        std::vector<T> x = kernels::toBuffer(b);
+        solveInPlace(x.data(), nrhs, nrhs);
+        return kernels::fromBuffer(x.data(), n, nrhs, nrhs);
+    }
+
+    /**
+     * @brief Solves A * X = B in place on a row-major buffer.
+     *
+     * @param b Pointer to the first element of B, overwritten with X.
+     * @param nrhs Number of columns of B.
+     * @param ldb Distance between consecutive rows of B.
+     */
+    void solveInPlace(T* b, size_t nrhs, size_t ldb) const {
+        using namespace kernels;
+        trsm(Side::Left, Uplo::Lower, Op::NoTrans, Diag::NonUnit, n, nrhs, l.data(), n, b, ldb);
+        trsm(Side::Left, Uplo::Lower, Op::Trans, Diag::NonUnit, n, nrhs, l.data(), n, b, ldb);
+    }
+
+    /**
+     * @brief Returns the lower triangular factor L.
+     */
+    Matrix<T> getL() const {
+        Matrix<T> result(n, n);
+        T* out = result.mutableData();
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(l.begin() + i * n, l.begin() + i * n + i + 1, out + i * n);
+        }
+        return result;
+    }
+
+private:
+    size_t n;          ///< Order of the matrix.
+    std::vector<T> l;  ///< L in the lower triangle, row-major; the upper triangle is scratch.
+
+    void factor() {
+        using namespace kernels;
+        T* a = l.data();
+        for (size_t k = 0; k < n; k += kBlockSize) {
+            const size_t kb = std::min(kBlockSize, n - k);
+
+            // Unblocked factorization of the diagonal block.
+            for (size_t j = k; j < k + kb; ++j) {
+                T* rj = a + j * n;
+                T d = rj[j];
+                for (size_t p = k; p < j; ++p) {
+                    d -= rj[p] * rj[p];
+                }
+                if (!(d > T(0))) {
+                    throw std::invalid_argument("Matrix is not positive definite.");
+                }
+                d = std::sqrt(d);
+                rj[j] = d;
+                for (size_t i = j + 1; i < k + kb; ++i) {
+                    T* ri = a + i * n;
+                    T sum = ri[j];
+                    for (size_t p = k; p < j; ++p) {
+                        sum -= ri[p] * rj[p];
+                    }
+                    ri[j] = sum / d;
+                }
+            }
+
+            // L21 = A21 * L11^-T, then A22 -= L21 * L21^T.
+            if (k + kb < n) {
+                const size_t rest = n - k - kb;
+                trsm(Side::Right, Uplo::Lower, Op::Trans, Diag::NonUnit, rest, kb,
+                     a + k * n + k, n, a + (k + kb) * n + k, n);
+                syrk(rest, kb, T(-1), a + (k + kb) * n + k, n, T(1), a + (k + kb) * n + k + kb, n);
+            }
+        }
+    }
+};
+
+#endif // LINALG_CHOLESKY_H
@@ -0,0 +1,66 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_COMMON_H
+#define LINALG_COMMON_H
+
+#include <algorithm>
+#include <vector>
+#include "../types/matrix.hpp"
+#include "../kernels/blas.hpp"
+
+namespace kernels {
+
+/**
+ * @brief Copies a matrix into a contiguous row-major buffer.
+ *
+ * @param matrix Source matrix.
+ * @return Buffer of getRows() * getCols() elements.
+ */
+template<typename T>
+std::vector<T> toBuffer(const Matrix<T>& matrix) {
+    return std::vector<T>(matrix.begin(), matrix.end());
+}
+
+/**
+ * @brief Builds a matrix from a row-major buffer.
+ *
+ * @param src Pointer to the first element.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param ld Distance between consecutive rows in @p src.
+ */
+template<typename T>
+Matrix<T> fromBuffer(const T* src, size_t rows, size_t cols, size_t ld) {
+    return Matrix<T>(MatrixView<const T>(src, rows, cols, ld));
+}
+
+} // namespace kernels
+
+#endif // LINALG_COMMON_H
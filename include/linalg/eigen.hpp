@@ -0,0 +1,434 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_EIGEN_H
+#define LINALG_EIGEN_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "common.hpp"
+
+/**
+ * @class SymmetricEigen
+ * @brief Eigenvalues and eigenvectors of a symmetric matrix, A = V * diag(w) * V^T.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * Only the lower triangle of the input is read. The matrix is reduced to
+ * tridiagonal form with Householder reflectors, one panel of
+ * kernels::kBlockSize columns at a time: inside a panel the reflectors
+ * are generated against the matrix-vector product gemv, and the trailing
+ * matrix then gets a single rank-2k update through gemm. The tridiagonal
+ * matrix is diagonalized with the implicit QL iteration and Wilkinson
+ * shifts. The plane rotations of every sweep are recorded and applied to
+ * the eigenvectors in column stripes, in parallel for large sizes.
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class SymmetricEigen final {
+public:
+    /**
+     * @brief Decomposes a symmetric matrix.
+     *
+     * @param matrix The matrix to decompose; its upper triangle is ignored.
+     * @param computeVectors False to compute the eigenvalues only.
+     * @throws std::invalid_argument if the matrix is not square.
+     * @throws std::runtime_error if the QL iteration does not converge.
+     */
+    explicit SymmetricEigen(const Matrix<T>& matrix, bool computeVectors = true)
+        : n(matrix.getRows()), d(n), e(n, T(0)) {
+        if (matrix.getRows() != matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        std::vector<T> a = kernels::toBuffer(matrix);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = i + 1; j < n; ++j) {
+                a[i * n + j] = a[j * n + i];
+            }
+        }
+        std::vector<T> tau(n, T(0));
+        tridiagonalize(a, tau);
+        if (computeVectors) {
+            v = formQt(a, tau);
+        }
+        diagonalize(computeVectors);
+        sort(computeVectors);
+    }
+
+    /**
+     * @brief Returns the order of the decomposed matrix.
+     */
+    size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns the eigenvalues in ascending order.
+     */
+    Vector<T> getEigenvalues() const {
+        Vector<T> result(n);
+        std::copy(d.begin(), d.end(), result.mutableData());
+        return result;
+    }
+
+    /**
+     * @brief Returns the orthonormal eigenvectors as the columns of a matrix.
+     *
+     * Column j belongs to getEigenvalues()[j].
+     *
+     * @throws std::logic_error if the eigenvectors were not computed.
+     */
+    Matrix<T> getEigenvectors() const {
+        if (v.empty() && n != 0) {
+            throw std::logic_error("Eigenvectors were not computed.");
+        }
+        Matrix<T> result(n, n);
+        T* out = result.mutableData();
+        for (size_t j = 0; j < n; ++j) {
+            const T* vj = v.data() + j * n;
+            for (size_t i = 0; i < n; ++i) {
+                out[i * n + j] = vj[i];
+            }
+        }
+        return result;
+    }
+
+private:
+    size_t n;          ///< Order of the matrix.
+    std::vector<T> d;  ///< Diagonal, then the eigenvalues.
+    std::vector<T> e;  ///< Subdiagonal; e[i] couples i and i + 1.
+    std::vector<T> v;  ///< Eigenvectors as rows, row-major; empty if not requested.
+
+    /**
+     * @brief Blocked Householder reduction to tridiagonal form.
+     *
+     * Reflector j annihilates a[j+2:n, j] and is stored there, with its
+     * leading 1 implicit at a[j+1, j]. Within a panel the matrix is not
+     * updated: the pending update A - V * W^T - W * V^T is applied to
+     * each column right before it is reduced, and the symmetric
+     * products are corrected with V and W (LAPACK's latrd).
+     */
+    void tridiagonalize(std::vector<T>& a, std::vector<T>& tau) {
+        using namespace kernels;
+        T* data = a.data();
+        const size_t reflectors = n > 2 ? n - 2 : 0;
+        std::vector<T> vp, wp, t1, t2, x, w;
+        for (size_t k = 0; k < reflectors; k += kBlockSize) {
+            const size_t kb = std::min(kBlockSize, reflectors - k);
+            const size_t rows = n - k - 1;  // panel rows are k + 1 .. n - 1
+            vp.assign(rows * kb, T(0));
+            wp.assign(rows * kb, T(0));
+            T* vr = vp.data();
+            T* wr = wp.data();
+            for (size_t i = 0; i < kb; ++i) {
+                const size_t j = k + i;
+                // Bring column j (rows j .. n - 1) up to date.
+                if (i > 0) {
+                    const T* vj = vr + (j - k - 1) * kb;
+                    const T* wj = wr + (j - k - 1) * kb;
+                    for (size_t r = j; r < n; ++r) {
+                        const T* vrow = vr + (r - k - 1) * kb;
+                        const T* wrow = wr + (r - k - 1) * kb;
+                        T sum = T(0);
+                        for (size_t p = 0; p < i; ++p) {
+                            sum += vrow[p] * wj[p] + wrow[p] * vj[p];
+                        }
+                        data[r * n + j] -= sum;
+                    }
+                }
+                d[j] = data[j * n + j];
+
+                // Generate the reflector from a[j+1:n, j].
+                T sumsq = T(0);
+                for (size_t r = j + 2; r < n; ++r) {
+                    sumsq += data[r * n + j] * data[r * n + j];
+                }
+                const T alpha = data[(j + 1) * n + j];
+                const size_t off = j + 1 - (k + 1);
+                vr[off * kb + i] = T(1);
+                if (sumsq == T(0)) {
+                    e[j] = alpha;
+                    continue;
+                }
+                const T beta = -std::copysign(std::hypot(alpha, std::sqrt(sumsq)), alpha);
+                tau[j] = (beta - alpha) / beta;
+                const T scale = T(1) / (alpha - beta);
+                for (size_t r = j + 2; r < n; ++r) {
+                    data[r * n + j] *= scale;
+                    vr[(r - k - 1) * kb + i] = data[r * n + j];
+                }
+                e[j] = beta;
+
+                // w = tau * (A - V W^T - W V^T) v over rows j + 1 .. n - 1.
+                const size_t len = n - j - 1;
+                x.resize(len);
+                w.resize(len);
+                for (size_t r = 0; r < len; ++r) {
+                    x[r] = vr[(off + r) * kb + i];
+                }
+                gemv(Op::NoTrans, len, len, tau[j], [&](size_t r) { return data + (j + 1 + r) * n + j + 1; },
+                     x.data(), T(0), w.data());
+                t1.assign(i, T(0));
+                t2.assign(i, T(0));
+                for (size_t r = 0; r < len; ++r) {
+                    const T* vrow = vr + (off + r) * kb;
+                    const T* wrow = wr + (off + r) * kb;
+                    for (size_t p = 0; p < i; ++p) {
+                        t1[p] += wrow[p] * x[r];
+                        t2[p] += vrow[p] * x[r];
+                    }
+                }
+                for (size_t r = 0; r < len; ++r) {
+                    const T* vrow = vr + (off + r) * kb;
+                    const T* wrow = wr + (off + r) * kb;
+                    T sum = T(0);
+                    for (size_t p = 0; p < i; ++p) {
+                        sum += vrow[p] * t1[p] + wrow[p] * t2[p];
+                    }
+                    w[r] -= tau[j] * sum;
+                }
+                const T half = -tau[j] / T(2) * dot(len, w.data(), x.data());
+                for (size_t r = 0; r < len; ++r) {
+                    wr[(off + r) * kb + i] = w[r] + half * x[r];
+                }
+            }
+
+            // Rank-2k update of the trailing matrix with the whole panel.
+            const size_t s = k + kb;
+            const size_t m = n - s;
+            const T* vs = vr + (s - k - 1) * kb;
+            const T* ws = wr + (s - k - 1) * kb;
+            T* trailing = data + s * n + s;
+            gemm(Op::NoTrans, Op::Trans, m, m, kb, T(-1), vs, kb, ws, kb, T(1), trailing, n);
+            gemm(Op::NoTrans, Op::Trans, m, m, kb, T(-1), ws, kb, vs, kb, T(1), trailing, n);
+        }
+        if (n >= 2) {
+            d[n - 2] = data[(n - 2) * n + n - 2];
+            e[n - 2] = data[(n - 1) * n + n - 2];
+        }
+        if (n >= 1) {
+            d[n - 1] = data[(n - 1) * n + n - 1];
+        }
+    }
+
+    /**
+     * @brief Accumulates Q = H_0 * ... * H_{n-3} and returns Q^T.
+     *
+     * Panels are applied to the identity in reverse order as block
+     * reflectors I - V * T * V^T, all three products through gemm. Only
+     * the columns a panel can reach are touched.
+     */
+    std::vector<T> formQt(const std::vector<T>& a, const std::vector<T>& tau) const {
+        using namespace kernels;
+        std::vector<T> q(n * n, T(0));
+        for (size_t i = 0; i < n; ++i) {
+            q[i * n + i] = T(1);
+        }
+        const size_t reflectors = n > 2 ? n - 2 : 0;
+        const size_t panels = (reflectors + kBlockSize - 1) / kBlockSize;
+        std::vector<T> vb, tb, w1, w2;
+        for (size_t panel = panels; panel-- > 0;) {
+            const size_t k = panel * kBlockSize;
+            const size_t kb = std::min(kBlockSize, reflectors - k);
+            const size_t rows = n - k - 1;
+            vb.assign(rows * kb, T(0));
+            for (size_t i = 0; i < kb; ++i) {
+                const size_t j = k + i;
+                vb[i * kb + i] = T(1);
+                for (size_t r = j + 2; r < n; ++r) {
+                    vb[(r - k - 1) * kb + i] = a[r * n + j];
+                }
+            }
+            // T(0:i, i) = -tau_i * T(0:i, 0:i) * V(:, 0:i)^T * v_i
+            tb.assign(kb * kb, T(0));
+            std::vector<T> z(kb);
+            for (size_t i = 0; i < kb; ++i) {
+                std::fill(z.begin(), z.end(), T(0));
+                for (size_t r = i; r < rows; ++r) {
+                    const T* row = vb.data() + r * kb;
+                    for (size_t p = 0; p < i; ++p) {
+                        z[p] += row[p] * row[i];
+                    }
+                }
+                for (size_t p = 0; p < i; ++p) {
+                    T sum = T(0);
+                    for (size_t c = p; c < i; ++c) {
+                        sum += tb[p * kb + c] * z[c];
+                    }
+                    tb[p * kb + i] = -tau[k + i] * sum;
+                }
+                tb[i * kb + i] = tau[k + i];
+            }
+            T* b = q.data() + (k + 1) * n + k + 1;
+            w1.assign(kb * rows, T(0));
+            w2.assign(kb * rows, T(0));
+            gemm(Op::Trans, Op::NoTrans, kb, rows, rows, T(1), vb.data(), kb, b, n, T(0), w1.data(), rows);
+            gemm(Op::NoTrans, Op::NoTrans, kb, rows, kb, T(1), tb.data(), kb, w1.data(), rows, T(0), w2.data(), rows);
+            gemm(Op::NoTrans, Op::NoTrans, rows, rows, kb, T(-1), vb.data(), kb, w2.data(), rows, T(1), b, n);
+        }
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = i + 1; j < n; ++j) {
+                std::swap(q[i * n + j], q[j * n + i]);
+            }
+        }
+        return q;
+    }
+
+    /**
+     * @brief Implicit QL iteration with Wilkinson shifts on (d, e).
+     */
+    void diagonalize(bool computeVectors) {
+        const T eps = std::numeric_limits<T>::epsilon();
+        std::vector<Rotation> sweep;
+        for (size_t l = 0; l < n; ++l) {
+            size_t iterations = 0;
+            while (true) {
+                size_t m = l;
+                for (; m + 1 < n; ++m) {
+                    const T dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                    if (std::abs(e[m]) <= eps * dd) {
+                        break;
+                    }
+                }
+                if (m == l) {
+                    break;
+                }
+                if (++iterations > 30) {
+                    throw std::runtime_error("Eigenvalue iteration did not converge.");
+                }
+                T g = (d[l + 1] - d[l]) / (T(2) * e[l]);
+                T r = std::hypot(g, T(1));
+                g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+                T s = T(1), c = T(1), p = T(0);
+                bool deflated = false;
+                sweep.clear();
+                for (size_t i = m; i-- > l;) {
+                    const T f = s * e[i];
+                    const T b = c * e[i];
+                    r = std::hypot(f, g);
+                    e[i + 1] = r;
+                    if (r == T(0)) {
+                        // Underflow: the matrix splits, start over.
+                        d[i + 1] -= p;
+                        e[m] = T(0);
+                        deflated = true;
+                        break;
+                    }
+                    s = f / r;
+                    c = g / r;
+                    g = d[i + 1] - p;
+                    r = (d[i] - g) * s + T(2) * c * b;
+                    p = s * r;
+                    d[i + 1] = g + p;
+                    g = c * r - b;
+                    if (computeVectors) {
+                        sweep.push_back({i, c, s});
+                    }
+                }
+                if (computeVectors) {
+                    rotate(sweep);
+                }
+                if (!deflated) {
+                    d[l] -= p;
+                    e[l] = g;
+                    e[m] = T(0);
+                }
+            }
+        }
+    }
+
+    struct Rotation {
+        size_t i;  ///< Rotates rows i and i + 1 of v.
+        T c;
+        T s;
+    };
+
+    /**
+     * @brief Applies the rotations of one sweep to the rows of v.
+     *
+     * Every column of v sees the same sequence of rotations, so column
+     * stripes are independent and run in parallel.
+     */
+    void rotate(const std::vector<Rotation>& sweep) {
+        using namespace kernels;
+        auto stripe = [&](size_t lo, size_t hi) {
+            for (const Rotation& rot : sweep) {
+                T* x = v.data() + rot.i * n;
+                T* y = x + n;
+                for (size_t k = lo; k < hi; ++k) {
+                    const T f = y[k];
+                    y[k] = rot.s * x[k] + rot.c * f;
+                    x[k] = rot.c * x[k] - rot.s * f;
+                }
+            }
+        };
+        if (sweep.size() * n < kParallelFlops) {
+            stripe(0, n);
+        } else {
+            const size_t width = std::max<size_t>(64, kStreamGrain / sweep.size()) / kLanes * kLanes;
+            parallel_for(0, n, width, stripe);
+        }
+    }
+
+    /**
+     * @brief Orders the eigenvalues ascending, with their eigenvectors.
+     */
+    void sort(bool computeVectors) {
+        std::vector<size_t> order(n);
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return d[x] < d[y]; });
+        std::vector<T> sorted(n);
+        for (size_t i = 0; i < n; ++i) {
+            sorted[i] = d[order[i]];
+        }
+        d.swap(sorted);
+        if (computeVectors) {
+            std::vector<T> rows(n * n);
+            for (size_t i = 0; i < n; ++i) {
+                std::copy(v.begin() + order[i] * n, v.begin() + (order[i] + 1) * n, rows.begin() + i * n);
+            }
+            v.swap(rows);
+        }
+    }
+};
+
+/**
+ * @brief Returns the eigenvalues of a symmetric matrix in ascending order.
+ */
+template<typename T>
+Vector<T> symmetricEigenvalues(const Matrix<T>& a) {
+    return SymmetricEigen<T>(a, false).getEigenvalues();
+}
+
+#endif // LINALG_EIGEN_H
@@ -0,0 +1,496 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_KRYLOV_H
+#define LINALG_KRYLOV_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "blas1.hpp"
+#include "preconditioners.hpp"
+#include "../kernels/blas.hpp"
+
+/**
+ * Iterative Krylov solvers for A * x = b.
+ *
+ * The operator only has to provide a matrix-vector product: either
+ * `a * x` returning a Vector (Matrix, SparseMatrix, SymmetricMatrix,
+ * BandMatrix, ...) or, for matrix-free operators, a callable `a(x, y)`
+ * that writes A * x into y. Dense matrices are multiplied in place with
+ * gemv. Every solver object owns its work vectors and keeps them between
+ * calls, so repeated solves of the same size allocate nothing.
+ */
+
+/**
+ * @brief An operator that can be applied to a Vector.
+ */
+template<typename A, typename T>
+concept LinearOperator =
+    std::invocable<const A&, const Vector<T>&, Vector<T>&> ||
+    requires(const A& a, const Vector<T>& x) {
+        { a * x } -> std::convertible_to<Vector<T>>;
+    };
+
+/**
+ * @brief Stopping criteria and monitoring shared by the Krylov solvers.
+ */
+template<typename T>
+struct KrylovOptions {
+    T tolerance = T(1e-8);        ///< Target for ||b - A * x|| / ||b||.
+    size_t maxIterations = 1000;  ///< Upper bound on matrix-vector products per solve (GMRES: inner steps).
+    size_t restart = 30;          ///< Krylov basis size before GMRES restarts.
+    /// Called after every iteration with its number and relative residual;
+    /// returning false stops the solve.
+    std::function<bool(size_t, T)> callback;
+};
+
+/**
+ * @brief Outcome of a Krylov solve.
+ */
+template<typename T>
+struct KrylovResult {
+    bool converged = false;  ///< The tolerance was reached.
+    size_t iterations = 0;   ///< Iterations performed.
+    T residual = T(0);       ///< Final ||b - A * x|| / ||b||.
+};
+
+namespace kernels {
+
+namespace detail {
+
+/**
+ * @brief y = A * x for any LinearOperator.
+ */
+template<typename T, typename A>
+void applyOperator(const A& a, const Vector<T>& x, Vector<T>& y) {
+    if constexpr (std::invocable<const A&, const Vector<T>&, Vector<T>&>) {
+        a(x, y);
+    } else if constexpr (std::same_as<A, Matrix<T>>) {
+        if (static_cast<size_t>(a.getCols()) != x.size() || static_cast<size_t>(a.getRows()) != y.size()) {
+            throw std::invalid_argument("Matrix and vector are not compatible for multiplication: size mismatch.");
+        }
+        const T* rows = a.begin();
+        const size_t cols = a.getCols();
+        gemv(Op::NoTrans, y.size(), cols, T(1), [&](size_t i) { return rows + i * cols; }, x.begin(), T(0),
+             y.begin());
+    } else {
+        y = a * x;
+    }
+}
+
+/**
+ * @brief Gives v n elements, reallocating only when the size changes.
+ */
+template<typename T>
+void ensureSize(Vector<T>& v, size_t n) {
+    if (v.size() != n) {
+        v = Vector<T>(n);
+    }
+}
+
+/**
+ * @brief Records one iteration; returns true if the solve should stop.
+ */
+template<typename T>
+bool report(const KrylovOptions<T>& options, KrylovResult<T>& result, T residual) {
+    ++result.iterations;
+    result.residual = residual;
+    result.converged = residual <= options.tolerance;
+    const bool proceed = !options.callback || options.callback(result.iterations, residual);
+    return result.converged || !proceed || result.iterations >= options.maxIterations;
+}
+
+} // namespace detail
+
+} // namespace kernels
+
+/**
+ * @class ConjugateGradient
+ * @brief Preconditioned conjugate gradient for symmetric positive definite A.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * One product with A, one preconditioner application, two dot products
+ * and three fused vector updates per iteration. M must be symmetric
+ * positive definite as well.
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class ConjugateGradient final {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param options Stopping criteria and callback.
+     */
+    explicit ConjugateGradient(KrylovOptions<T> options = {}) : options(std::move(options)) {}
+
+    /**
+     * @brief Returns the options, which may be changed between solves.
+     */
+    KrylovOptions<T>& getOptions() {
+        return options;
+    }
+
+    /**
+     * @brief Solves A * x = b, starting from the given x.
+     *
+     * @param a Operator.
+     * @param b Right-hand side.
+     * @param x Initial guess, overwritten with the solution.
+     * @param m Preconditioner.
+     * @throws std::invalid_argument if x and b differ in size.
+     */
+    template<LinearOperator<T> A, Preconditioner<T> M = IdentityPreconditioner<T>>
+    KrylovResult<T> solve(const A& a, const Vector<T>& b, Vector<T>& x, const M& m = M()) {
+        using kernels::detail::applyOperator;
+        if (x.size() != b.size()) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+        const size_t n = b.size();
+        for (Vector<T>* v : {&r, &z, &p, &q}) {
+            kernels::detail::ensureSize(*v, n);
+        }
+        KrylovResult<T> result;
+        const T bnorm = b.norm2();
+        if (bnorm == T(0)) {
+            std::fill(x.begin(), x.end(), T(0));
+            result.converged = true;
+            return result;
+        }
+
+        applyOperator(a, x, r);
+        axpby(T(1), b, T(-1), r);
+        result.residual = r.norm2() / bnorm;
+        if (result.residual <= options.tolerance || options.maxIterations == 0) {
+            result.converged = result.residual <= options.tolerance;
+            return result;
+        }
+        m.apply(r, z);
+        std::copy(z.begin(), z.end(), p.begin());
+        T rz = r.dot(z);
+        while (true) {
+            applyOperator(a, p, q);
+            const T alpha = rz / p.dot(q);
+            axpy(alpha, p, x);
+            axpy(-alpha, q, r);
+            if (kernels::detail::report(options, result, r.norm2() / bnorm)) {
+                return result;
+            }
+            m.apply(r, z);
+            const T next = r.dot(z);
+            axpby(T(1), z, next / rz, p);
+            rz = next;
+        }
+    }
+
+private:
+    KrylovOptions<T> options;
+    Vector<T> r, z, p, q; ///< Residual, preconditioned residual, direction, A * direction.
+};
+
+/**
+ * @class BiCGSTAB
+ * @brief Stabilized biconjugate gradient for general nonsymmetric A.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * Right-preconditioned: two products with A and two preconditioner
+ * applications per iteration, with short recurrences and a fixed amount
+ * of storage. Stops without converging if the method breaks down
+ * (rho or (r0, v) vanishes).
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class BiCGSTAB final {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param options Stopping criteria and callback.
+     */
+    explicit BiCGSTAB(KrylovOptions<T> options = {}) : options(std::move(options)) {}
+
+    /**
+     * @brief Returns the options, which may be changed between solves.
+     */
+    KrylovOptions<T>& getOptions() {
+        return options;
+    }
+
+    /**
+     * @brief Solves A * x = b, starting from the given x.
+     *
+     * @param a Operator.
+     * @param b Right-hand side.
+     * @param x Initial guess, overwritten with the solution.
+     * @param m Preconditioner.
+     * @throws std::invalid_argument if x and b differ in size.
+     */
+    template<LinearOperator<T> A, Preconditioner<T> M = IdentityPreconditioner<T>>
+    KrylovResult<T> solve(const A& a, const Vector<T>& b, Vector<T>& x, const M& m = M()) {
+        using kernels::detail::applyOperator;
+        if (x.size() != b.size()) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+        const size_t n = b.size();
+        for (Vector<T>* v : {&r, &r0, &p, &v, &s, &t, &ph, &sh}) {
+            kernels::detail::ensureSize(*v, n);
+        }
+        KrylovResult<T> result;
+        const T bnorm = b.norm2();
+        if (bnorm == T(0)) {
+            std::fill(x.begin(), x.end(), T(0));
+            result.converged = true;
+            return result;
+        }
+
+        applyOperator(a, x, r);
+        axpby(T(1), b, T(-1), r);
+        result.residual = r.norm2() / bnorm;
+        if (result.residual <= options.tolerance || options.maxIterations == 0) {
+            result.converged = result.residual <= options.tolerance;
+            return result;
+        }
+        std::copy(r.begin(), r.end(), r0.begin());
+        std::fill(p.begin(), p.end(), T(0));
+        std::fill(v.begin(), v.end(), T(0));
+        T rho = T(1), alpha = T(1), omega = T(1);
+        while (true) {
+            const T next = r0.dot(r);
+            if (next == T(0) || omega == T(0)) {
+                return result;
+            }
+            // p = r + beta * (p - omega * v)
+            const T beta = next / rho * (alpha / omega);
+            axpy(-omega, v, p);
+            axpby(T(1), r, beta, p);
+            rho = next;
+
+            m.apply(p, ph);
+            applyOperator(a, ph, v);
+            const T r0v = r0.dot(v);
+            if (r0v == T(0)) {
+                return result;
+            }
+            alpha = rho / r0v;
+            std::copy(r.begin(), r.end(), s.begin());
+            axpy(-alpha, v, s);
+            const T snorm = s.norm2() / bnorm;
+            if (snorm <= options.tolerance) {
+                axpy(alpha, ph, x);
+                std::copy(s.begin(), s.end(), r.begin());
+                kernels::detail::report(options, result, snorm);
+                return result;
+            }
+
+            m.apply(s, sh);
+            applyOperator(a, sh, t);
+            const T tt = t.dot(t);
+            omega = tt == T(0) ? T(0) : t.dot(s) / tt;
+            axpy(alpha, ph, x);
+            axpy(omega, sh, x);
+            std::copy(s.begin(), s.end(), r.begin());
+            axpy(-omega, t, r);
+            if (kernels::detail::report(options, result, r.norm2() / bnorm)) {
+                return result;
+            }
+        }
+    }
+
+private:
+    KrylovOptions<T> options;
+    Vector<T> r, r0, p, v, s, t, ph, sh; ///< Recurrence vectors; ph and sh are preconditioned p and s.
+};
+
+/**
+ * @class GMRES
+ * @brief Restarted GMRES(m) for general nonsymmetric A.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * Right-preconditioned, so the monitored residual is the true one. The
+ * Krylov basis is orthogonalized with modified Gram-Schmidt and the
+ * small least-squares problem is updated with Givens rotations, so the
+ * residual norm is known after every step without forming x. After
+ * options.restart steps the basis is discarded and the method restarts
+ * from the current x.
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class GMRES final {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param options Stopping criteria, restart length and callback.
+     */
+    explicit GMRES(KrylovOptions<T> options = {}) : options(std::move(options)) {}
+
+    /**
+     * @brief Returns the options, which may be changed between solves.
+     */
+    KrylovOptions<T>& getOptions() {
+        return options;
+    }
+
+    /**
+     * @brief Solves A * x = b, starting from the given x.
+     *
+     * @param a Operator.
+     * @param b Right-hand side.
+     * @param x Initial guess, overwritten with the solution.
+     * @param m Preconditioner.
+     * @throws std::invalid_argument if x and b differ in size or options.restart is zero.
+     */
+    template<LinearOperator<T> A, Preconditioner<T> M = IdentityPreconditioner<T>>
+    KrylovResult<T> solve(const A& a, const Vector<T>& b, Vector<T>& x, const M& m = M()) {
+        using kernels::detail::applyOperator;
+        if (x.size() != b.size()) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+        if (options.restart == 0) {
+            throw std::invalid_argument("GMRES restart length must be positive.");
+        }
+        const size_t n = b.size();
+        const size_t k = options.restart;
+        basis.resize(k + 1);
+        for (Vector<T>& v : basis) {
+            kernels::detail::ensureSize(v, n);
+        }
+        kernels::detail::ensureSize(w, n);
+        kernels::detail::ensureSize(z, n);
+        h.assign((k + 1) * k, T(0));
+        cs.assign(k, T(0));
+        sn.assign(k, T(0));
+        g.assign(k + 1, T(0));
+
+        KrylovResult<T> result;
+        const T bnorm = b.norm2();
+        if (bnorm == T(0)) {
+            std::fill(x.begin(), x.end(), T(0));
+            result.converged = true;
+            return result;
+        }
+
+        while (true) {
+            // r = b - A * x starts a new cycle.
+            Vector<T>& r = basis[0];
+            applyOperator(a, x, r);
+            axpby(T(1), b, T(-1), r);
+            const T beta = r.norm2();
+            result.residual = beta / bnorm;
+            if (result.residual <= options.tolerance || result.iterations >= options.maxIterations) {
+                result.converged = result.residual <= options.tolerance;
+                return result;
+            }
+            scal(T(1) / beta, r);
+            std::fill(g.begin(), g.end(), T(0));
+            g[0] = beta;
+
+            size_t steps = 0;
+            bool done = false;
+            bool invariant = false;
+            while (steps < k && !done && !invariant) {
+                const size_t j = steps++;
+                m.apply(basis[j], z);
+                applyOperator(a, z, w);
+                for (size_t i = 0; i <= j; ++i) {
+                    const T hij = w.dot(basis[i]);
+                    at(i, j) = hij;
+                    axpy(-hij, basis[i], w);
+                }
+                const T norm = w.norm2();
+                at(j + 1, j) = norm;
+                if (norm != T(0)) {
+                    std::copy(w.begin(), w.end(), basis[j + 1].begin());
+                    scal(T(1) / norm, basis[j + 1]);
+                }
+
+                // Apply the previous rotations, then zero h(j + 1, j).
+                for (size_t i = 0; i < j; ++i) {
+                    const T upper = cs[i] * at(i, j) + sn[i] * at(i + 1, j);
+                    at(i + 1, j) = -sn[i] * at(i, j) + cs[i] * at(i + 1, j);
+                    at(i, j) = upper;
+                }
+                const T rr = std::hypot(at(j, j), at(j + 1, j));
+                cs[j] = rr == T(0) ? T(1) : at(j, j) / rr;
+                sn[j] = rr == T(0) ? T(0) : at(j + 1, j) / rr;
+                at(j, j) = rr;
+                at(j + 1, j) = T(0);
+                g[j + 1] = -sn[j] * g[j];
+                g[j] = cs[j] * g[j];
+
+                done = kernels::detail::report(options, result, std::abs(g[j + 1]) / bnorm);
+                // A vanishing norm means the Krylov space is invariant: the
+                // correction below is exact, and the restart confirms it.
+                invariant = norm == T(0);
+            }
+
+            // x += M^-1 * (V * y) with H * y = g.
+            y.assign(g.begin(), g.begin() + steps);
+            for (size_t i = steps; i-- > 0;) {
+                for (size_t c = i + 1; c < steps; ++c) {
+                    y[i] -= at(i, c) * y[c];
+                }
+                y[i] /= at(i, i);
+            }
+            std::fill(w.begin(), w.end(), T(0));
+            for (size_t i = 0; i < steps; ++i) {
+                axpy(y[i], basis[i], w);
+            }
+            m.apply(w, z);
+            axpy(T(1), z, x);
+            if (done) {
+                return result;
+            }
+        }
+    }
+
+private:
+    KrylovOptions<T> options;
+    std::vector<Vector<T>> basis; ///< Orthonormal Krylov basis, restart + 1 vectors.
+    Vector<T> w, z;               ///< A * M^-1 * v_j and M^-1 * v_j.
+    std::vector<T> h;             ///< Hessenberg matrix, row-major (restart + 1) x restart.
+    std::vector<T> cs, sn;        ///< Givens rotations.
+    std::vector<T> g;             ///< Rotated right-hand side of the least-squares problem.
+    std::vector<T> y;             ///< Coefficients of the correction in the basis.
+
+    T& at(size_t i, size_t j) {
+        return h[i * options.restart + j];
+    }
+};
+
+#endif // LINALG_KRYLOV_H
@@ -0,0 +1,284 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_LU_H
+#define LINALG_LU_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "common.hpp"
+
+/**
+ * @class LU
+ * @brief LU factorization with partial pivoting, P * A = L * U.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * The factorization is blocked and right-looking: each panel of
+ * kernels::kBlockSize columns is factored in place, then the trailing
+ * matrix is updated with trsm and gemm, which run in parallel for large
+ * sizes. Once built, the factorization can be reused for any number of
+ * right-hand sides.
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class LU final {
+public:
+    /**
+     * @brief Factors a square matrix.
+     *
+     * @param matrix The matrix to factor.
+     * @throws std::invalid_argument if the matrix is not square.
+     */
+    explicit LU(const Matrix<T>& matrix) : n(matrix.getRows()), lu(kernels::toBuffer(matrix)), pivots(n) {
+        if (matrix.getRows() != matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        factor();
+    }
+
+    /**
+     * @brief Returns the order of the factored matrix.
+     */
+    size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns true if a zero pivot was met during factorization.
+     */
+    bool isSingular() const {
+        return singular;
+    }
+
+    /**
+     * @brief Returns the determinant of the factored matrix.
+     */
+    T det() const {
+        if (singular) {
+            return T(0);
+        }
+        T result = oddSwaps ? T(-1) : T(1);
+        for (size_t i = 0; i < n; ++i) {
+            result *= lu[i * n + i];
+        }
+        return result;
+    }
+
+    /**
+     * @brief Solves A * x = b.
+     *
+     * @param b Right-hand side.
+     * @return The solution x.
+     */
+    Vector<T> solve(const Vector<T>& b) const {
+        if (b.size() != n) {
+            throw std::invalid_argument("Right-hand side size does not match the matrix.");
+        }
+        Vector<T> x(b);
+        solveInPlace(x.mutableData(), 1, 1);
+        return x;
+    }
+
+    /**
+     * @brief Solves A * X = B for all columns of B at once.
+     *
+     * @param b Right-hand sides, one per column.
+     * @return The solutions, one per column.
+     */
+    Matrix<T> solve(const Matrix<T>& b) const {
+        if (static_cast<size_t>(b.getRows()) != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the matrix.");
+        }
+        const size_t nrhs = b.getCols();
+        std::vector<T> x = kernels::toBuffer(b);
+        solveInPlace(x.data(), nrhs, nrhs);
+        return kernels::fromBuffer(x.data(), n, nrhs, nrhs);
+    }
+
+    /**
+     * @brief Solves A * X = B in place on a row-major buffer.
+     *
+     * @param b Pointer to the first element of B, overwritten with X.
+     * @param nrhs Number of columns of B.
+     * @param ldb Distance between consecutive rows of B.
+     */
+    void solveInPlace(T* b, size_t nrhs, size_t ldb) const {
+        using namespace kernels;
+        if (singular) {
+            throw std::invalid_argument("Matrix is singular.");
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (pivots[i] != i) {
+                std::swap_ranges(b + i * ldb, b + i * ldb + nrhs, b + pivots[i] * ldb);
+            }
+        }
+        trsm(Side::Left, Uplo::Lower, Op::NoTrans, Diag::Unit, n, nrhs, lu.data(), n, b, ldb);
+        trsm(Side::Left, Uplo::Upper, Op::NoTrans, Diag::NonUnit, n, nrhs, lu.data(), n, b, ldb);
+    }
+
+    /**
+     * @brief Returns the inverse of the factored matrix.
+     */
+    Matrix<T> inverse() const {
+        std::vector<T> x(n * n, T(0));
+        for (size_t i = 0; i < n; ++i) {
+            x[i * n + i] = T(1);
+        }
+        solveInPlace(x.data(), n, n);
+        return kernels::fromBuffer(x.data(), n, n, n);
+    }
+
+    /**
+     * @brief Returns the unit lower triangular factor L.
+     */
+    Matrix<T> getL() const {
+        Matrix<T> l(n, n);
+        T* out = l.mutableData();
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(lu.begin() + i * n, lu.begin() + i * n + i, out + i * n);
+            out[i * n + i] = T(1);
+        }
+        return l;
+    }
+
+    /**
+     * @brief Returns the upper triangular factor U.
+     */
+    Matrix<T> getU() const {
+        Matrix<T> u(n, n);
+        T* out = u.mutableData();
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(lu.begin() + i * n + i, lu.begin() + (i + 1) * n, out + i * n + i);
+        }
+        return u;
+    }
+
+    /**
+     * @brief Returns the pivot rows: row i was swapped with row getPivots()[i].
+     */
+    const std::vector<size_t>& getPivots() const {
+        return pivots;
+    }
+
+private:
+    size_t n;                   ///< Order of the matrix.
+    std::vector<T> lu;          ///< L (below the diagonal) and U, row-major.
+    std::vector<size_t> pivots; ///< LAPACK-style row interchanges.
+    bool oddSwaps = false;      ///< Parity of the permutation.
+    bool singular = false;      ///< True if a zero pivot was met.
+
+    void factor() {
+        using namespace kernels;
+        T* a = lu.data();
+        for (size_t k = 0; k < n; k += kBlockSize) {
+            const size_t kb = std::min(kBlockSize, n - k);
+
+            // Unblocked factorization of the panel a[k:n, k:k+kb].
+            for (size_t j = k; j < k + kb; ++j) {
+                size_t p = j;
+                T best = std::abs(a[j * n + j]);
+                for (size_t i = j + 1; i < n; ++i) {
+                    const T value = std::abs(a[i * n + j]);
+                    if (value > best) {
+                        best = value;
+                        p = i;
+                    }
+                }
+                pivots[j] = p;
+                if (p != j) {
+                    // Swapping whole rows also applies the interchange to L and to the trailing matrix.
+                    std::swap_ranges(a + j * n, a + (j + 1) * n, a + p * n);
+                    oddSwaps = !oddSwaps;
+                }
+                const T pivot = a[j * n + j];
+                if (pivot == T(0)) {
+                    singular = true;
+                    continue;
+                }
+                const T* rj = a + j * n;
+                for (size_t i = j + 1; i < n; ++i) {
+                    T* ri = a + i * n;
+                    const T l = ri[j] /= pivot;
+                    for (size_t c = j + 1; c < k + kb; ++c) {
+                        ri[c] -= l * rj[c];
+                    }
+                }
+            }
+
+            // U12 = L11^-1 * A12, then A22 -= L21 * U12.
+            if (k + kb < n) {
+                const size_t rest = n - k - kb;
+                trsm(Side::Left, Uplo::Lower, Op::NoTrans, Diag::Unit, kb, rest,
+                     a + k * n + k, n, a + k * n + k + kb, n);
+                gemm(Op::NoTrans, Op::NoTrans, rest, rest, kb, T(-1), a + (k + kb) * n + k, n,
+                     a + k * n + k + kb, n, T(1), a + (k + kb) * n + k + kb, n);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Solves A * x = b.
+ */
+template<typename T>
+Vector<T> solve(const Matrix<T>& a, const Vector<T>& b) {
+    return LU<T>(a).solve(b);
+}
+
+/**
+ * @brief Solves A * X = B for every column of B.
+ */
+template<typename T>
+Matrix<T> solve(const Matrix<T>& a, const Matrix<T>& b) {
+    return LU<T>(a).solve(b);
+}
+
+/**
+ * @brief Returns the determinant of a square matrix.
+ */
+template<typename T>
+T det(const Matrix<T>& a) {
+    return LU<T>(a).det();
+}
+
+/**
+ * @brief Returns the inverse of a square matrix.
+ *
+ * @throws std::invalid_argument if the matrix is singular.
+ */
+template<typename T>
+Matrix<T> inverse(const Matrix<T>& a) {
+    return LU<T>(a).inverse();
+}
+
+#endif // LINALG_LU_H
@@ -0,0 +1,283 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_MATRIX_FUNCTIONS_H
+#define LINALG_MATRIX_FUNCTIONS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "lu.hpp"
+
+/**
+ * Functions of a square matrix built on the blocked GEMM and the LU solve.
+ *
+ * Both work on row-major buffers allocated once per call: every product
+ * writes into a scratch buffer that is then swapped with its operand, so
+ * the number of allocations does not grow with the exponent or with the
+ * number of squarings.
+ */
+
+namespace kernels {
+
+namespace detail {
+
+/**
+ * @brief C = A * B + beta * C for n x n row-major buffers.
+ */
+template<typename T>
+void multiply(size_t n, const T* a, const T* b, T* c, T beta = T(0)) {
+    gemm(Op::NoTrans, Op::NoTrans, n, n, n, T(1), a, n, b, n, beta, c, n);
+}
+
+/**
+ * @brief Largest absolute column sum of an n x n row-major buffer.
+ */
+template<typename T>
+T norm1(size_t n, const T* a) {
+    std::vector<T> sums(n, T(0));
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            sums[j] += std::abs(a[i * n + j]);
+        }
+    }
+    return n == 0 ? T(0) : *std::max_element(sums.begin(), sums.end());
+}
+
+/**
+ * @brief Writes sum_j c[j] * powers[j] + c0 * I into dst.
+ */
+template<typename T, size_t N>
+void combine(size_t n, T c0, const std::array<const T*, N>& powers, const std::array<T, N>& c, T* dst) {
+    for (size_t i = 0; i < n * n; ++i) {
+        T value = T(0);
+        for (size_t j = 0; j < N; ++j) {
+            value += c[j] * powers[j][i];
+        }
+        dst[i] = value;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        dst[i * n + i] += c0;
+    }
+}
+
+/**
+ * @brief Degrees of the Padé approximants and the 1-norm bounds up to
+ * which each of them reaches double precision (Higham, 2005).
+ */
+inline constexpr std::array<int, 5> kPadeDegrees = {3, 5, 7, 9, 13};
+inline constexpr std::array<double, 5> kPadeTheta = {
+    1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1,
+    2.097847961257068e0, 5.371920351148152e0};
+
+/**
+ * @brief Coefficients b_0 .. b_m of the [m/m] Padé approximant of exp.
+ */
+inline const double* padeCoefficients(int m) {
+    static constexpr double b3[] = {120.0, 60.0, 12.0, 1.0};
+    static constexpr double b5[] = {30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0};
+    static constexpr double b7[] = {17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0};
+    static constexpr double b9[] = {17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0,
+                                    2162160.0, 110880.0, 3960.0, 90.0, 1.0};
+    static constexpr double b13[] = {64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+                                     1187353796428800.0, 129060195264000.0, 10559470521600.0,
+                                     670442572800.0, 33522128640.0, 1323241920.0, 40840800.0,
+                                     960960.0, 16380.0, 182.0, 1.0};
+    switch (m) {
+        case 3: return b3;
+        case 5: return b5;
+        case 7: return b7;
+        case 9: return b9;
+        default: return b13;
+    }
+}
+
+} // namespace detail
+
+} // namespace kernels
+
+/**
+ * @brief Raises a square matrix to a non-negative integer power.
+ *
+ * Uses exponentiation by squaring: about 2 * log2(k) products instead of
+ * k - 1. The running power, the result and one scratch buffer are reused
+ * for every product.
+ *
+ * @param a Square matrix.
+ * @param k Exponent; pow(a, 0) is the identity.
+ * @throws std::invalid_argument if the matrix is not square.
+ */
+template<typename T>
+Matrix<T> pow(const Matrix<T>& a, unsigned long long k) {
+    using namespace kernels;
+    if (a.getRows() != a.getCols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    const size_t n = a.getRows();
+    if (k == 0) {
+        Matrix<T> identity(n, n);
+        T* out = identity.mutableData();
+        for (size_t i = 0; i < n; ++i) {
+            out[i * n + i] = T(1);
+        }
+        return identity;
+    }
+
+    std::vector<T> base = toBuffer(a);
+    std::vector<T> scratch(n * n);
+    std::vector<T> result;
+    // The lowest set bit only copies the running power, so no product
+    // with the identity is ever formed.
+    while (true) {
+        if (k & 1) {
+            if (result.empty()) {
+                result = base;
+            } else {
+                detail::multiply(n, result.data(), base.data(), scratch.data());
+                result.swap(scratch);
+            }
+        }
+        k >>= 1;
+        if (k == 0) {
+            break;
+        }
+        detail::multiply(n, base.data(), base.data(), scratch.data());
+        base.swap(scratch);
+    }
+    return fromBuffer(result.data(), n, n, n);
+}
+
+/**
+ * @brief Matrix exponential exp(A).
+ *
+ * Scaling and squaring with Padé approximants (Higham, 2005): the
+ * 1-norm of A selects the lowest degree m in {3, 5, 7, 9, 13} that is
+ * accurate to double precision, scaling A by 2^-s first if even degree
+ * 13 is not enough. The approximant r_m = q_m^-1 * p_m is obtained with
+ * one LU solve, and the result is squared s times.
+ *
+ * @param a Square matrix.
+ * @throws std::invalid_argument if the matrix is not square.
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+Matrix<T> expm(const Matrix<T>& a) {
+    using namespace kernels;
+    if (a.getRows() != a.getCols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    const size_t n = a.getRows();
+    if (n == 0) {
+        return Matrix<T>(0, 0);
+    }
+
+    std::vector<T> x = toBuffer(a);
+    const double norm = static_cast<double>(detail::norm1(n, x.data()));
+    size_t degree = 0;
+    while (degree + 1 < detail::kPadeDegrees.size() && norm > detail::kPadeTheta[degree]) {
+        ++degree;
+    }
+    const int m = detail::kPadeDegrees[degree];
+    int s = 0;
+    if (m == 13 && norm > detail::kPadeTheta.back()) {
+        s = static_cast<int>(std::ceil(std::log2(norm / detail::kPadeTheta.back())));
+        const T scale = std::ldexp(T(1), -s);
+        for (T& value : x) {
+            value *= scale;
+        }
+    }
+    const double* b = detail::padeCoefficients(m);
+    auto c = [&](int i) { return static_cast<T>(b[i]); };
+
+    std::vector<T> a2(n * n), a4(n * n), a6(n * n), u(n * n), v(n * n), w(n * n);
+    detail::multiply(n, x.data(), x.data(), a2.data());
+    if (m >= 5) {
+        detail::multiply(n, a2.data(), a2.data(), a4.data());
+    }
+    if (m >= 7) {
+        detail::multiply(n, a4.data(), a2.data(), a6.data());
+    }
+
+    // u holds the odd part A * w and v the even part of the numerator.
+    switch (m) {
+        case 3:
+            detail::combine<T, 1>(n, c(1), {a2.data()}, {c(3)}, w.data());
+            detail::combine<T, 1>(n, c(0), {a2.data()}, {c(2)}, v.data());
+            break;
+        case 5:
+            detail::combine<T, 2>(n, c(1), {a2.data(), a4.data()}, {c(3), c(5)}, w.data());
+            detail::combine<T, 2>(n, c(0), {a2.data(), a4.data()}, {c(2), c(4)}, v.data());
+            break;
+        case 7:
+            detail::combine<T, 3>(n, c(1), {a2.data(), a4.data(), a6.data()}, {c(3), c(5), c(7)}, w.data());
+            detail::combine<T, 3>(n, c(0), {a2.data(), a4.data(), a6.data()}, {c(2), c(4), c(6)}, v.data());
+            break;
+        case 9: {
+            std::vector<T> a8(n * n);
+            detail::multiply(n, a4.data(), a4.data(), a8.data());
+            detail::combine<T, 4>(n, c(1), {a2.data(), a4.data(), a6.data(), a8.data()},
+                                  {c(3), c(5), c(7), c(9)}, w.data());
+            detail::combine<T, 4>(n, c(0), {a2.data(), a4.data(), a6.data(), a8.data()},
+                                  {c(2), c(4), c(6), c(8)}, v.data());
+            break;
+        }
+        default: {
+            // Degree 13 needs only A^2, A^4 and A^6: the high terms are
+            // factored as A^6 * (b13 A^6 + b11 A^4 + b9 A^2) and so on.
+            std::vector<T> high(n * n);
+            detail::combine<T, 3>(n, T(0), {a2.data(), a4.data(), a6.data()}, {c(9), c(11), c(13)}, high.data());
+            detail::combine<T, 3>(n, c(1), {a2.data(), a4.data(), a6.data()}, {c(3), c(5), c(7)}, w.data());
+            detail::multiply(n, a6.data(), high.data(), w.data(), T(1));
+            detail::combine<T, 3>(n, T(0), {a2.data(), a4.data(), a6.data()}, {c(8), c(10), c(12)}, high.data());
+            detail::combine<T, 3>(n, c(0), {a2.data(), a4.data(), a6.data()}, {c(2), c(4), c(6)}, v.data());
+            detail::multiply(n, a6.data(), high.data(), v.data(), T(1));
+            break;
+        }
+    }
+    detail::multiply(n, x.data(), w.data(), u.data());
+
+    // p = v + u and q = v - u; solve q * r = p in place.
+    for (size_t i = 0; i < n * n; ++i) {
+        const T even = v[i];
+        v[i] = even + u[i];
+        u[i] = even - u[i];
+    }
+    LU<T>(fromBuffer(u.data(), n, n, n)).solveInPlace(v.data(), n, n);
+
+    for (int i = 0; i < s; ++i) {
+        detail::multiply(n, v.data(), v.data(), w.data());
+        v.swap(w);
+    }
+    return fromBuffer(v.data(), n, n, n);
+}
+
+#endif // LINALG_MATRIX_FUNCTIONS_H
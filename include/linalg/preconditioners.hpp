@@ -0,0 +1,253 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_PRECONDITIONERS_H
+#define LINALG_PRECONDITIONERS_H
+
+#include <algorithm>
+#include <concepts>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "../types/sparse_matrix.hpp"
+#include "../kernels/parallel.hpp"
+
+/**
+ * Preconditioners for the Krylov solvers.
+ *
+ * A preconditioner M approximates A and exposes apply(r, z), which writes
+ * z = M^-1 * r into a vector of the same size without allocating.
+ */
+
+/**
+ * @brief A type with apply(r, z) computing z = M^-1 * r.
+ */
+template<typename M, typename T>
+concept Preconditioner = requires(const M& m, const Vector<T>& r, Vector<T>& z) {
+    m.apply(r, z);
+};
+
+/**
+ * @class IdentityPreconditioner
+ * @brief No preconditioning, M = I.
+ */
+template<typename T>
+class IdentityPreconditioner final {
+public:
+    /**
+     * @brief z = r.
+     */
+    void apply(const Vector<T>& r, Vector<T>& z) const {
+        std::copy(r.begin(), r.end(), z.begin());
+    }
+};
+
+/**
+ * @class JacobiPreconditioner
+ * @brief Diagonal scaling, M = diag(A).
+ *
+ * Cheap and parallel; effective when A is diagonally dominant or its rows
+ * are badly scaled.
+ */
+template<typename T>
+class JacobiPreconditioner final {
+public:
+    /**
+     * @brief Takes the diagonal of a dense square matrix.
+     *
+     * @throws std::invalid_argument if the diagonal holds a zero.
+     */
+    explicit JacobiPreconditioner(const Matrix<T>& a) {
+        if (a.getRows() != a.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        inverse.resize(a.getRows());
+        for (size_t i = 0; i < inverse.size(); ++i) {
+            inverse[i] = a(i, i);
+        }
+        invert();
+    }
+
+    /**
+     * @brief Takes the diagonal of a sparse square matrix.
+     *
+     * @throws std::invalid_argument if the diagonal holds a zero.
+     */
+    explicit JacobiPreconditioner(const SparseMatrix<T>& a) {
+        if (a.getRows() != a.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        inverse.resize(a.getRows());
+        for (size_t i = 0; i < inverse.size(); ++i) {
+            inverse[i] = a.at(i, i);
+        }
+        invert();
+    }
+
+    /**
+     * @brief z = r / diag(A), elementwise.
+     */
+    void apply(const Vector<T>& r, Vector<T>& z) const {
+        if (r.size() != inverse.size() || z.size() != inverse.size()) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+        const T* pr = r.begin();
+        T* pz = z.begin();
+        kernels::forEachChunk(inverse.size(), pz, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                pz[i] = pr[i] * inverse[i];
+            }
+        });
+    }
+
+private:
+    std::vector<T> inverse; ///< Reciprocals of the diagonal.
+
+    void invert() {
+        for (T& value : inverse) {
+            if (value == T(0)) {
+                throw std::invalid_argument("Matrix has a zero on its diagonal.");
+            }
+            value = T(1) / value;
+        }
+    }
+};
+
+/**
+ * @class ILU0Preconditioner
+ * @brief Incomplete LU factorization with zero fill-in, M = L * U.
+ *
+ * L and U keep exactly the sparsity pattern of A (in CSR order), so the
+ * factorization costs about as much as a few products with A, and
+ * apply() is one forward and one backward substitution over the
+ * nonzeros.
+ */
+template<typename T>
+class ILU0Preconditioner final {
+public:
+    /**
+     * @brief Factors a sparse square matrix; CSC input is converted to CSR.
+     *
+     * @throws std::invalid_argument if a diagonal entry is missing or a pivot vanishes.
+     */
+    explicit ILU0Preconditioner(const SparseMatrix<T>& a) {
+        if (a.getRows() != a.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        const SparseMatrix<T> csr = a.getFormat() == SparseFormat::CSR ? a : a.toCSR();
+        n = csr.getRows();
+        offsets = csr.getOffsets();
+        indices = csr.getIndices();
+        values = csr.getValues();
+        factor();
+    }
+
+    /**
+     * @brief Factors the nonzeros of a dense square matrix.
+     */
+    explicit ILU0Preconditioner(const Matrix<T>& a) : ILU0Preconditioner(SparseMatrix<T>::fromDense(a)) {}
+
+    /**
+     * @brief z = U^-1 * L^-1 * r.
+     */
+    void apply(const Vector<T>& r, Vector<T>& z) const {
+        if (r.size() != n || z.size() != n) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+        const T* pr = r.begin();
+        T* pz = z.begin();
+        for (size_t i = 0; i < n; ++i) {
+            T sum = pr[i];
+            for (size_t p = offsets[i]; p < diagonal[i]; ++p) {
+                sum -= values[p] * pz[indices[p]];
+            }
+            pz[i] = sum;
+        }
+        for (size_t i = n; i-- > 0;) {
+            T sum = pz[i];
+            for (size_t p = diagonal[i] + 1; p < offsets[i + 1]; ++p) {
+                sum -= values[p] * pz[indices[p]];
+            }
+            pz[i] = sum / values[diagonal[i]];
+        }
+    }
+
+private:
+    size_t n = 0;
+    std::vector<size_t> offsets;  ///< CSR row starts.
+    std::vector<size_t> indices;  ///< CSR column indices, sorted within each row.
+    std::vector<T> values;        ///< L below the diagonal (unit diagonal implied), U on and above it.
+    std::vector<size_t> diagonal; ///< Position of the diagonal entry of every row.
+
+    /**
+     * @brief IKJ elimination restricted to the pattern of A.
+     */
+    void factor() {
+        diagonal.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            const auto first = indices.begin() + offsets[i];
+            const auto last = indices.begin() + offsets[i + 1];
+            const auto it = std::lower_bound(first, last, i);
+            if (it == last || *it != i) {
+                throw std::invalid_argument("Matrix has a zero on its diagonal.");
+            }
+            diagonal[i] = it - indices.begin();
+        }
+        // position[j] is the index of (i, j) in the current row, or npos.
+        constexpr size_t npos = static_cast<size_t>(-1);
+        std::vector<size_t> position(n, npos);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+                position[indices[p]] = p;
+            }
+            for (size_t p = offsets[i]; p < diagonal[i]; ++p) {
+                const size_t k = indices[p];
+                const T pivot = values[diagonal[k]];
+                if (pivot == T(0)) {
+                    throw std::invalid_argument("Matrix has a zero pivot.");
+                }
+                values[p] /= pivot;
+                for (size_t q = diagonal[k] + 1; q < offsets[k + 1]; ++q) {
+                    const size_t j = position[indices[q]];
+                    if (j != npos) {
+                        values[j] -= values[p] * values[q];
+                    }
+                }
+            }
+            for (size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+                position[indices[p]] = npos;
+            }
+            if (values[diagonal[i]] == T(0)) {
+                throw std::invalid_argument("Matrix has a zero pivot.");
+            }
+        }
+    }
+};
+
+#endif // LINALG_PRECONDITIONERS_H
@@ -0,0 +1,376 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_QR_H
+#define LINALG_QR_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "common.hpp"
+
+/**
+ * @class QR
+ * @brief Householder QR factorization of a tall matrix, A = Q * R.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * Reflectors are generated one panel of kernels::kBlockSize columns at a
+ * time and accumulated in compact WY form, H = I - V * T * V^T, so both the
+ * trailing update and every later application of Q run through gemm.
+ * The factorization is kept for least-squares solves with any number of
+ * right-hand sides.
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class QR final {
+public:
+    /**
+     * @brief Factors a matrix with at least as many rows as columns.
+     *
+     * @param matrix The matrix to factor.
+     * @throws std::invalid_argument if the matrix has fewer rows than columns.
+     */
+    explicit QR(const Matrix<T>& matrix)
+        : m(matrix.getRows()), n(matrix.getCols()), a(kernels::toBuffer(matrix)), tau(n) {
+        if (m < n) {
+            throw std::invalid_argument("QR requires at least as many rows as columns.");
+        }
+        factor();
+    }
+
+    /**
+     * @brief Returns the number of rows of the factored matrix.
+     */
+    size_t getRows() const {
+        return m;
+    }
+
+    /**
+     * @brief Returns the number of columns of the factored matrix.
+     */
+    size_t getCols() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns the x minimizing ||A * x - b||.
+     */
+    Vector<T> solve(const Vector<T>& b) const {
+        if (b.size() != m) {
+            throw std::invalid_argument("Right-hand side size does not match the matrix.");
+        }
+        std::vector<T> x(b.begin(), b.end());
+        solveInPlace(x.data(), 1, 1);
+        Vector<T> result(n);
+        std::copy(x.begin(), x.begin() + n, result.mutableData());
+        return result;
+    }
+
+    /**
+     * @brief Solves the least-squares problem for all columns of B at once.
+     */
+    Matrix<T> solve(const Matrix<T>& b) const {
+        if (static_cast<size_t>(b.getRows()) != m) {
+            throw std::invalid_argument("Right-hand side rows do not match the matrix.");
+        }
+        const size_t nrhs = b.getCols();
+        std::vector<T> x = kernels::toBuffer(b);
+        solveInPlace(x.data(), nrhs, nrhs);
+        return kernels::fromBuffer(x.data(), n, nrhs, nrhs);
+    }
+
+    /**
+     * @brief Solves the least-squares problem in place.
+     *
+     * @param b Pointer to an m x nrhs row-major buffer; its first n rows are
+     *          overwritten with the solution.
+     * @param nrhs Number of columns of B.
+     * @param ldb Distance between consecutive rows of B.
+     * @throws std::invalid_argument if some |r_ii| is at most eps * max|r_jj| * max(m, n),
+     *         that is if the matrix is rank deficient to working precision.
+     */
+    void solveInPlace(T* b, size_t nrhs, size_t ldb) const {
+        using namespace kernels;
+        T largest = T(0);
+        for (size_t i = 0; i < n; ++i) {
+            largest = std::max(largest, std::abs(a[i * n + i]));
+        }
+        const T tolerance = std::numeric_limits<T>::epsilon() * largest * static_cast<T>(std::max(m, n));
+        for (size_t i = 0; i < n; ++i) {
+            if (std::abs(a[i * n + i]) <= tolerance) {
+                throw std::invalid_argument("Matrix is rank deficient.");
+            }
+        }
+        applyQt(b, nrhs, ldb);
+        trsm(Side::Left, Uplo::Upper, Op::NoTrans, Diag::NonUnit, n, nrhs, a.data(), n, b, ldb);
+    }
+
+    /**
+     * @brief Overwrites B with Q^T * B.
+     *
+     * @param b Pointer to an m x nrhs row-major buffer.
+     * @param nrhs Number of columns of B.
+     * @param ldb Distance between consecutive rows of B.
+     */
+    void applyQt(T* b, size_t nrhs, size_t ldb) const {
+        for (size_t k = 0, panel = 0; k < n; k += kernels::kBlockSize, ++panel) {
+            applyBlock(k, panel, b, nrhs, ldb, true);
+        }
+    }
+
+    /**
+     * @brief Overwrites B with Q * B.
+     *
+     * @param b Pointer to an m x nrhs row-major buffer.
+     * @param nrhs Number of columns of B.
+     * @param ldb Distance between consecutive rows of B.
+     */
+    void applyQ(T* b, size_t nrhs, size_t ldb) const {
+        for (size_t panel = tfactors.size(); panel-- > 0;) {
+            applyBlock(panel * kernels::kBlockSize, panel, b, nrhs, ldb, false);
+        }
+    }
+
+    /**
+     * @brief Returns the thin orthonormal factor Q (m x n).
+     */
+    Matrix<T> getQ() const {
+        std::vector<T> q(m * n, T(0));
+        for (size_t i = 0; i < n; ++i) {
+            q[i * n + i] = T(1);
+        }
+        applyQ(q.data(), n, n);
+        return kernels::fromBuffer(q.data(), m, n, n);
+    }
+
+    /**
+     * @brief Returns the upper triangular factor R (n x n).
+     */
+    Matrix<T> getR() const {
+        Matrix<T> r(n, n);
+        T* out = r.mutableData();
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(a.begin() + i * n + i, a.begin() + (i + 1) * n, out + i * n + i);
+        }
+        return r;
+    }
+
+private:
+    size_t m;                              ///< Number of rows.
+    size_t n;                              ///< Number of columns.
+    std::vector<T> a;                      ///< R above the diagonal, reflectors V below it.
+    std::vector<T> tau;                    ///< Scalar factors of the reflectors.
+    std::vector<std::vector<T>> tfactors;  ///< Upper triangular T of every panel.
+
+    /**
+     * @brief Applies the block reflector of one panel to B (from the left).
+     *
+     * V is split into its unit lower triangular top block V1 (handled with
+     * short loops) and the dense block V2 below it (handled with gemm).
+     */
+    void applyBlock(size_t k, size_t panel, T* b, size_t nrhs, size_t ldb, bool transpose) const {
+        using namespace kernels;
+        const size_t kb = std::min(kBlockSize, n - k);
+        const size_t below = m - k - kb;
+        const T* v = a.data() + k * n + k;
+        const T* t = tfactors[panel].data();
+        T* b1 = b + k * ldb;
+        T* b2 = b1 + kb * ldb;
+
+        // W = V^T * B
+        std::vector<T> w(kb * nrhs, T(0));
+        for (size_t i = 0; i < kb; ++i) {
+            T* wi = w.data() + i * nrhs;
+            for (size_t p = i; p < kb; ++p) {
+                const T f = p == i ? T(1) : v[p * n + i];
+                const T* bp = b1 + p * ldb;
+                for (size_t j = 0; j < nrhs; ++j) {
+                    wi[j] += f * bp[j];
+                }
+            }
+        }
+        gemm(Op::Trans, Op::NoTrans, kb, nrhs, below, T(1), v + kb * n, n, b2, ldb, T(1), w.data(), nrhs);
+
+        // W = T^T * W for H^T, W = T * W for H.
+        if (transpose) {
+            for (size_t i = kb; i-- > 0;) {
+                T* wi = w.data() + i * nrhs;
+                for (size_t j = 0; j < nrhs; ++j) {
+                    wi[j] *= t[i * kb + i];
+                }
+                for (size_t p = 0; p < i; ++p) {
+                    const T f = t[p * kb + i];
+                    const T* wp = w.data() + p * nrhs;
+                    for (size_t j = 0; j < nrhs; ++j) {
+                        wi[j] += f * wp[j];
+                    }
+                }
+            }
+        } else {
+            for (size_t i = 0; i < kb; ++i) {
+                T* wi = w.data() + i * nrhs;
+                for (size_t j = 0; j < nrhs; ++j) {
+                    wi[j] *= t[i * kb + i];
+                }
+                for (size_t p = i + 1; p < kb; ++p) {
+                    const T f = t[i * kb + p];
+                    const T* wp = w.data() + p * nrhs;
+                    for (size_t j = 0; j < nrhs; ++j) {
+                        wi[j] += f * wp[j];
+                    }
+                }
+            }
+        }
+
+        // B -= V * W
+        for (size_t i = 0; i < kb; ++i) {
+            T* bi = b1 + i * ldb;
+            for (size_t p = 0; p <= i; ++p) {
+                const T f = p == i ? T(1) : v[i * n + p];
+                const T* wp = w.data() + p * nrhs;
+                for (size_t j = 0; j < nrhs; ++j) {
+                    bi[j] -= f * wp[j];
+                }
+            }
+        }
+        gemm(Op::NoTrans, Op::NoTrans, below, nrhs, kb, T(-1), v + kb * n, n, w.data(), nrhs, T(1), b2, ldb);
+    }
+
+    void factor() {
+        T* data = a.data();
+        for (size_t k = 0; k < n; k += kernels::kBlockSize) {
+            const size_t kb = std::min(kernels::kBlockSize, n - k);
+            factorPanel(k, kb);
+            formT(k, kb);
+            if (k + kb < n) {
+                applyBlock(k, tfactors.size() - 1, data + k + kb, n - k - kb, n, true);
+            }
+        }
+    }
+
+    /**
+     * @brief Unblocked Householder QR of the panel a[k:m, k:k+kb].
+     */
+    void factorPanel(size_t k, size_t kb) {
+        T* data = a.data();
+        std::vector<T> w(kb);
+        for (size_t j = k; j < k + kb; ++j) {
+            // Generate the reflector that annihilates a[j+1:m, j].
+            T sumsq = T(0);
+            for (size_t i = j + 1; i < m; ++i) {
+                sumsq += data[i * n + j] * data[i * n + j];
+            }
+            const T norm = std::sqrt(sumsq);
+            const T alpha = data[j * n + j];
+            if (norm == T(0)) {
+                tau[j] = T(0);
+                continue;
+            }
+            const T beta = -std::copysign(std::hypot(alpha, norm), alpha);
+            tau[j] = (beta - alpha) / beta;
+            const T scale = T(1) / (alpha - beta);
+            for (size_t i = j + 1; i < m; ++i) {
+                data[i * n + j] *= scale;
+            }
+            data[j * n + j] = beta;
+
+            // Apply it to the rest of the panel.
+            const size_t c0 = j + 1, c1 = k + kb;
+            if (c0 == c1) {
+                continue;
+            }
+            std::copy(data + j * n + c0, data + j * n + c1, w.begin());
+            for (size_t i = j + 1; i < m; ++i) {
+                const T vi = data[i * n + j];
+                const T* ri = data + i * n;
+                for (size_t c = c0; c < c1; ++c) {
+                    w[c - c0] += vi * ri[c];
+                }
+            }
+            for (size_t c = c0; c < c1; ++c) {
+                w[c - c0] *= tau[j];
+                data[j * n + c] -= w[c - c0];
+            }
+            for (size_t i = j + 1; i < m; ++i) {
+                const T vi = data[i * n + j];
+                T* ri = data + i * n;
+                for (size_t c = c0; c < c1; ++c) {
+                    ri[c] -= vi * w[c - c0];
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Forms the upper triangular T of the panel starting at column k.
+     */
+    void formT(size_t k, size_t kb) {
+        const T* v = a.data() + k * n + k;
+        std::vector<T> t(kb * kb, T(0));
+        std::vector<T> z(kb);
+        for (size_t i = 0; i < kb; ++i) {
+            // z = V(:, 0:i)^T * v_i
+            std::fill(z.begin(), z.end(), T(0));
+            for (size_t p = 0; p < i; ++p) {
+                z[p] = v[i * n + p];
+            }
+            for (size_t r = i + 1; r < m - k; ++r) {
+                const T vr = v[r * n + i];
+                const T* row = v + r * n;
+                for (size_t p = 0; p < i; ++p) {
+                    z[p] += row[p] * vr;
+                }
+            }
+            // T(0:i, i) = -tau_i * T(0:i, 0:i) * z
+            for (size_t p = 0; p < i; ++p) {
+                T sum = T(0);
+                for (size_t q = p; q < i; ++q) {
+                    sum += t[p * kb + q] * z[q];
+                }
+                t[p * kb + i] = -tau[k + i] * sum;
+            }
+            t[i * kb + i] = tau[k + i];
+        }
+        tfactors.push_back(std::move(t));
+    }
+};
+
+/**
+ * @brief Returns the x minimizing ||A * x - b|| for a tall matrix A.
+ */
+template<typename T>
+Vector<T> leastSquares(const Matrix<T>& a, const Vector<T>& b) {
+    return QR<T>(a).solve(b);
+}
+
+#endif // LINALG_QR_H
@@ -0,0 +1,245 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_RANDOMIZED_SVD_H
+#define LINALG_RANDOMIZED_SVD_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "svd.hpp"
+
+/**
+ * @brief Parameters of the randomized range finder.
+ */
+struct RandomizedOptions {
+    size_t oversampling = 10;    ///< Extra sample columns beyond the rank.
+    size_t powerIterations = 2;  ///< Passes of (A * A^T) that sharpen a slowly decaying spectrum.
+    std::uint64_t seed = 0;      ///< Seed of the Gaussian test matrix.
+    bool computeError = true;    ///< Measure ||A - U * S * V^T||_F after the decomposition.
+};
+
+/**
+ * @class RandomizedSVD
+ * @brief Truncated SVD of rank k by randomized range finding, A ~ U * diag(s) * V^T.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * A is multiplied by an n x l Gaussian test matrix (l = k + oversampling),
+ * the sample is orthonormalized with QR, and optional power iterations
+ * alternate products with A^T and A, re-orthonormalizing after each one.
+ * The small l x n matrix B = Q^T * A is then decomposed exactly. Every
+ * product with A goes through the parallel gemm, so the whole
+ * decomposition costs O(m * n * l) instead of O(m * n * min(m, n)).
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class RandomizedSVD final {
+public:
+    /**
+     * @brief Computes the leading rank singular triplets of a matrix.
+     *
+     * @param matrix The matrix to approximate.
+     * @param rank Number of singular values to keep.
+     * @param options Sketch parameters.
+     * @throws std::invalid_argument if rank exceeds min(m, n).
+     */
+    RandomizedSVD(const Matrix<T>& matrix, size_t rank, const RandomizedOptions& options = {})
+        : m(matrix.getRows()), n(matrix.getCols()), k(rank) {
+        using namespace kernels;
+        if (rank > std::min(m, n)) {
+            throw std::invalid_argument("Rank exceeds the matrix dimensions.");
+        }
+        if (k == 0) {
+            return;
+        }
+        const size_t l = std::min(k + options.oversampling, std::min(m, n));
+        const T* a = matrix.begin();
+
+        Matrix<T> omega(n, l);
+        std::mt19937_64 gen(options.seed);
+        std::normal_distribution<T> dist;
+        for (T& value : omega) {
+            value = dist(gen);
+        }
+
+        // Q spans the range of A * Omega, refined by (A * A^T)^q.
+        Matrix<T> q(m, l);
+        gemm(Op::NoTrans, Op::NoTrans, m, l, n, T(1), a, n, omega.begin(), l, T(0), q.begin(), l);
+        orthonormalize(q);
+        Matrix<T> z(n, l);
+        for (size_t i = 0; i < options.powerIterations; ++i) {
+            gemm(Op::Trans, Op::NoTrans, n, l, m, T(1), a, n, q.begin(), l, T(0), z.begin(), l);
+            orthonormalize(z);
+            gemm(Op::NoTrans, Op::NoTrans, m, l, n, T(1), a, n, z.begin(), l, T(0), q.begin(), l);
+            orthonormalize(q);
+        }
+
+        // B = Q^T * A is small enough for the exact decomposition.
+        Matrix<T> b(l, n);
+        gemm(Op::Trans, Op::NoTrans, l, n, m, T(1), q.begin(), l, a, n, T(0), b.begin(), n);
+        const SVD<T> svd(b);
+        const Matrix<T> ub = svd.getU();
+        const Matrix<T> vb = svd.getV();
+        const Vector<T> sb = svd.getSingularValues();
+
+        s.assign(sb.begin(), sb.begin() + k);
+        u.resize(m * k);
+        gemm(Op::NoTrans, Op::NoTrans, m, k, l, T(1), q.begin(), l, ub.begin(), l, T(0), u.data(), k);
+        v.resize(n * k);
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(vb.begin() + i * l, vb.begin() + i * l + k, v.begin() + i * k);
+        }
+
+        if (options.computeError) {
+            measureError(a);
+        }
+    }
+
+    /**
+     * @brief Returns the rank of the approximation.
+     */
+    size_t getRank() const {
+        return k;
+    }
+
+    /**
+     * @brief Returns the leading singular values in descending order.
+     */
+    Vector<T> getSingularValues() const {
+        Vector<T> result(k);
+        std::copy(s.begin(), s.end(), result.mutableData());
+        return result;
+    }
+
+    /**
+     * @brief Returns the left singular vectors as the columns of an m x k matrix.
+     */
+    Matrix<T> getU() const {
+        return kernels::fromBuffer(u.data(), m, k, k);
+    }
+
+    /**
+     * @brief Returns the right singular vectors as the columns of an n x k matrix.
+     */
+    Matrix<T> getV() const {
+        return kernels::fromBuffer(v.data(), n, k, k);
+    }
+
+    /**
+     * @brief Returns the rank-k approximation U * diag(s) * V^T.
+     */
+    Matrix<T> reconstruct() const {
+        using namespace kernels;
+        Matrix<T> result(m, n);
+        const std::vector<T> sv = scaledVt();
+        gemm(Op::NoTrans, Op::NoTrans, m, n, k, T(1), u.data(), k, sv.data(), n, T(0), result.mutableData(), n);
+        return result;
+    }
+
+    /**
+     * @brief Returns ||A - U * diag(s) * V^T||_F.
+     *
+     * @throws std::logic_error if the error was not computed.
+     */
+    T getError() const {
+        checkError();
+        return error;
+    }
+
+    /**
+     * @brief Returns ||A - U * diag(s) * V^T||_F / ||A||_F.
+     *
+     * @throws std::logic_error if the error was not computed.
+     */
+    T getRelativeError() const {
+        checkError();
+        return norm == T(0) ? T(0) : error / norm;
+    }
+
+private:
+    size_t m;              ///< Number of rows.
+    size_t n;              ///< Number of columns.
+    size_t k;              ///< Rank of the approximation.
+    std::vector<T> s;      ///< Singular values, descending.
+    std::vector<T> u;      ///< U, row-major m x k.
+    std::vector<T> v;      ///< V, row-major n x k.
+    T error = T(-1);       ///< Frobenius norm of the residual; negative if not computed.
+    T norm = T(0);         ///< Frobenius norm of A.
+
+    static constexpr size_t kResidualRows = 256;
+
+    static void orthonormalize(Matrix<T>& y) {
+        y = QR<T>(y).getQ();
+    }
+
+    void checkError() const {
+        if (error < T(0)) {
+            throw std::logic_error("Approximation error was not computed.");
+        }
+    }
+
+    /**
+     * @brief diag(s) * V^T, row-major k x n.
+     */
+    std::vector<T> scaledVt() const {
+        std::vector<T> result(k * n);
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t c = 0; c < k; ++c) {
+                result[c * n + i] = s[c] * v[i * k + c];
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Forms the residual one block of rows at a time, so the error
+     * is exact without keeping an m x n copy of A.
+     */
+    void measureError(const T* a) {
+        using namespace kernels;
+        const std::vector<T> sv = scaledVt();
+        std::vector<T> block(std::min(m, kResidualRows) * n);
+        T sum = T(0);
+        for (size_t r = 0; r < m; r += kResidualRows) {
+            const size_t rows = std::min(kResidualRows, m - r);
+            std::copy(a + r * n, a + (r + rows) * n, block.begin());
+            gemm(Op::NoTrans, Op::NoTrans, rows, n, k, T(-1), u.data() + r * k, k, sv.data(), n, T(1), block.data(), n);
+            sum += dot(rows * n, block.data(), block.data());
+        }
+        error = std::sqrt(sum);
+        norm = std::sqrt(dot(m * n, a, a));
+    }
+};
+
+#endif // LINALG_RANDOMIZED_SVD_H
@@ -0,0 +1,351 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LINALG_SVD_H
+#define LINALG_SVD_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "qr.hpp"
+
+/**
+ * @class SVD
+ * @brief Thin singular value decomposition, A = U * diag(s) * V^T.
+ *
+ * @tparam T Floating-point element type.
+ *
+ * A wide matrix is decomposed through its transpose. The (tall) matrix
+ * is first reduced with the blocked QR, and the one-sided Jacobi method
+ * runs on the square factor R: columns are rotated in pairs until they
+ * are mutually orthogonal, and their norms are the singular values.
+ * Pairs follow a round-robin ordering, so every round rotates n / 2
+ * disjoint column pairs that run in parallel for large sizes. Columns
+ * are stored as contiguous rows, so every rotation is a pair of
+ * vectorized passes. U is recovered by applying Q to the normalized
+ * columns.
+ */
+template<typename T>
+    requires std::is_floating_point_v<T>
+class SVD final {
+public:
+    /**
+     * @brief Decomposes a matrix.
+     *
+     * @param matrix The matrix to decompose.
+     * @param computeVectors False to compute the singular values only.
+     * @throws std::runtime_error if the Jacobi sweeps do not converge.
+     */
+    explicit SVD(const Matrix<T>& matrix, bool computeVectors = true)
+        : m(matrix.getRows()), n(matrix.getCols()), k(std::min(m, n)), s(k) {
+        if (k == 0) {
+            return;
+        }
+        const bool wide = m < n;
+        const size_t rows = wide ? n : m;
+        Matrix<T> tall = matrix;
+        if (wide) {
+            tall = Matrix<T>(n, m);
+            T* out = tall.mutableData();
+            for (size_t i = 0; i < m; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    out[j * m + i] = matrix(i, j);
+                }
+            }
+        }
+        QR<T> qr(tall);
+        const Matrix<T> r = qr.getR();
+
+        // Columns of R are the rows of a; j accumulates the rotations.
+        std::vector<T> a(k * k);
+        for (size_t i = 0; i < k; ++i) {
+            for (size_t c = 0; c < k; ++c) {
+                a[c * k + i] = r(i, c);
+            }
+        }
+        std::vector<T> j;
+        if (computeVectors) {
+            j.assign(k * k, T(0));
+            for (size_t i = 0; i < k; ++i) {
+                j[i * k + i] = T(1);
+            }
+        }
+        orthogonalize(a, j);
+
+        for (size_t c = 0; c < k; ++c) {
+            s[c] = std::sqrt(kernels::dot(k, a.data() + c * k, a.data() + c * k));
+        }
+        std::vector<size_t> order(k);
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return s[x] > s[y]; });
+        std::vector<T> sorted(k);
+        for (size_t c = 0; c < k; ++c) {
+            sorted[c] = s[order[c]];
+        }
+        s.swap(sorted);
+        if (!computeVectors) {
+            return;
+        }
+
+        // Left vectors of R: normalized columns, completed where s = 0.
+        std::vector<T> ur(rows * k, T(0));
+        std::vector<T> vr(k * k);
+        for (size_t c = 0; c < k; ++c) {
+            const T* ac = a.data() + order[c] * k;
+            const T* jc = j.data() + order[c] * k;
+            for (size_t i = 0; i < k; ++i) {
+                ur[i * k + c] = s[c] > T(0) ? ac[i] / s[c] : T(0);
+                vr[i * k + c] = jc[i];
+            }
+        }
+        complete(ur);
+        qr.applyQ(ur.data(), k, k);
+
+        u = wide ? std::move(vr) : std::move(ur);
+        v = wide ? std::move(ur) : std::move(vr);
+    }
+
+    /**
+     * @brief Returns the number of rows of the decomposed matrix.
+     */
+    size_t getRows() const {
+        return m;
+    }
+
+    /**
+     * @brief Returns the number of columns of the decomposed matrix.
+     */
+    size_t getCols() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns the min(m, n) singular values in descending order.
+     */
+    Vector<T> getSingularValues() const {
+        Vector<T> result(k);
+        std::copy(s.begin(), s.end(), result.mutableData());
+        return result;
+    }
+
+    /**
+     * @brief Returns the left singular vectors as the columns of an m x min(m, n) matrix.
+     *
+     * @throws std::logic_error if the singular vectors were not computed.
+     */
+    Matrix<T> getU() const {
+        checkVectors();
+        return kernels::fromBuffer(u.data(), m, k, k);
+    }
+
+    /**
+     * @brief Returns the right singular vectors as the columns of an n x min(m, n) matrix.
+     *
+     * @throws std::logic_error if the singular vectors were not computed.
+     */
+    Matrix<T> getV() const {
+        checkVectors();
+        return kernels::fromBuffer(v.data(), n, k, k);
+    }
+
+    /**
+     * @brief Returns the numerical rank: singular values above max(m, n) * eps * s[0].
+     */
+    size_t rank() const {
+        if (k == 0) {
+            return 0;
+        }
+        const T tol = static_cast<T>(std::max(m, n)) * std::numeric_limits<T>::epsilon() * s[0];
+        return std::count_if(s.begin(), s.end(), [&](T value) { return value > tol; });
+    }
+
+    /**
+     * @brief Returns the 2-norm condition number s[0] / s[min(m, n) - 1].
+     */
+    T cond() const {
+        return k == 0 ? T(0) : s[0] / s[k - 1];
+    }
+
+private:
+    size_t m;          ///< Number of rows.
+    size_t n;          ///< Number of columns.
+    size_t k;          ///< min(m, n).
+    std::vector<T> s;  ///< Singular values, descending.
+    std::vector<T> u;  ///< U, row-major m x k; empty if not requested.
+    std::vector<T> v;  ///< V, row-major n x k; empty if not requested.
+
+    static constexpr size_t kMaxSweeps = 60;
+
+    void checkVectors() const {
+        if (u.empty() && k != 0) {
+            throw std::logic_error("Singular vectors were not computed.");
+        }
+    }
+
+    /**
+     * @brief One-sided Jacobi sweeps over the rows of a (k x k).
+     *
+     * A pair is rotated when its cosine exceeds sqrt(k) * eps; the
+     * iteration stops after the first sweep that rotates nothing. The
+     * squared column norms are carried through each rotation, so a pair
+     * costs one dot product and the rotation itself.
+     */
+    void orthogonalize(std::vector<T>& a, std::vector<T>& j) const {
+        using namespace kernels;
+        const T tol = std::sqrt(static_cast<T>(k)) * std::numeric_limits<T>::epsilon();
+        // Round-robin schedule; an odd count gets a dummy player.
+        const size_t players = k + (k & 1);
+        std::vector<size_t> seat(players);
+        std::iota(seat.begin(), seat.end(), size_t(0));
+        const size_t pairs = players / 2;
+        const bool vectors = !j.empty();
+        std::vector<T> norms(k);
+        std::atomic<bool> rotated;
+
+        auto rotatePairs = [&](size_t lo, size_t hi) {
+            bool any = false;
+            for (size_t t = lo; t < hi; ++t) {
+                const size_t p = std::min(seat[t], seat[players - 1 - t]);
+                const size_t q = std::max(seat[t], seat[players - 1 - t]);
+                if (q >= k) {
+                    continue;
+                }
+                T* ap = a.data() + p * k;
+                T* aq = a.data() + q * k;
+                const T alpha = norms[p];
+                const T beta = norms[q];
+                const T gamma = dot(k, ap, aq);
+                if (!(alpha > T(0)) || !(beta > T(0)) || std::abs(gamma) <= tol * std::sqrt(alpha) * std::sqrt(beta)) {
+                    continue;
+                }
+                any = true;
+                const T zeta = (beta - alpha) / (T(2) * gamma);
+                const T tan = std::copysign(T(1), zeta) / (std::abs(zeta) + std::hypot(T(1), zeta));
+                const T c = T(1) / std::hypot(T(1), tan);
+                const T sn = c * tan;
+                rotateRows(ap, aq, c, sn);
+                norms[p] = alpha - tan * gamma;
+                norms[q] = beta + tan * gamma;
+                if (vectors) {
+                    rotateRows(j.data() + p * k, j.data() + q * k, c, sn);
+                }
+            }
+            if (any) {
+                rotated.store(true, std::memory_order_relaxed);
+            }
+        };
+
+        const bool serial = k * k < kParallelFlops;
+        const size_t grain = std::max<size_t>(1, kStreamGrain / (8 * k));
+        for (size_t sweep = 0; sweep < kMaxSweeps; ++sweep) {
+            rotated.store(false, std::memory_order_relaxed);
+            // Updated norms drift, so every sweep starts from exact ones.
+            for (size_t c = 0; c < k; ++c) {
+                norms[c] = dot(k, a.data() + c * k, a.data() + c * k);
+            }
+            for (size_t round = 0; round + 1 < players; ++round) {
+                if (serial) {
+                    rotatePairs(0, pairs);
+                } else {
+                    parallel_for(0, pairs, grain, rotatePairs);
+                }
+                std::rotate(seat.begin() + 1, seat.end() - 1, seat.end());
+            }
+            if (!rotated.load(std::memory_order_relaxed)) {
+                return;
+            }
+        }
+        throw std::runtime_error("SVD iteration did not converge.");
+    }
+
+    /**
+     * @brief [x y] = [x y] * [[c, s], [-s, c]].
+     */
+    void rotateRows(T* x, T* y, T c, T sn) const {
+        for (size_t i = 0; i < k; ++i) {
+            const T xi = x[i];
+            x[i] = c * xi - sn * y[i];
+            y[i] = sn * xi + c * y[i];
+        }
+    }
+
+    /**
+     * @brief Replaces zero columns of the top k x k block of ur by an
+     * orthonormal completion (Gram-Schmidt on unit vectors, twice).
+     */
+    void complete(std::vector<T>& ur) const {
+        std::vector<T> x(k);
+        size_t candidate = 0;
+        for (size_t c = 0; c < k; ++c) {
+            if (s[c] > T(0)) {
+                continue;
+            }
+            while (candidate < k) {
+                std::fill(x.begin(), x.end(), T(0));
+                x[candidate++] = T(1);
+                for (int pass = 0; pass < 2; ++pass) {
+                    for (size_t other = 0; other < k; ++other) {
+                        if (other == c) {
+                            continue;
+                        }
+                        T proj = T(0);
+                        for (size_t i = 0; i < k; ++i) {
+                            proj += ur[i * k + other] * x[i];
+                        }
+                        for (size_t i = 0; i < k; ++i) {
+                            x[i] -= proj * ur[i * k + other];
+                        }
+                    }
+                }
+                const T norm = std::sqrt(kernels::dot(k, x.data(), x.data()));
+                if (norm > T(0.5)) {
+                    for (size_t i = 0; i < k; ++i) {
+                        ur[i * k + c] = x[i] / norm;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Returns the singular values of a matrix in descending order.
+ */
+template<typename T>
+Vector<T> singularValues(const Matrix<T>& a) {
+    return SVD<T>(a, false).getSingularValues();
+}
+
+#endif // LINALG_SVD_H
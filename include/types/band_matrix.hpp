@@ -0,0 +1,189 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BAND_MATRIX_H
+#define BAND_MATRIX_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "matrix.hpp"
+#include "../kernels/blas.hpp"
+
+/**
+ * @class BandMatrix
+ * @brief A square band matrix with kl subdiagonals and ku superdiagonals.
+ *
+ * @tparam T Type of the elements in the matrix.
+ *
+ * Each row keeps the kl + ku + 1 elements of the band in a fixed-width
+ * slot, so element (i, j) sits at i * (kl + ku + 1) + (j - i + kl). Slots
+ * that fall outside the matrix near the corners stay zero.
+ */
+template<typename T>
+class BandMatrix final {
+public:
+    /**
+     * @brief Default constructor.
+     */
+    BandMatrix() = default;
+
+    /**
+     * @brief Constructor for a zero band matrix.
+     *
+     * @param n Order of the matrix.
+     * @param kl Number of subdiagonals.
+     * @param ku Number of superdiagonals.
+     */
+    BandMatrix(size_t n, size_t kl, size_t ku) : n(n), kl(kl), ku(ku), data(n * (kl + ku + 1)) {}
+
+    /**
+     * @brief Packs the band of a dense square matrix; everything outside it is ignored.
+     */
+    static BandMatrix fromDense(const Matrix<T>& dense, size_t kl, size_t ku) {
+        if (dense.getRows() != dense.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        BandMatrix result(dense.getRows(), kl, ku);
+        for (size_t i = 0; i < result.n; ++i) {
+            const T* src = dense.getData()[i].begin();
+            std::copy(src + result.first(i), src + result.last(i), result.element(i, result.first(i)));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Expands the matrix into a dense one.
+     */
+    Matrix<T> toDense() const {
+        Matrix<T> dense(n, n);
+        T* out = dense.mutableData();
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(element(i, first(i)), element(i, last(i)), out + i * n + first(i));
+        }
+        return dense;
+    }
+
+    /**
+     * @brief Returns the order of the matrix.
+     */
+    size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns the number of subdiagonals.
+     */
+    size_t getLower() const {
+        return kl;
+    }
+
+    /**
+     * @brief Returns the number of superdiagonals.
+     */
+    size_t getUpper() const {
+        return ku;
+    }
+
+    /**
+     * @brief Returns element (i, j), zero outside the band.
+     */
+    T at(size_t i, size_t j) const {
+        if (i >= n || j >= n) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return j >= first(i) && j < last(i) ? *element(i, j) : T(0);
+    }
+
+    /**
+     * @brief Returns a reference to element (i, j) of the band.
+     *
+     * @throws std::out_of_range if (i, j) lies outside the band.
+     */
+    T& operator()(size_t i, size_t j) {
+        if (i >= n || j < first(i) || j >= last(i)) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return *element(i, j);
+    }
+
+    /**
+     * @brief Band matrix-vector product.
+     */
+    Vector<T> operator*(const Vector<T>& x) const {
+        if (x.size() != n) {
+            throw std::invalid_argument("Matrix and vector are not compatible for multiplication: size mismatch.");
+        }
+        Vector<T> y(n);
+        T* out = y.mutableData();
+        const size_t grain = std::max<size_t>(1, kernels::kStreamGrain / (kl + ku + 1));
+        kernels::parallel_for(0, n, grain, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                out[i] = kernels::dot(last(i) - first(i), element(i, first(i)), x.begin() + first(i));
+            }
+        });
+        return y;
+    }
+
+    /**
+     * @brief Returns a pointer to the band slot of element (i, j).
+     *
+     * Valid for first(i) <= j <= last(i); intended for kernels that walk a
+     * row of the band contiguously.
+     */
+    const T* element(size_t i, size_t j) const {
+        return data.data() + i * (kl + ku + 1) + (j + kl - i);
+    }
+
+    /**
+     * @brief First column of row i inside the band.
+     */
+    size_t first(size_t i) const {
+        return i > kl ? i - kl : 0;
+    }
+
+    /**
+     * @brief One past the last column of row i inside the band.
+     */
+    size_t last(size_t i) const {
+        return std::min(n, i + ku + 1);
+    }
+
+private:
+    size_t n = 0;
+    size_t kl = 0;
+    size_t ku = 0;
+    std::vector<T> data; ///< Rows of the band, kl + ku + 1 slots each.
+
+    T* element(size_t i, size_t j) {
+        return data.data() + i * (kl + ku + 1) + (j + kl - i);
+    }
+};
+
+#endif // BAND_MATRIX_H
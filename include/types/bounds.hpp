@@ -0,0 +1,80 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BOUNDS_H
+#define BOUNDS_H
+
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * @brief Element access policy that checks every index.
+ *
+ * Passed as the last template argument of Vector and Matrix; it decides
+ * whether operator[] and operator() throw std::out_of_range. unchecked()
+ * and the raw begin()/end() pointers never check, whatever the policy.
+ */
+struct Checked {
+    static constexpr bool kEnabled = true;
+};
+
+/**
+ * @brief Element access policy that checks indices only when NDEBUG is not defined.
+ */
+struct DebugChecked {
+#ifdef NDEBUG
+    static constexpr bool kEnabled = false;
+#else
+    static constexpr bool kEnabled = true;
+#endif
+};
+
+/**
+ * @brief Element access policy that never checks, so accesses are plain loads.
+ */
+struct Unchecked {
+    static constexpr bool kEnabled = false;
+};
+
+/**
+ * @brief Throws if the policy checks indices and index is not below size.
+ *
+ * @tparam Bounds Checked, DebugChecked or Unchecked.
+ * @throws std::out_of_range if the check is enabled and index >= size.
+ */
+template<typename Bounds>
+constexpr void checkIndex(size_t index, size_t size) {
+    if constexpr (Bounds::kEnabled) {
+        if (index >= size) {
+            throw std::out_of_range("Index out of range.");
+        }
+    }
+}
+
+#endif // BOUNDS_H
@@ -0,0 +1,251 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HALF_H
+#define HALF_H
+
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+
+/**
+ * @class Half
+ * @brief IEEE 754 binary16 number, stored in two bytes.
+ *
+ * A storage type: arithmetic converts both operands to float, so
+ * `a + b` is a float and is rounded back only when it is stored. Vectors
+ * and matrices of Half take half the memory of float ones, and their
+ * kernels convert whole blocks at a time and accumulate in float.
+ * Conversions round to nearest even and keep infinities, NaN and
+ * subnormals.
+ */
+class Half final {
+public:
+    /**
+     * @brief Default constructor; zero when value-initialized.
+     */
+    Half() = default;
+
+    /**
+     * @brief Converting constructor from any arithmetic type, rounding to nearest even.
+     */
+    template<typename U>
+        requires std::is_arithmetic_v<U>
+    constexpr Half(U value) : bits(encode(static_cast<float>(value))) {}
+
+    /**
+     * @brief Returns the number with the given bit pattern.
+     */
+    static constexpr Half fromBits(std::uint16_t bits) {
+        Half h;
+        h.bits = bits;
+        return h;
+    }
+
+    /**
+     * @brief Returns the bit pattern.
+     */
+    constexpr std::uint16_t toBits() const {
+        return bits;
+    }
+
+    /**
+     * @brief Converts to float exactly.
+     */
+    constexpr operator float() const {
+        return decode(bits);
+    }
+
+    constexpr Half& operator+=(float other) {
+        return *this = static_cast<float>(*this) + other;
+    }
+
+    constexpr Half& operator-=(float other) {
+        return *this = static_cast<float>(*this) - other;
+    }
+
+    constexpr Half& operator*=(float other) {
+        return *this = static_cast<float>(*this) * other;
+    }
+
+    constexpr Half& operator/=(float other) {
+        return *this = static_cast<float>(*this) / other;
+    }
+
+    /**
+     * @brief Rounds a float to the nearest binary16 bit pattern, ties to even.
+     */
+    static constexpr std::uint16_t encode(float value) {
+        std::uint32_t x = std::bit_cast<std::uint32_t>(value);
+        const std::uint32_t sign = x & 0x80000000u;
+        x ^= sign;
+        std::uint16_t h;
+        if (x >= 0x47800000u) {
+            // 2^16 and above, infinity or NaN
+            h = x > 0x7F800000u ? 0x7E00 : 0x7C00;
+        } else if (x < 0x38800000u) {
+            // Below 2^-14: adding 0.5f lets the FPU round the subnormal mantissa.
+            const float sum = std::bit_cast<float>(x) + 0.5f;
+            h = static_cast<std::uint16_t>(std::bit_cast<std::uint32_t>(sum) - 0x3F000000u);
+        } else {
+            const std::uint32_t odd = (x >> 13) & 1;
+            x += 0xC8000FFFu + odd; // rebias the exponent from 127 to 15, then round
+            h = static_cast<std::uint16_t>(x >> 13);
+        }
+        return static_cast<std::uint16_t>(h | (sign >> 16));
+    }
+
+    /**
+     * @brief Expands a binary16 bit pattern to float.
+     */
+    static constexpr float decode(std::uint16_t h) {
+        const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000) << 16;
+        const std::uint32_t exponent = (h >> 10) & 0x1F;
+        const std::uint32_t mantissa = h & 0x3FF;
+        if (exponent == 0) {
+            const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+            return sign ? -magnitude : magnitude;
+        }
+        if (exponent == 0x1F) {
+            return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+        }
+        return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, Half value) {
+        return os << static_cast<float>(value);
+    }
+
+    friend std::istream& operator>>(std::istream& is, Half& value) {
+        float f = 0;
+        is >> f;
+        value = f;
+        return is;
+    }
+
+private:
+    std::uint16_t bits;
+};
+
+/**
+ * @class BFloat16
+ * @brief Brain floating point number: the upper half of a float, stored in two bytes.
+ *
+ * Same range as float with an 8-bit significand, so widening is a
+ * shift and narrowing rounds the dropped half to nearest even. Like
+ * Half, it is a storage type that computes in float.
+ */
+class BFloat16 final {
+public:
+    /**
+     * @brief Default constructor; zero when value-initialized.
+     */
+    BFloat16() = default;
+
+    /**
+     * @brief Converting constructor from any arithmetic type, rounding to nearest even.
+     */
+    template<typename U>
+        requires std::is_arithmetic_v<U>
+    constexpr BFloat16(U value) : bits(encode(static_cast<float>(value))) {}
+
+    /**
+     * @brief Returns the number with the given bit pattern.
+     */
+    static constexpr BFloat16 fromBits(std::uint16_t bits) {
+        BFloat16 b;
+        b.bits = bits;
+        return b;
+    }
+
+    /**
+     * @brief Returns the bit pattern.
+     */
+    constexpr std::uint16_t toBits() const {
+        return bits;
+    }
+
+    /**
+     * @brief Converts to float exactly.
+     */
+    constexpr operator float() const {
+        return decode(bits);
+    }
+
+    constexpr BFloat16& operator+=(float other) {
+        return *this = static_cast<float>(*this) + other;
+    }
+
+    constexpr BFloat16& operator-=(float other) {
+        return *this = static_cast<float>(*this) - other;
+    }
+
+    constexpr BFloat16& operator*=(float other) {
+        return *this = static_cast<float>(*this) * other;
+    }
+
+    constexpr BFloat16& operator/=(float other) {
+        return *this = static_cast<float>(*this) / other;
+    }
+
+    /**
+     * @brief Rounds a float to the nearest bfloat16 bit pattern, ties to even; NaN stays quiet NaN.
+     */
+    static constexpr std::uint16_t encode(float value) {
+        const std::uint32_t x = std::bit_cast<std::uint32_t>(value);
+        if ((x & 0x7FFFFFFFu) > 0x7F800000u) {
+            return static_cast<std::uint16_t>((x >> 16) | 0x40);
+        }
+        return static_cast<std::uint16_t>((x + 0x7FFFu + ((x >> 16) & 1)) >> 16);
+    }
+
+    /**
+     * @brief Expands a bfloat16 bit pattern to float.
+     */
+    static constexpr float decode(std::uint16_t b) {
+        return std::bit_cast<float>(static_cast<std::uint32_t>(b) << 16);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, BFloat16 value) {
+        return os << static_cast<float>(value);
+    }
+
+    friend std::istream& operator>>(std::istream& is, BFloat16& value) {
+        float f = 0;
+        is >> f;
+        value = f;
+        return is;
+    }
+
+private:
+    std::uint16_t bits;
+};
+
+#endif // HALF_H
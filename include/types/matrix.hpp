@@ -30,20 +30,38 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 
+#include <algorithm>
 #include <istream>
 #include <vector>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 #include "vector.hpp" // Предполагается, что Vector<T> объявлен здесь
+#include "matrix_expression.hpp"
+#include "view.hpp"
+#include "../kernels/blas.hpp"
 
 /**
  * @brief Template class Matrix representing a matrix.
  *
  * @tparam T Type of the elements in the matrix.
+ * @tparam Bounds Whether operator[] and operator() check indices: Checked
+ *         (default), DebugChecked or Unchecked.
+ *
+ * Elements are stored contiguously in row-major order, so rows, columns,
+ * diagonals and blocks are handed out as views without copying, and the
+ * whole matrix can be passed to the kernels as one buffer.
+ *
+ * Copies share the elements until one of them is written through a
+ * non-const member, as for Vector. Sums, differences and scaling are
+ * lazy (see matrix_expression.hpp): a chain of them is evaluated in one
+ * pass when it is assigned, and the compound operators work in place.
  */
-template<typename T>
-class Matrix final {
+template<typename T, typename Bounds>
+class Matrix<T, Dynamic, Dynamic, Bounds> final {
 public:
+    using value_type = T;
+    using Accumulator = kernels::Widened<T>;
     /**
      * @brief Default constructor.
      */
@@ -54,28 +72,113 @@ public:
      *
      * @param rows Number of rows.
      * @param cols Number of columns.
+     * @param resource Where the elements are allocated, e.g. an arena; must outlive them.
      */
-    Matrix(int rows, int cols) : data(rows, Vector<T>(cols)) {}
+    Matrix(int rows, int cols, std::pmr::memory_resource* resource = kernels::defaultResource())
+        : rows(rows), cols(cols), data(static_cast<size_t>(rows) * cols, resource) {
+        if constexpr (std::is_trivially_default_constructible_v<T>) {
+            kernels::fill(data.size(), data.mutableData(), T(0));
+        }
+    }
 
     /**
      * @brief Constructor that takes a vector of vectors.
      *
      * @param vec Vector of vectors representing the rows of the matrix.
+     * @throws std::invalid_argument if the rows differ in size.
      */
-    explicit Matrix(const std::vector<Vector<T>>& vec) : data(vec) {}
+    explicit Matrix(const std::vector<Vector<T>>& vec)
+        : rows(vec.size()), cols(vec.empty() ? 0 : vec[0].size()), data(rows * cols) {
+        for (size_t i = 0; i < rows; ++i) {
+            if (vec[i].size() != cols) {
+                throw std::invalid_argument("Matrix rows must have the same size.");
+            }
+            std::copy(vec[i].begin(), vec[i].end(), data.mutableData() + i * cols);
+        }
+    }
+
+    /**
+     * @brief Copies the elements of a view into a new matrix.
+     *
+     * @param source Source view.
+     */
+    template<typename U>
+        requires std::is_same_v<std::remove_const_t<U>, T>
+    explicit Matrix(const MatrixView<U>& source)
+        : rows(source.getRows()), cols(source.getCols()), data(rows * cols) {
+        MatrixView<T>(data.mutableData(), rows, cols, cols) = source;
+    }
+
+    /**
+     * @brief Evaluates an elementwise matrix expression in one pass.
+     *
+     * @param e Expression such as `a + b * 2.0`.
+     */
+    template<typename E>
+    Matrix(const expr::MatrixNode<E>& e)
+        : rows(e.getRows()), cols(e.getCols()), data(static_cast<size_t>(e.getRows()) * e.getCols()) {
+        expr::evaluate(e.flat(), data.overwrite());
+    }
+
+    /**
+     * @brief Copy constructor, shares the elements until either matrix is written.
+     *
+     * Elements already handed out through a reference or a view are copied at once.
+     *
+     * @param other Another Matrix object to copy.
+     */
+    Matrix(const Matrix& other) : rows(other.rows), cols(other.cols), data(other.data) {}
 
     /**
      * @brief Move constructor.
      *
      * @param other Another Matrix object to move.
      */
-    Matrix(Matrix&& other) noexcept : data(std::move(other.data)) {}
+    Matrix(Matrix&& other) noexcept
+        : rows(std::exchange(other.rows, 0)), cols(std::exchange(other.cols, 0)), data(std::move(other.data)) {}
 
     /**
      * @brief Destructor.
      */
     ~Matrix() = default;
 
+    /**
+     * @brief Copy assignment, shares the elements of other.
+     */
+    Matrix& operator=(const Matrix& other) {
+        data = other.data;
+        rows = other.rows;
+        cols = other.cols;
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment, takes over the elements of other and leaves it empty.
+     */
+    Matrix& operator=(Matrix&& other) noexcept {
+        rows = std::exchange(other.rows, 0);
+        cols = std::exchange(other.cols, 0);
+        data = std::move(other.data);
+        return *this;
+    }
+
+    /**
+     * @brief Assigns an elementwise matrix expression, reusing the buffer when the shape matches.
+     *
+     * Operands may alias this matrix; shared elements are replaced, not copied.
+     */
+    template<typename E>
+    Matrix& operator=(const expr::MatrixNode<E>& e) {
+        const size_t size = static_cast<size_t>(e.getRows()) * e.getCols();
+        if (size != data.size()) {
+            data = SharedBuffer<T>(size);
+        }
+        rows = e.getRows();
+        cols = e.getCols();
+        expr::evaluate(e.flat(), data.overwrite());
+        return *this;
+    }
+
     /**
      * @brief Prints the contents of the matrix.
      */
@@ -87,21 +190,28 @@ public:
      * @brief Returns the number of rows.
      */
     int getRows() const {
-        return data.size();
+        return static_cast<int>(rows);
     }
 
     /**
      * @brief Returns the number of columns.
      */
     int getCols() const {
-        return data.empty() ? 0 : data[0].size();
+        return static_cast<int>(cols);
+    }
+
+    /**
+     * @brief Returns the memory resource the elements were allocated from.
+     */
+    std::pmr::memory_resource* resource() const noexcept {
+        return data.resource();
     }
 
     /**
      * @brief Equality comparison operator.
      */
     bool operator==(const Matrix& other) const {
-        return data == other.data;
+        return rows == other.rows && cols == other.cols && std::equal(begin(), end(), other.begin());
     }
 
     /**
@@ -115,7 +225,18 @@ public:
      * @brief Less than comparison operator.
      */
     bool operator<(const Matrix& other) const {
-        return data < other.data; // Сравнение по строкам
+        // Сравнение по строкам
+        for (size_t i = 0; i < std::min(rows, other.rows); ++i) {
+            const auto a = (*this)[i];
+            const auto b = other[i];
+            if (std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end())) {
+                return true;
+            }
+            if (std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end())) {
+                return false;
+            }
+        }
+        return rows < other.rows;
     }
 
     /**
@@ -140,121 +261,283 @@ public:
     }
 
     /**
-     * @brief Addition operator.
+     * @brief Multiplication operator (GEMM).
      */
-    Matrix operator+(Matrix& other){
-        if (getRows() != other.getRows() || getCols() != other[0].size()) {
-            throw std::invalid_argument("Matrices are not compatible for addition: size mismatch.");
+    Matrix operator*(const Matrix& other) const {
+        // Check if the matrices can be multiplied
+        if (rows == 0 || cols != other.rows) {
+            throw std::invalid_argument("Matrices are not compatible for multiplication: size mismatch.");
         }
 
-        Matrix result;
-        for (size_t i = 0; i < data.size(); ++i) {
-            result.data.push_back(data[i] + other.data[i]);
-        }
+        Matrix result(getRows(), other.getCols());
+        kernels::gemm(kernels::Op::NoTrans, kernels::Op::NoTrans, rows, other.cols, cols,
+                      T(1), data.data(), cols, other.data.data(), other.cols, T(0), result.data.mutableData(), result.cols);
         return result;
     }
 
     /**
-     * @brief Subtraction operator.
+     * @brief Matrix-vector multiplication operator (GEMV).
+     *
+     * @param x Vector with getCols() elements.
+     * @return Vector with getRows() elements.
      */
-    Matrix operator-(const Matrix& other) const {
-        if (data.size() != other.data.size() || data[0].size() != other.data[0].size()) {
-            throw std::invalid_argument("Matrices are not compatible for subtraction: size mismatch.");
-        }
-
-        Matrix result;
-        for (size_t i = 0; i < data.size(); ++i) {
-            result.data.push_back(data[i] - other.data[i]);
+    Vector<T> operator*(const Vector<T>& x) const {
+        if (x.size() != cols) {
+            throw std::invalid_argument("Matrix and vector are not compatible for multiplication: size mismatch.");
         }
-        return result;
+        Vector<T> y(rows);
+        kernels::gemv(kernels::Op::NoTrans, rows, cols, T(1), rowPointer(), x.begin(), T(0), y.begin());
+        return y;
     }
 
     /**
-     * @brief Multiplication operator.
+     * @brief Vector-matrix multiplication operator, x^T * A (transposed GEMV).
+     *
+     * @param x Vector with getRows() elements.
+     * @param matrix The matrix.
+     * @return Vector with getCols() elements.
      */
-    Matrix operator*(Matrix& other) {
-        // Check if the matrices can be multiplied
-        if (data.empty() || data[0].size() != other.data.size()) {
-            throw std::invalid_argument("Matrices are not compatible for multiplication: size mismatch.");
+    friend Vector<T> operator*(const Vector<T>& x, const Matrix& matrix) {
+        if (x.size() != matrix.rows) {
+            throw std::invalid_argument("Vector and matrix are not compatible for multiplication: size mismatch.");
         }
-
-        // Create a result matrix with the appropriate size
-        Matrix result;
-        result.data.resize(data.size(), Vector<T>(other.data[0].size())); // Initialize result with zeros
-
-        for (size_t i = 0; i < data.size(); ++i) { // Loop through rows of the first matrix
-            for (size_t j = 0; j < other.data[0].size(); ++j) { // Loop through columns of the second matrix
-                T sum = 0;
-                for (size_t k = 0; k < data[0].size(); ++k) { // Loop through columns of the first matrix / rows of the second
-                    sum += data[i][k] * other.data[k][j]; // Calculate the sum for the result element
-                }
-                result.data[i][j] = sum; // Assign the computed value to the result matrix
-            }
-        }
-        return result;
+        Vector<T> y(matrix.cols);
+        kernels::gemv(kernels::Op::Trans, matrix.rows, matrix.cols, T(1), matrix.rowPointer(), x.begin(), T(0), y.begin());
+        return y;
     }
 
     /**
-     * @brief Division operator.
+     * @brief Adds a matrix or a matrix expression in place, in one pass.
+     *
+     * @throws std::invalid_argument if the shapes differ.
      */
-    Matrix operator/(const T& scalar) const {
-        Matrix result = *this; // Копируем текущую матрицу
-        for (auto& row : result.data) {
-            for (auto& element : row) {
-                element /= scalar; // Предполагается, что T поддерживает деление
-            }
-        }
-        return result;
+    template<expr::MatrixOperand M>
+    Matrix& operator+=(const M& other) {
+        checkShape(other, "Matrices are not compatible for addition: size mismatch.");
+        return update<expr::Add>(expr::flatOperand(other));
     }
 
     /**
-     * @brief Addition assignment operator.
+     * @brief Subtracts a matrix or a matrix expression in place, in one pass.
+     *
+     * @throws std::invalid_argument if the shapes differ.
      */
-    Matrix& operator+=(const Matrix& other) {
-        *this = *this + other;
-        return *this;
+    template<expr::MatrixOperand M>
+    Matrix& operator-=(const M& other) {
+        checkShape(other, "Matrices are not compatible for subtraction: size mismatch.");
+        return update<expr::Sub>(expr::flatOperand(other));
     }
 
     /**
-     * @brief Subtraction assignment operator.
+     * @brief Multiplication assignment operator.
      */
-    Matrix& operator-=(const Matrix& other) {
-        *this = *this - other;
+    Matrix& operator*=(const Matrix& other) {
+        *this = *this * other;
         return *this;
     }
 
     /**
-     * @brief Multiplication assignment operator.
+     * @brief Multiplies every element by a scalar in place.
      */
-    Matrix& operator*=(const Matrix& other) {
-        *this = *this * other;
-        return *this;
+    Matrix& operator*=(const T& scalar) {
+        return update<expr::Mul>(expr::Scalar<T>(scalar));
     }
 
     /**
-     * @brief Division assignment operator.
+     * @brief Divides every element by a scalar in place.
+     *
+     * @throws std::invalid_argument if the scalar is zero.
      */
     Matrix& operator/=(const T& scalar) {
-        *this = *this / scalar;
-        return *this;
+        return update<expr::Div>(expr::Scalar<T>(scalar));
     }
 
     /**
-     * @brief Subscript operator.
+     * @brief Sum of the elements.
      */
-    Vector<T>& operator[](size_t index){
-        if (index >= data.size()) {
-            throw std::out_of_range("Index out of range.");
-        }
-        return data[index];
+    Accumulator sum(kernels::Summation mode = kernels::Summation::Plain) const {
+        return kernels::sum(data.size(), data.data(), mode);
+    }
+
+    /**
+     * @brief Sum of the squared elements.
+     */
+    Accumulator squaredNorm(kernels::Summation mode = kernels::Summation::Plain) const {
+        return kernels::dot(data.size(), data.data(), data.data(), mode);
+    }
+
+    /**
+     * @brief Frobenius norm.
+     */
+    Accumulator frobeniusNorm(kernels::Summation mode = kernels::Summation::Plain) const
+        requires std::is_floating_point_v<Accumulator> {
+        return kernels::nrm2(data.size(), data.data(), mode);
+    }
+
+    /**
+     * @brief Subscript operator, returns a view of row index that checks by the same policy.
+     *
+     * @throws std::out_of_range if index >= getRows() and Bounds checks indices.
+     */
+    VectorView<T, Bounds> operator[](size_t index) {
+        checkIndex<Bounds>(index, rows);
+        return VectorView<T, Bounds>(data.leak() + index * cols, cols);
+    }
+
+    /**
+     * @brief Subscript operator, returns a read-only view of row index that checks by the same policy.
+     *
+     * @throws std::out_of_range if index >= getRows() and Bounds checks indices.
+     */
+    VectorView<const T, Bounds> operator[](size_t index) const {
+        checkIndex<Bounds>(index, rows);
+        return VectorView<const T, Bounds>(data.data() + index * cols, cols);
+    }
+
+    /**
+     * @brief Returns element (i, j).
+     *
+     * @throws std::out_of_range if i or j is out of range and Bounds checks indices.
+     */
+    T& operator()(size_t i, size_t j) {
+        checkIndex<Bounds>(i, rows);
+        checkIndex<Bounds>(j, cols);
+        return at(i, j);
+    }
+
+    /**
+     * @brief Returns a const reference to element (i, j).
+     *
+     * @throws std::out_of_range if i or j is out of range and Bounds checks indices.
+     */
+    const T& operator()(size_t i, size_t j) const {
+        checkIndex<Bounds>(i, rows);
+        checkIndex<Bounds>(j, cols);
+        return at(i, j);
+    }
+
+    /**
+     * @brief Element (i, j) without a bounds check, for inner loops.
+     */
+    T& unchecked(size_t i, size_t j) {
+        return at(i, j);
+    }
+
+    /**
+     * @brief Const element (i, j) without a bounds check, for inner loops.
+     */
+    const T& unchecked(size_t i, size_t j) const noexcept {
+        return at(i, j);
+    }
+
+    /**
+     * @brief Returns a view of column j, getCols() elements apart.
+     *
+     * @throws std::out_of_range if j >= getCols().
+     */
+    StridedView<T> col(size_t j) {
+        return view().col(j);
+    }
+
+    /**
+     * @brief Returns a read-only view of column j.
+     *
+     * @throws std::out_of_range if j >= getCols().
+     */
+    StridedView<const T> col(size_t j) const {
+        return view().col(j);
+    }
+
+    /**
+     * @brief Returns a view of the main diagonal.
+     */
+    StridedView<T> diagonal() {
+        return view().diagonal();
+    }
+
+    /**
+     * @brief Returns a read-only view of the main diagonal.
+     */
+    StridedView<const T> diagonal() const {
+        return view().diagonal();
+    }
+
+    /**
+     * @brief Returns a view of the rowCount x colCount block at (row, col).
+     *
+     * @throws std::out_of_range if the block does not fit.
+     */
+    MatrixView<T> block(size_t row, size_t col, size_t rowCount, size_t colCount) {
+        return view().block(row, col, rowCount, colCount);
+    }
+
+    /**
+     * @brief Returns a read-only view of the rowCount x colCount block at (row, col).
+     *
+     * @throws std::out_of_range if the block does not fit.
+     */
+    MatrixView<const T> block(size_t row, size_t col, size_t rowCount, size_t colCount) const {
+        return view().block(row, col, rowCount, colCount);
+    }
+
+    /**
+     * @brief Returns a view of the whole matrix.
+     */
+    MatrixView<T> view() {
+        return MatrixView<T>(data.leak(), rows, cols, cols);
+    }
+
+    /**
+     * @brief Returns a read-only view of the whole matrix.
+     */
+    MatrixView<const T> view() const {
+        return MatrixView<const T>(data.data(), rows, cols, cols);
     }
 
     /**
      * @brief Getter for the data member.
-     * @return Reference to the data vector.
+     * @return Read-only view of the elements, without copying them.
+     */
+    MatrixView<const T> getData() const {
+        return view();
+    }
+
+    /**
+     * @brief Returns a pointer to the first element in row-major order.
+     */
+    T* begin() {
+        return data.leak();
+    }
+
+    /**
+     * @brief Returns a pointer to the first element in row-major order.
+     */
+    const T* begin() const noexcept {
+        return data.data();
+    }
+
+    /**
+     * @brief Returns a pointer one past the last element.
      */
-    const std::vector<Vector<T>>& getData() const {
-        return data;
+    T* end() {
+        return begin() + data.size();
+    }
+
+    /**
+     * @brief Returns a pointer for filling the elements in row-major order.
+     *
+     * Unlike begin() this does not stop later copies from sharing the
+     * elements, so the pointer is only good until the matrix is next copied.
+     */
+    T* mutableData() {
+        return data.mutableData();
+    }
+
+    /**
+     * @brief Returns a pointer one past the last element.
+     */
+    const T* end() const noexcept {
+        return data.data() + data.size();
     }
 
     /**
@@ -262,8 +545,8 @@ public:
      * @return Reference to this Matrix.
      */
     Matrix& operator++() {
-        for (auto& row : data) {
-            ++row; // Предполагается, что Vector<T> поддерживает инкремент
+        for (auto& element : *this) {
+            ++element;
         }
         return *this;
     }
@@ -273,8 +556,8 @@ public:
      * @return Reference to this Matrix.
      */
     Matrix& operator--() {
-        for (auto& row : data) {
-            --row; // Предполагается, что Vector<T> поддерживает декремент
+        for (auto& element : *this) {
+            --element;
         }
         return *this;
     }
@@ -283,24 +566,464 @@ public:
      * @brief Stream extraction operator.
      */
     friend std::istream& operator>>(std::istream& is, Matrix& matrix) {
-        for (auto& row : matrix.data) {
-            is >> row; // Предполагается, что Vector<T> поддерживает ввод
+        for (auto& element : matrix) {
+            is >> element;
         }
         return is;
     }
 
+    /**
+     * @brief Stream insertion operator, one row per line.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const Matrix& matrix) {
+        for (size_t i = 0; i < matrix.rows; ++i) {
+            for (size_t j = 0; j < matrix.cols; ++j) {
+                os << (j ? " " : "") << matrix.at(i, j);
+            }
+            os << '\n';
+        }
+        return os;
+    }
+
+private:
+    size_t rows = 0;
+    size_t cols = 0;
+    SharedBuffer<T> data; ///< Elements in row-major order, placed by first touch.
+
+    T& at(size_t i, size_t j) {
+        return data.leak()[i * cols + j];
+    }
+
+    const T& at(size_t i, size_t j) const noexcept {
+        return data.data()[i * cols + j];
+    }
+
+    template<typename M>
+    void checkShape(const M& other, const char* message) const {
+        if (getRows() != other.getRows() || getCols() != other.getCols()) {
+            throw std::invalid_argument(message);
+        }
+    }
+
+    /**
+     * @brief this = this Op other elementwise; shared elements are replaced, not copied.
+     */
+    template<typename Op, typename E>
+    Matrix& update(const E& other) {
+        // Building the node checks divisors before anything is written.
+        const expr::Binary<Op, expr::Leaf<T>, E> e(expr::Leaf<T>(data.data(), data.size()), other);
+        expr::evaluate(e, data.overwrite());
+        return *this;
+    }
+
+    /**
+     * @brief Returns a callable mapping a row index to a pointer to that row.
+     */
+    auto rowPointer() const {
+        return [this](size_t i) { return data.data() + i * cols; };
+    }
+};
+
+/**
+ * @class Matrix
+ * @brief A matrix with R x C elements stored inline, row by row.
+ *
+ * @tparam T Type of the elements in the matrix.
+ * @tparam R Number of rows, fixed at compile time.
+ * @tparam C Number of columns, fixed at compile time.
+ *
+ * Meant for 2x2 to 4x4 transforms: no heap allocation, products and
+ * inverses are fully unrolled, and incompatible shapes do not compile.
+ * Every operation is constexpr.
+ */
+template<typename T, size_t R, size_t C, typename Bounds>
+class Matrix final {
+    static_assert(R != Dynamic && C != Dynamic, "Mixing fixed and dynamic extents is not supported.");
+
+    template<typename, size_t, size_t, typename>
+    friend class Matrix;
+
+public:
+    /**
+     * @brief Default constructor, all elements are zero.
+     */
+    constexpr Matrix() = default;
+
+    /**
+     * @brief Constructor from exactly R * C elements in row-major order.
+     */
+    template<typename... Args>
+        requires (sizeof...(Args) == R * C && (std::is_convertible_v<Args, T> && ...))
+    constexpr Matrix(Args... args) {
+        const T values[] = {static_cast<T>(args)...};
+        for (size_t i = 0; i < R; ++i) {
+            for (size_t j = 0; j < C; ++j) {
+                at(i, j) = values[i * C + j];
+            }
+        }
+    }
+
+    /**
+     * @brief Converting constructor from a dynamic matrix.
+     *
+     * @throws std::invalid_argument if the shapes differ.
+     */
+    explicit Matrix(const Matrix<T>& other) {
+        if (static_cast<size_t>(other.getRows()) != R || static_cast<size_t>(other.getCols()) != C) {
+            throw std::invalid_argument("Matrices must have the same size.");
+        }
+        for (size_t i = 0; i < R; ++i) {
+            std::copy(other.getData()[i].begin(), other.getData()[i].end(), data[i].begin());
+        }
+    }
+
+    /**
+     * @brief Builds a matrix whose element (i, j) is f(i, j).
+     */
+    template<typename F>
+    static constexpr Matrix generate(F&& f) {
+        Matrix result;
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ((result.at(I / C, I % C) = static_cast<T>(f(I / C, I % C))), ...);
+        }(std::make_index_sequence<R * C>{});
+        return result;
+    }
+
+    /**
+     * @brief Returns the identity matrix.
+     */
+    static constexpr Matrix identity() requires (R == C) {
+        return generate([](size_t i, size_t j) { return i == j ? T(1) : T(0); });
+    }
+
+    /**
+     * @brief Copies the elements into a dynamic matrix.
+     */
+    Matrix<T> toDynamic() const {
+        Matrix<T> result(R, C);
+        T* out = result.mutableData();
+        for (size_t i = 0; i < R; ++i) {
+            std::copy(data[i].begin(), data[i].end(), out + i * C);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    static constexpr int getRows() noexcept {
+        return R;
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    static constexpr int getCols() noexcept {
+        return C;
+    }
+
+    /**
+     * @brief Subscript operator, returns row index.
+     *
+     * @throws std::out_of_range if index >= R and Bounds checks indices.
+     */
+    constexpr Vector<T, C, Bounds>& operator[](size_t index) {
+        checkIndex<Bounds>(index, R);
+        return data[index];
+    }
+
+    /**
+     * @brief Const subscript operator, returns row index.
+     *
+     * @throws std::out_of_range if index >= R and Bounds checks indices.
+     */
+    constexpr const Vector<T, C, Bounds>& operator[](size_t index) const {
+        checkIndex<Bounds>(index, R);
+        return data[index];
+    }
+
+    /**
+     * @brief Returns element (i, j).
+     *
+     * @throws std::out_of_range if i or j is out of range and Bounds checks indices.
+     */
+    constexpr T& operator()(size_t i, size_t j) {
+        checkIndex<Bounds>(i, R);
+        checkIndex<Bounds>(j, C);
+        return at(i, j);
+    }
+
+    /**
+     * @brief Returns a const reference to element (i, j).
+     *
+     * @throws std::out_of_range if i or j is out of range and Bounds checks indices.
+     */
+    constexpr const T& operator()(size_t i, size_t j) const {
+        checkIndex<Bounds>(i, R);
+        checkIndex<Bounds>(j, C);
+        return at(i, j);
+    }
+
+    /**
+     * @brief Element (i, j) without a bounds check.
+     */
+    constexpr T& unchecked(size_t i, size_t j) noexcept {
+        return at(i, j);
+    }
+
+    /**
+     * @brief Const element (i, j) without a bounds check.
+     */
+    constexpr const T& unchecked(size_t i, size_t j) const noexcept {
+        return at(i, j);
+    }
+
+    /**
+     * @brief Equality comparison operator.
+     */
+    constexpr bool operator==(const Matrix& other) const {
+        for (size_t i = 0; i < R; ++i) {
+            if (data[i] != other.data[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Inequality comparison operator.
+     */
+    constexpr bool operator!=(const Matrix& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Addition operator.
+     */
+    constexpr Matrix operator+(const Matrix& other) const {
+        return generate([&](size_t i, size_t j) { return at(i, j) + other.at(i, j); });
+    }
+
+    /**
+     * @brief Subtraction operator.
+     */
+    constexpr Matrix operator-(const Matrix& other) const {
+        return generate([&](size_t i, size_t j) { return at(i, j) - other.at(i, j); });
+    }
+
+    /**
+     * @brief Unary minus.
+     */
+    constexpr Matrix operator-() const {
+        return generate([&](size_t i, size_t j) { return -at(i, j); });
+    }
+
+    /**
+     * @brief Multiplication by a scalar.
+     */
+    constexpr Matrix operator*(const T& scalar) const {
+        return generate([&](size_t i, size_t j) { return at(i, j) * scalar; });
+    }
+
+    /**
+     * @brief Multiplication of a scalar by a matrix.
+     */
+    friend constexpr Matrix operator*(const T& scalar, const Matrix& matrix) {
+        return matrix * scalar;
+    }
+
+    /**
+     * @brief Division by a scalar.
+     *
+     * @throws std::invalid_argument if scalar is zero.
+     */
+    constexpr Matrix operator/(const T& scalar) const {
+        if (scalar == T(0)) {
+            throw std::invalid_argument("Cannot divide by zero.");
+        }
+        return generate([&](size_t i, size_t j) { return at(i, j) / scalar; });
+    }
+
+    /**
+     * @brief Matrix product; the inner dimensions are checked at compile time.
+     */
+    template<size_t K>
+    constexpr Matrix<T, R, K, Bounds> operator*(const Matrix<T, C, K, Bounds>& other) const {
+        return Matrix<T, R, K, Bounds>::generate([&](size_t i, size_t j) {
+            return [&]<size_t... P>(std::index_sequence<P...>) {
+                return ((at(i, P) * other.at(P, j)) + ...);
+            }(std::make_index_sequence<C>{});
+        });
+    }
+
+    /**
+     * @brief Matrix-vector product.
+     */
+    constexpr Vector<T, R, Bounds> operator*(const Vector<T, C, Bounds>& x) const {
+        return Vector<T, R, Bounds>::generate([&](size_t i) { return data[i].dot(x); });
+    }
+
+    /**
+     * @brief Vector-matrix product, x^T * A.
+     */
+    friend constexpr Vector<T, C, Bounds> operator*(const Vector<T, R, Bounds>& x, const Matrix& matrix) {
+        return Vector<T, C, Bounds>::generate([&](size_t j) {
+            return [&]<size_t... P>(std::index_sequence<P...>) {
+                return ((x.template get<P>() * matrix.at(P, j)) + ...);
+            }(std::make_index_sequence<R>{});
+        });
+    }
+
+    /**
+     * @brief Addition assignment operator.
+     */
+    constexpr Matrix& operator+=(const Matrix& other) {
+        return *this = *this + other;
+    }
+
+    /**
+     * @brief Subtraction assignment operator.
+     */
+    constexpr Matrix& operator-=(const Matrix& other) {
+        return *this = *this - other;
+    }
+
+    /**
+     * @brief Multiplication assignment operator.
+     */
+    constexpr Matrix& operator*=(const Matrix& other) requires (R == C) {
+        return *this = *this * other;
+    }
+
+    /**
+     * @brief Division assignment operator.
+     */
+    constexpr Matrix& operator/=(const T& scalar) {
+        return *this = *this / scalar;
+    }
+
+    /**
+     * @brief Returns the transposed matrix.
+     */
+    constexpr Matrix<T, C, R, Bounds> transpose() const {
+        return Matrix<T, C, R, Bounds>::generate([&](size_t i, size_t j) { return at(j, i); });
+    }
+
+    /**
+     * @brief Returns the determinant, by closed-form cofactor expansion.
+     */
+    constexpr T det() const requires (R == C && R <= 4) {
+        if constexpr (R == 1) {
+            return at(0, 0);
+        } else if constexpr (R == 2) {
+            return at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
+        } else if constexpr (R == 3) {
+            return at(0, 0) * (at(1, 1) * at(2, 2) - at(1, 2) * at(2, 1))
+                 - at(0, 1) * (at(1, 0) * at(2, 2) - at(1, 2) * at(2, 0))
+                 + at(0, 2) * (at(1, 0) * at(2, 1) - at(1, 1) * at(2, 0));
+        } else {
+            const Minors m = minors();
+            return m.s[0] * m.c[5] - m.s[1] * m.c[4] + m.s[2] * m.c[3]
+                 + m.s[3] * m.c[2] - m.s[4] * m.c[1] + m.s[5] * m.c[0];
+        }
+    }
+
+    /**
+     * @brief Returns the inverse, from the adjugate divided by the determinant.
+     *
+     * @throws std::invalid_argument if the matrix is singular.
+     */
+    constexpr Matrix inverse() const requires (R == C && R <= 4 && std::is_floating_point_v<T>) {
+        const T d = det();
+        if (d == T(0)) {
+            throw std::invalid_argument("Matrix is singular.");
+        }
+        return adjugate() / d;
+    }
+
     /**
      * @brief Stream insertion operator.
      */
     friend std::ostream& operator<<(std::ostream& os, const Matrix& matrix) {
-        for (const auto& row : matrix.getData()) {
-            os << row << '\n'; // Предполагается, что Vector<T> перегружает оператор вывода
+        for (const auto& row : matrix.data) {
+            os << row << '\n';
         }
         return os;
     }
 
 private:
-    std::vector<Vector<T>> data; ///< Data storage for the matrix.
+    Vector<T, C, Bounds> data[R]{}; ///< Inline rows.
+
+    constexpr T& at(size_t i, size_t j) {
+        return data[i].begin()[j];
+    }
+
+    constexpr const T& at(size_t i, size_t j) const {
+        return data[i].begin()[j];
+    }
+
+    /**
+     * @brief 2x2 minors of the top (s) and bottom (c) row pairs of a 4x4 matrix.
+     */
+    struct Minors {
+        T s[6];
+        T c[6];
+    };
+
+    constexpr Minors minors() const requires (R == 4 && C == 4) {
+        const auto& a = *this;
+        return {{a.at(0, 0) * a.at(1, 1) - a.at(1, 0) * a.at(0, 1),
+                 a.at(0, 0) * a.at(1, 2) - a.at(1, 0) * a.at(0, 2),
+                 a.at(0, 0) * a.at(1, 3) - a.at(1, 0) * a.at(0, 3),
+                 a.at(0, 1) * a.at(1, 2) - a.at(1, 1) * a.at(0, 2),
+                 a.at(0, 1) * a.at(1, 3) - a.at(1, 1) * a.at(0, 3),
+                 a.at(0, 2) * a.at(1, 3) - a.at(1, 2) * a.at(0, 3)},
+                {a.at(2, 0) * a.at(3, 1) - a.at(3, 0) * a.at(2, 1),
+                 a.at(2, 0) * a.at(3, 2) - a.at(3, 0) * a.at(2, 2),
+                 a.at(2, 0) * a.at(3, 3) - a.at(3, 0) * a.at(2, 3),
+                 a.at(2, 1) * a.at(3, 2) - a.at(3, 1) * a.at(2, 2),
+                 a.at(2, 1) * a.at(3, 3) - a.at(3, 1) * a.at(2, 3),
+                 a.at(2, 2) * a.at(3, 3) - a.at(3, 2) * a.at(2, 3)}};
+    }
+
+    constexpr Matrix adjugate() const {
+        const auto& a = *this;
+        if constexpr (R == 1) {
+            return Matrix(T(1));
+        } else if constexpr (R == 2) {
+            return Matrix(a.at(1, 1), -a.at(0, 1), -a.at(1, 0), a.at(0, 0));
+        } else if constexpr (R == 3) {
+            return Matrix(a.at(1, 1) * a.at(2, 2) - a.at(1, 2) * a.at(2, 1),
+                          a.at(0, 2) * a.at(2, 1) - a.at(0, 1) * a.at(2, 2),
+                          a.at(0, 1) * a.at(1, 2) - a.at(0, 2) * a.at(1, 1),
+                          a.at(1, 2) * a.at(2, 0) - a.at(1, 0) * a.at(2, 2),
+                          a.at(0, 0) * a.at(2, 2) - a.at(0, 2) * a.at(2, 0),
+                          a.at(0, 2) * a.at(1, 0) - a.at(0, 0) * a.at(1, 2),
+                          a.at(1, 0) * a.at(2, 1) - a.at(1, 1) * a.at(2, 0),
+                          a.at(0, 1) * a.at(2, 0) - a.at(0, 0) * a.at(2, 1),
+                          a.at(0, 0) * a.at(1, 1) - a.at(0, 1) * a.at(1, 0));
+        } else {
+            const Minors m = minors();
+            const T* s = m.s;
+            const T* c = m.c;
+            return Matrix( a.at(1, 1) * c[5] - a.at(1, 2) * c[4] + a.at(1, 3) * c[3],
+                          -a.at(0, 1) * c[5] + a.at(0, 2) * c[4] - a.at(0, 3) * c[3],
+                           a.at(3, 1) * s[5] - a.at(3, 2) * s[4] + a.at(3, 3) * s[3],
+                          -a.at(2, 1) * s[5] + a.at(2, 2) * s[4] - a.at(2, 3) * s[3],
+                          -a.at(1, 0) * c[5] + a.at(1, 2) * c[2] - a.at(1, 3) * c[1],
+                           a.at(0, 0) * c[5] - a.at(0, 2) * c[2] + a.at(0, 3) * c[1],
+                          -a.at(3, 0) * s[5] + a.at(3, 2) * s[2] - a.at(3, 3) * s[1],
+                           a.at(2, 0) * s[5] - a.at(2, 2) * s[2] + a.at(2, 3) * s[1],
+                           a.at(1, 0) * c[4] - a.at(1, 1) * c[2] + a.at(1, 3) * c[0],
+                          -a.at(0, 0) * c[4] + a.at(0, 1) * c[2] - a.at(0, 3) * c[0],
+                           a.at(3, 0) * s[4] - a.at(3, 1) * s[2] + a.at(3, 3) * s[0],
+                          -a.at(2, 0) * s[4] + a.at(2, 1) * s[2] - a.at(2, 3) * s[0],
+                          -a.at(1, 0) * c[3] + a.at(1, 1) * c[1] - a.at(1, 2) * c[0],
+                           a.at(0, 0) * c[3] - a.at(0, 1) * c[1] + a.at(0, 2) * c[0],
+                          -a.at(3, 0) * s[3] + a.at(3, 1) * s[1] - a.at(3, 2) * s[0],
+                           a.at(2, 0) * s[3] - a.at(2, 1) * s[1] + a.at(2, 2) * s[0]);
+        }
+    }
 };
 
 #endif // MATRIX_H
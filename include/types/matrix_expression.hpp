@@ -0,0 +1,332 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MATRIX_EXPRESSION_H
+#define MATRIX_EXPRESSION_H
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../kernels/reduce.hpp"
+#include "vector_expression.hpp"
+
+/**
+ * @brief Matrix with R x C elements, or run-time extents when both are Dynamic.
+ *
+ * Bounds is the element access policy: Checked, DebugChecked or Unchecked.
+ */
+template<typename T, size_t R = Dynamic, size_t C = Dynamic, typename Bounds = Checked>
+class Matrix;
+
+/**
+ * Lazy elementwise matrix expressions.
+ *
+ * A dynamic Matrix stores its elements contiguously in row-major order, so
+ * an elementwise matrix expression is a flat vector expression (see
+ * vector_expression.hpp) plus a shape. `a + b * 2.0 - c` builds one
+ * MatrixNode; assigning it runs a single pass over the elements, split
+ * across the pool like a vector expression, and a reduction such as
+ * `(r - b).frobeniusNorm()` evaluates the node a tile at a time into a
+ * buffer that stays in L1 and reduces each tile before moving on, so the
+ * result matrix is never written.
+ */
+namespace expr {
+
+constexpr size_t kReduceTile = 1024; ///< Elements of a node evaluated per reduction step.
+
+/**
+ * @brief Sums term(e[i]) over a node chunk by chunk, evaluating kReduceTile elements at a time.
+ *
+ * Chunks are those of the array reductions, so the result does not depend
+ * on the number of threads.
+ */
+template<kernels::detail::Term term, kernels::Summation mode, typename E>
+kernels::Widened<typename E::value_type> reduceTiled(const E& e) {
+    using T = typename E::value_type;
+    using A = kernels::Widened<T>;
+    const auto chunk = [&](size_t lo, size_t hi) {
+        T tile[kReduceTile];
+        kernels::detail::Partial<A> total;
+        for (size_t t = lo; t < hi; t += kReduceTile) {
+            const size_t end = std::min(hi, t + kReduceTile);
+            evaluateRange(e, t, end, tile);
+            const kernels::detail::Partial<A> p = kernels::detail::sumChunk<term, mode>(end - t, tile, tile);
+            kernels::detail::add<mode>(total, A(p.sum - p.carry));
+        }
+        return A(total.sum - total.carry);
+    };
+    const size_t n = e.size();
+    if (n <= kernels::kReduceChunk) {
+        return chunk(0, n);
+    }
+    std::vector<A> partial((n + kernels::kReduceChunk - 1) / kernels::kReduceChunk);
+    kernels::chunked_for(n, kernels::kReduceChunk, n * sizeof(T), [&](size_t lo, size_t hi) {
+        partial[lo / kernels::kReduceChunk] = chunk(lo, hi);
+    });
+    kernels::detail::Partial<A> total;
+    for (const A& value : partial) {
+        kernels::detail::add<mode>(total, value);
+    }
+    return total.sum - total.carry;
+}
+
+/**
+ * @brief Sum of term(e[i]) with the summation mode chosen at run time.
+ */
+template<kernels::detail::Term term, typename E>
+kernels::Widened<typename E::value_type> reduce(const E& e, kernels::Summation mode) {
+    return mode == kernels::Summation::Plain ? reduceTiled<term, kernels::Summation::Plain>(e)
+                                             : reduceTiled<term, kernels::Summation::Compensated>(e);
+}
+
+/**
+ * @class MatrixNode
+ * @brief An unevaluated elementwise matrix expression.
+ *
+ * @tparam E Flat vector expression over the row-major elements.
+ */
+template<typename E>
+class MatrixNode final {
+public:
+    using value_type = typename E::value_type;
+    using Accumulator = kernels::Widened<value_type>;
+
+    MatrixNode(const E& e, size_t rows, size_t cols) : e(e), rows(rows), cols(cols) {}
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    int getRows() const {
+        return static_cast<int>(rows);
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    int getCols() const {
+        return static_cast<int>(cols);
+    }
+
+    /**
+     * @brief The expression over all elements in row-major order.
+     */
+    const E& flat() const noexcept {
+        return e;
+    }
+
+    /**
+     * @brief Computes element (i, j) alone.
+     */
+    value_type operator()(size_t i, size_t j) const {
+        return e[i * cols + j];
+    }
+
+    /**
+     * @brief Sum of the elements, in one tiled pass.
+     */
+    Accumulator sum(kernels::Summation mode = kernels::Summation::Plain) const {
+        return reduce<kernels::detail::Term::Value>(e, mode);
+    }
+
+    /**
+     * @brief Sum of the squared elements, in one tiled pass.
+     */
+    Accumulator squaredNorm(kernels::Summation mode = kernels::Summation::Plain) const {
+        return reduce<kernels::detail::Term::Square>(e, mode);
+    }
+
+    /**
+     * @brief Frobenius norm, in one tiled pass.
+     */
+    Accumulator frobeniusNorm(kernels::Summation mode = kernels::Summation::Plain) const
+        requires std::is_floating_point_v<Accumulator> {
+        return std::sqrt(squaredNorm(mode));
+    }
+
+private:
+    E e;
+    size_t rows;
+    size_t cols;
+};
+
+template<typename X>
+struct IsMatrix : std::false_type {};
+
+template<typename T, typename B>
+struct IsMatrix<::Matrix<T, Dynamic, Dynamic, B>> : std::true_type {};
+
+template<typename X>
+struct IsMatrixNode : std::false_type {};
+
+template<typename E>
+struct IsMatrixNode<MatrixNode<E>> : std::true_type {};
+
+/**
+ * @brief A dynamic matrix or a lazy matrix expression.
+ */
+template<typename X>
+concept MatrixOperand = IsMatrix<std::remove_cvref_t<X>>::value || IsMatrixNode<std::remove_cvref_t<X>>::value;
+
+template<typename T, typename B>
+Leaf<T> flatOperand(const ::Matrix<T, Dynamic, Dynamic, B>& m) {
+    return Leaf<T>(m.begin(), static_cast<size_t>(m.getRows()) * m.getCols());
+}
+
+template<typename E>
+const E& flatOperand(const MatrixNode<E>& m) {
+    return m.flat();
+}
+
+template<typename X>
+using FlatType = std::decay_t<decltype(flatOperand(std::declval<const X&>()))>;
+
+template<typename L, typename R>
+concept MatrixCompatible = MatrixOperand<L> && MatrixOperand<R> &&
+    std::same_as<typename FlatType<L>::value_type, typename FlatType<R>::value_type>;
+
+/**
+ * @brief A matrix operand and a scalar of a type convertible to its elements.
+ */
+template<typename M, typename S>
+concept MatrixBroadcast = MatrixOperand<M> && !MatrixOperand<S> && !Operand<std::remove_cvref_t<S>> &&
+    std::convertible_to<const S&, typename FlatType<M>::value_type>;
+
+/**
+ * @brief A non-const dynamic matrix passed as an rvalue, whose buffer can hold a result.
+ */
+template<typename X>
+concept ExpiringMatrix = !std::is_lvalue_reference_v<X> && !std::is_const_v<std::remove_reference_t<X>> &&
+    IsMatrix<std::remove_cvref_t<X>>::value;
+
+/**
+ * @throws std::invalid_argument if the shapes differ.
+ */
+template<typename Op, typename L, typename R>
+auto makeMatrix(const L& l, const R& r) {
+    if (l.getRows() != r.getRows() || l.getCols() != r.getCols()) {
+        throw std::invalid_argument(std::is_same_v<Op, Add>
+            ? "Matrices are not compatible for addition: size mismatch."
+            : "Matrices are not compatible for subtraction: size mismatch.");
+    }
+    using Node = Binary<Op, FlatType<L>, FlatType<R>>;
+    return MatrixNode<Node>(Node(flatOperand(l), flatOperand(r)), l.getRows(), l.getCols());
+}
+
+template<typename Op, typename M, typename S>
+auto scaleRight(const M& m, const S& s) {
+    using T = typename FlatType<M>::value_type;
+    using Node = Binary<Op, FlatType<M>, Scalar<T>>;
+    return MatrixNode<Node>(Node(flatOperand(m), Scalar<T>(s)), m.getRows(), m.getCols());
+}
+
+template<typename Op, typename S, typename M>
+auto scaleLeft(const S& s, const M& m) {
+    using T = typename FlatType<M>::value_type;
+    using Node = Binary<Op, Scalar<T>, FlatType<M>>;
+    return MatrixNode<Node>(Node(Scalar<T>(s), flatOperand(m)), m.getRows(), m.getCols());
+}
+
+/**
+ * @brief Returns node unevaluated, unless l or r is an expiring matrix.
+ *
+ * As for vectors (see result), the node is then evaluated into the
+ * expiring matrix's buffer, which is returned.
+ */
+template<typename L, typename R, typename N>
+auto matrixResult(L&& l, R&& r, const N& node) {
+    if constexpr (ExpiringMatrix<L>) {
+        l = node;
+        return std::remove_cvref_t<L>(std::move(l));
+    } else if constexpr (ExpiringMatrix<R>) {
+        r = node;
+        return std::remove_cvref_t<R>(std::move(r));
+    } else {
+        return node;
+    }
+}
+
+} // namespace expr
+
+/**
+ * @brief Elementwise matrix sum, evaluated lazily.
+ *
+ * @throws std::invalid_argument if the shapes differ.
+ */
+template<typename L, typename R>
+    requires expr::MatrixCompatible<L, R>
+auto operator+(L&& l, R&& r) {
+    return expr::matrixResult(std::forward<L>(l), std::forward<R>(r), expr::makeMatrix<expr::Add>(l, r));
+}
+
+/**
+ * @brief Elementwise matrix difference, evaluated lazily.
+ *
+ * @throws std::invalid_argument if the shapes differ.
+ */
+template<typename L, typename R>
+    requires expr::MatrixCompatible<L, R>
+auto operator-(L&& l, R&& r) {
+    return expr::matrixResult(std::forward<L>(l), std::forward<R>(r), expr::makeMatrix<expr::Sub>(l, r));
+}
+
+/**
+ * @brief Matrix times a scalar, evaluated lazily.
+ */
+template<typename M, typename S>
+    requires expr::MatrixBroadcast<M, S>
+auto operator*(M&& m, const S& s) {
+    return expr::matrixResult(std::forward<M>(m), s, expr::scaleRight<expr::Mul>(m, s));
+}
+
+/**
+ * @brief Scalar times a matrix, evaluated lazily.
+ */
+template<typename S, typename M>
+    requires expr::MatrixBroadcast<M, S>
+auto operator*(const S& s, M&& m) {
+    return expr::matrixResult(s, std::forward<M>(m), expr::scaleLeft<expr::Mul>(s, m));
+}
+
+/**
+ * @brief Matrix divided by a scalar, evaluated lazily.
+ *
+ * @throws std::invalid_argument if the scalar is zero.
+ */
+template<typename M, typename S>
+    requires expr::MatrixBroadcast<M, S>
+auto operator/(M&& m, const S& s) {
+    return expr::matrixResult(std::forward<M>(m), s, expr::scaleRight<expr::Div>(m, s));
+}
+
+#endif // MATRIX_EXPRESSION_H
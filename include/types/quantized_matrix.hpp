@@ -0,0 +1,272 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUANTIZED_MATRIX_H
+#define QUANTIZED_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "matrix.hpp"
+#include "../kernels/int8.hpp"
+
+/**
+ * @brief Direction along which a QuantizedMatrix shares one scale and zero point.
+ */
+enum class QuantAxis {
+    Row,   ///< One scale and zero point per row.
+    Column ///< One scale and zero point per column.
+};
+
+/**
+ * @brief How the range of each row or column is mapped onto int8.
+ */
+enum class QuantScheme {
+    Symmetric, ///< Zero point 0, scale max|x| / 127.
+    Asymmetric ///< [min, max] onto [-128, 127]; zero stays exact.
+};
+
+/**
+ * @class QuantizedMatrix
+ * @brief A matrix stored as int8 with a scale and zero point per row or column.
+ *
+ * @tparam T Real element type the matrix is quantized from and dequantized to.
+ *
+ * Element (i, j) stands for scale * (q - zeroPoint), where scale and
+ * zeroPoint belong to row i or column j depending on the axis. Each
+ * quantized row (or column) is stored contiguously, so a row-quantized
+ * left operand times a column-quantized right operand is exactly the
+ * int8 kernel's C = A * B^T layout and needs no repacking. The product
+ * accumulates in int32 and applies scales and zero points once per
+ * element of the result.
+ */
+template<typename T>
+class QuantizedMatrix final {
+public:
+    /**
+     * @brief Default constructor.
+     */
+    QuantizedMatrix() = default;
+
+    /**
+     * @brief Quantizes a matrix, one scale and zero point per row or column.
+     *
+     * @param source Matrix to quantize.
+     * @param axis Whether rows or columns share a scale.
+     * @param scheme Symmetric or asymmetric range.
+     */
+    static QuantizedMatrix quantize(const Matrix<T>& source, QuantAxis axis,
+                                    QuantScheme scheme = QuantScheme::Asymmetric) {
+        QuantizedMatrix q;
+        q.rows = source.getRows();
+        q.cols = source.getCols();
+        q.axis = axis;
+        q.data.resize(q.rows * q.cols);
+        q.scales.resize(q.count());
+        q.zeroPoints.resize(q.count());
+        q.sums.resize(q.count());
+        const size_t length = q.length();
+        std::vector<T> values(length);
+        for (size_t v = 0; v < q.count(); ++v) {
+            for (size_t p = 0; p < length; ++p) {
+                values[p] = axis == QuantAxis::Row ? source(v, p) : source(p, v);
+            }
+            q.quantizeVector(v, values, scheme);
+        }
+        return q;
+    }
+
+    /**
+     * @brief Expands the matrix back to real values.
+     */
+    Matrix<T> dequantize() const {
+        Matrix<T> result(getRows(), getCols());
+        T* out = result.mutableData();
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t j = 0; j < cols; ++j) {
+                const size_t v = axis == QuantAxis::Row ? i : j;
+                out[i * cols + j] = scales[v] * static_cast<T>(at(i, j) - zeroPoints[v]);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    int getRows() const {
+        return static_cast<int>(rows);
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    int getCols() const {
+        return static_cast<int>(cols);
+    }
+
+    /**
+     * @brief Returns whether rows or columns share a scale.
+     */
+    QuantAxis getAxis() const {
+        return axis;
+    }
+
+    /**
+     * @brief Returns the scale of row or column index.
+     *
+     * @throws std::out_of_range if there is no such row or column.
+     */
+    T scale(size_t index) const {
+        checkIndex<Checked>(index, count());
+        return scales[index];
+    }
+
+    /**
+     * @brief Returns the zero point of row or column index.
+     *
+     * @throws std::out_of_range if there is no such row or column.
+     */
+    std::int32_t zeroPoint(size_t index) const {
+        checkIndex<Checked>(index, count());
+        return zeroPoints[index];
+    }
+
+    /**
+     * @brief Returns the quantized value of element (i, j).
+     *
+     * @throws std::out_of_range if i or j is out of range.
+     */
+    std::int8_t operator()(size_t i, size_t j) const {
+        checkIndex<Checked>(i, rows);
+        checkIndex<Checked>(j, cols);
+        return at(i, j);
+    }
+
+    /**
+     * @brief Quantized product, accumulated in int32 and returned in real values.
+     *
+     * @param a Row-quantized left operand.
+     * @param b Column-quantized right operand.
+     * @throws std::invalid_argument if the axes are not row and column, the sizes do not match,
+     *         or the shared dimension is kernels::kInt8MaxDepth or more, where int32 sums can overflow.
+     */
+    friend Matrix<T> operator*(const QuantizedMatrix& a, const QuantizedMatrix& b) {
+        if (a.axis != QuantAxis::Row || b.axis != QuantAxis::Column) {
+            throw std::invalid_argument("Quantized product needs a row-quantized left and a column-quantized right operand.");
+        }
+        if (a.cols != b.rows) {
+            throw std::invalid_argument("Matrices are not compatible for multiplication: size mismatch.");
+        }
+        if (a.cols >= kernels::kInt8MaxDepth) {
+            throw std::invalid_argument("Quantized product is too deep for exact int32 accumulation.");
+        }
+        const size_t m = a.rows;
+        const size_t n = b.cols;
+        const std::int64_t k = static_cast<std::int64_t>(a.cols);
+        std::vector<std::int32_t> products(m * n);
+        kernels::gemmInt8(m, n, a.cols, a.data.data(), a.cols, b.data.data(), b.rows, products.data(), n);
+
+        // sum (qa - za)(qb - zb) = sum qa qb - zb sum qa - za sum qb + k za zb
+        Matrix<T> result(a.getRows(), b.getCols());
+        T* out = result.mutableData();
+        for (size_t i = 0; i < m; ++i) {
+            const std::int64_t za = a.zeroPoints[i];
+            for (size_t j = 0; j < n; ++j) {
+                const std::int64_t zb = b.zeroPoints[j];
+                const std::int64_t exact = products[i * n + j] - zb * a.sums[i] - za * b.sums[j] + k * za * zb;
+                out[i * n + j] = a.scales[i] * b.scales[j] * static_cast<T>(exact);
+            }
+        }
+        return result;
+    }
+
+private:
+    size_t rows = 0;
+    size_t cols = 0;
+    QuantAxis axis = QuantAxis::Row;
+    std::vector<std::int8_t> data;        ///< Row-major for QuantAxis::Row, column-major for QuantAxis::Column.
+    std::vector<T> scales;                ///< One per row or column.
+    std::vector<std::int32_t> zeroPoints; ///< One per row or column.
+    std::vector<std::int32_t> sums;       ///< Sum of the quantized values of each row or column.
+
+    /**
+     * @brief Number of rows or columns that have their own scale.
+     */
+    size_t count() const {
+        return axis == QuantAxis::Row ? rows : cols;
+    }
+
+    /**
+     * @brief Number of elements that share one scale.
+     */
+    size_t length() const {
+        return axis == QuantAxis::Row ? cols : rows;
+    }
+
+    std::int8_t at(size_t i, size_t j) const {
+        return axis == QuantAxis::Row ? data[i * cols + j] : data[j * rows + i];
+    }
+
+    void quantizeVector(size_t v, const std::vector<T>& values, QuantScheme scheme) {
+        T lo = T(0);
+        T hi = T(0);
+        for (const T& x : values) {
+            lo = std::min(lo, x);
+            hi = std::max(hi, x);
+        }
+        T s;
+        std::int32_t zero = 0;
+        if (scheme == QuantScheme::Symmetric) {
+            s = std::max(-lo, hi) / T(127);
+        } else {
+            s = (hi - lo) / T(255);
+            if (s > T(0)) {
+                zero = std::clamp(static_cast<std::int32_t>(std::lround(T(-128) - lo / s)), -128, 127);
+            }
+        }
+        if (!(s > T(0))) {
+            s = T(1); // all zeros
+        }
+        std::int8_t* out = data.data() + v * values.size();
+        std::int32_t sum = 0;
+        for (size_t p = 0; p < values.size(); ++p) {
+            const std::int32_t q = std::clamp(static_cast<std::int32_t>(std::lround(values[p] / s)) + zero, -128, 127);
+            out[p] = static_cast<std::int8_t>(q);
+            sum += q;
+        }
+        scales[v] = s;
+        zeroPoints[v] = zero;
+        sums[v] = sum;
+    }
+};
+
+#endif // QUANTIZED_MATRIX_H
@@ -68,45 +68,33 @@ public:
      *
      * @param other The Rational object to copy from.
      */
-    Rational(const Rational& other) : numerator(other.numerator), denominator(other.denominator) {}
+    Rational(const Rational& other) = default;
 
     /**
-     * @brief Move constructor.
+     * @brief Move constructor, a plain copy that leaves other unchanged.
      *
      * @param other The Rational object to move from.
      */
-    Rational(Rational&& other) noexcept : numerator(other.numerator), denominator(other.denominator) {
-        other.numerator = 0;
-        other.denominator = 1;
-    }
+    Rational(Rational&& other) noexcept = default;
 
     /**
      * @brief Assignment operator.
      * @param other The Rational object to copy from.
      * @return Reference to the assigned Rational object.
      */
-    Rational& operator=(const Rational& other) {
-        if (this != &other) {
-            numerator = other.numerator;
-            denominator = other.denominator;
-        }
-        return *this;
-    }
+    Rational& operator=(const Rational& other) = default;
 
     /**
      * @brief Move assignment operator.
      * @param other The Rational object to move from.
      * @return Reference to the assigned Rational object.
      */
-    Rational& operator=(Rational&& other) noexcept {
-        if (this != &other) {
-            numerator = other.numerator;
-            denominator = other.denominator;
-            other.numerator = 0;
-            other.denominator = 1;
-        }
-        return *this;
-    }
+    Rational& operator=(Rational&& other) noexcept = default;
+
+    /**
+     * @brief Destructor.
+     */
+    ~Rational() = default;
 
     /**
      * @brief Get the numerator of the rational number.
@@ -0,0 +1,292 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SHARED_BUFFER_H
+#define SHARED_BUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include "../kernels/memory.hpp"
+
+/**
+ * @class SharedBuffer
+ * @brief Reference-counted, copy-on-write array of T.
+ *
+ * @tparam T Type of the elements.
+ *
+ * The count and the size live in one heap block in front of the elements,
+ * so copying a buffer is a single relaxed increment and the elements are
+ * shared until somebody asks for write access. Writers go through
+ * mutableData(), which copies only when the block is shared, or through
+ * overwrite(), which swaps in a fresh block without copying when the old
+ * contents are about to be replaced anyway.
+ *
+ * A pointer from mutableData() is only good until the buffer is next
+ * copied. Owners that hand element references or views to their callers
+ * take them from leak() instead, which marks this buffer object as leaked:
+ * while it stays marked every copy of it gets its own elements, so a write
+ * through a reference kept from before the copy cannot show up in the copy.
+ * The mark belongs to the buffer object, not to the elements: a buffer
+ * that receives elements by assignment or by move starts unmarked, so
+ * references taken through a moved-from owner are no longer tracked. A
+ * marked buffer is never shared, so overwrite() writes in place and keeps
+ * the mark.
+ *
+ * While the buffer has a single owner no read-modify-write is issued at
+ * all: write access and destruction only load the count, and leak() on a
+ * buffer already marked loads the pointer it kept and nothing else.
+ * Distinct buffers sharing a block may be used from different threads, as
+ * with std::shared_ptr; one buffer object must not be written
+ * concurrently, and the first leak() counts as a write.
+ *
+ * Trivial elements are left uninitialized on allocation, so the kernel
+ * that first writes them also places the pages. The block comes from a
+ * std::pmr::memory_resource, kernels::defaultResource() unless given, and
+ * the elements start on a kernels::kBufferAlignment boundary. Copies made
+ * on write are allocated from the same resource as the original.
+ */
+template<typename T>
+class SharedBuffer final {
+public:
+    /**
+     * @brief Default constructor, an empty buffer that owns nothing.
+     */
+    SharedBuffer() noexcept = default;
+
+    /**
+     * @brief Allocates size default-initialized elements.
+     *
+     * @param size Number of elements.
+     * @param resource Where the block is allocated; must outlive it.
+     */
+    explicit SharedBuffer(size_t size, std::pmr::memory_resource* resource = kernels::defaultResource())
+        : header(size ? create(size, resource) : nullptr) {}
+
+    /**
+     * @brief Shares the elements of another buffer, or copies them if it has leaked them.
+     */
+    SharedBuffer(const SharedBuffer& other) : header(other.header) {
+        if (header && other.leaked) {
+            header = create(other.size(), other.header->resource);
+            std::copy_n(other.data(), other.size(), elements(header));
+        } else if (header) {
+            header->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Takes over the elements of another buffer, leaving it empty and unmarked.
+     */
+    SharedBuffer(SharedBuffer&& other) noexcept : header(std::exchange(other.header, nullptr)) {
+        other.leaked = nullptr;
+    }
+
+    /**
+     * @brief Shares the elements of another buffer, releasing the current ones.
+     */
+    SharedBuffer& operator=(const SharedBuffer& other) {
+        SharedBuffer(other).swap(*this);
+        return *this;
+    }
+
+    /**
+     * @brief Takes over the elements of another buffer, releasing the current ones.
+     */
+    SharedBuffer& operator=(SharedBuffer&& other) noexcept {
+        SharedBuffer(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    /**
+     * @brief Destructor, frees the block when this was the last owner.
+     */
+    ~SharedBuffer() {
+        release();
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_t size() const noexcept {
+        return header ? header->size : 0;
+    }
+
+    /**
+     * @brief Returns a read-only pointer to the elements, never copies.
+     */
+    const T* data() const noexcept {
+        return elements(header);
+    }
+
+    /**
+     * @brief Returns a writable pointer, copying the elements first if they are shared.
+     */
+    T* mutableData() {
+        if (!unique()) {
+            header = detach(header);
+        }
+        return elements(header);
+    }
+
+    /**
+     * @brief Returns a writable pointer that may outlive the call, e.g. behind a reference.
+     *
+     * Like mutableData(), then marks the buffer so that later copies take
+     * their own elements instead of sharing these ones. Once marked this
+     * returns the pointer kept by the first call, a single load with nothing
+     * written, so element accessors can call it on every access.
+     */
+    T* leak() {
+        if (leaked) [[likely]] {
+            return leaked;
+        }
+        if (header) {
+            header = detach(header);
+            leaked = elements(header);
+        }
+        return leaked;
+    }
+
+    /**
+     * @brief Returns a writable pointer to elements whose values are about to be replaced.
+     *
+     * When the block is shared this switches to a fresh block of the same
+     * size instead of copying, so the old values stay readable through any
+     * pointer taken from data() before the call.
+     */
+    T* overwrite() {
+        if (!unique()) {
+            *this = SharedBuffer(size(), header->resource);
+        }
+        return elements(header);
+    }
+
+    /**
+     * @brief True when no other buffer shares the elements (or there are none).
+     */
+    bool unique() const noexcept {
+        return !header || header->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    /**
+     * @brief Number of buffers sharing the elements, 0 for an empty buffer.
+     */
+    size_t useCount() const noexcept {
+        return header ? header->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * @brief Returns the resource the elements were allocated from.
+     */
+    std::pmr::memory_resource* resource() const noexcept {
+        return header ? header->resource : kernels::defaultResource();
+    }
+
+    /**
+     * @brief Exchanges the contents of two buffers.
+     */
+    void swap(SharedBuffer& other) noexcept {
+        std::swap(header, other.header);
+        std::swap(leaked, other.leaked);
+    }
+
+private:
+    struct Header {
+        std::atomic<size_t> refs;
+        size_t size;
+        std::pmr::memory_resource* resource;
+    };
+
+    static constexpr size_t kAlignment = std::max({alignof(Header), alignof(T), kernels::kBufferAlignment});
+    /// The header takes a whole aligned slot, so the elements start on the block's alignment.
+    static constexpr size_t kOffset = (sizeof(Header) + kAlignment - 1) / kAlignment * kAlignment;
+
+    Header* header = nullptr;
+    T* leaked = nullptr; ///< The elements once leak() has handed them out; while set they are not shared.
+
+    static T* elements(Header* h) noexcept {
+        return h ? reinterpret_cast<T*>(reinterpret_cast<char*>(h) + kOffset) : nullptr;
+    }
+
+    static size_t bytes(size_t size) noexcept {
+        return kOffset + size * sizeof(T);
+    }
+
+    [[gnu::returns_nonnull]] static Header* create(size_t size, std::pmr::memory_resource* resource) {
+        void* raw = resource->allocate(bytes(size), kAlignment);
+        Header* h = ::new (raw) Header{{1}, size, resource};
+        try {
+            std::uninitialized_default_construct_n(elements(h), size);
+        } catch (...) {
+            resource->deallocate(raw, bytes(size), kAlignment);
+            throw;
+        }
+        return h;
+    }
+
+    // Returns h if it has a single owner, else a copy owned by the caller alone, giving up the
+    // caller's share of h. Static and out of line, so accessors inline only the check in leak().
+    [[gnu::noinline, gnu::returns_nonnull]] static Header* detach(Header* h) {
+        if (h->refs.load(std::memory_order_acquire) == 1) {
+            return h;
+        }
+        Header* copy = create(h->size, h->resource);
+        try {
+            std::copy_n(elements(h), h->size, elements(copy));
+        } catch (...) {
+            drop(copy);
+            throw;
+        }
+        drop(h);
+        return copy;
+    }
+
+    static void drop(Header* h) noexcept {
+        // A count of one cannot change under us, so the last owner skips the atomic decrement.
+        if (h && (h->refs.load(std::memory_order_acquire) == 1 ||
+                  h->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)) {
+            std::pmr::memory_resource* resource = h->resource;
+            const size_t size = h->size;
+            std::destroy_n(elements(h), size);
+            h->~Header();
+            resource->deallocate(h, bytes(size), kAlignment);
+        }
+    }
+
+    void release() noexcept {
+        drop(std::exchange(header, nullptr));
+        leaked = nullptr;
+    }
+};
+
+#endif // SHARED_BUFFER_H
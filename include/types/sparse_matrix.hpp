@@ -0,0 +1,597 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include "matrix.hpp"
+#include "../kernels/thread_pool.hpp"
+
+/**
+ * @brief Storage order of a SparseMatrix.
+ */
+enum class SparseFormat {
+    CSR, ///< Compressed sparse rows.
+    CSC  ///< Compressed sparse columns.
+};
+
+/**
+ * @class SparseMatrix
+ * @brief A compressed sparse matrix in CSR or CSC format.
+ *
+ * @tparam T Type of the elements in the matrix.
+ *
+ * The matrix stores, for every major line (row for CSR, column for CSC),
+ * the sorted minor indices and values of its nonzeros. Memory and the cost
+ * of every kernel scale with the number of nonzeros.
+ */
+template<typename T>
+class SparseMatrix final {
+public:
+    /**
+     * @brief Default constructor.
+     */
+    SparseMatrix() = default;
+
+    /**
+     * @brief Constructor for an empty (all-zero) matrix.
+     *
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param format Storage order.
+     */
+    SparseMatrix(size_t rows, size_t cols, SparseFormat format = SparseFormat::CSR)
+        : rows(rows), cols(cols), format(format), offsets(major() + 1, 0) {}
+
+    /**
+     * @brief Constructor from raw compressed arrays.
+     *
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param format Storage order of the arrays.
+     * @param offsets Start of every major line in @p indices, plus the total count.
+     * @param indices Minor index of every nonzero, sorted within each line.
+     * @param values Value of every nonzero.
+     * @throws std::invalid_argument if the arrays are inconsistent.
+     */
+    SparseMatrix(size_t rows, size_t cols, SparseFormat format, std::vector<size_t> offsets,
+                 std::vector<size_t> indices, std::vector<T> values)
+        : rows(rows), cols(cols), format(format), offsets(std::move(offsets)),
+          indices(std::move(indices)), values(std::move(values)) {
+        validate();
+    }
+
+    /**
+     * @brief Builds a sparse matrix from the nonzeros of a dense one.
+     *
+     * @param dense Source matrix.
+     * @param format Storage order of the result.
+     */
+    static SparseMatrix fromDense(const Matrix<T>& dense, SparseFormat format = SparseFormat::CSR) {
+        const size_t r = dense.getRows(), c = dense.getCols();
+        if (format == SparseFormat::CSC) {
+            return fromDense(dense, SparseFormat::CSR).toCSC();
+        }
+        SparseMatrix result(r, c, SparseFormat::CSR);
+        const auto& rowsData = dense.getData();
+        for (size_t i = 0; i < r; ++i) {
+            result.offsets[i + 1] = std::count_if(rowsData[i].begin(), rowsData[i].end(),
+                                                  [](const T& x) { return x != T(0); });
+        }
+        std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+        result.indices.resize(result.offsets[r]);
+        result.values.resize(result.offsets[r]);
+        kernels::parallel_for(0, r, kRowGrain, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                size_t p = result.offsets[i];
+                const T* row = rowsData[i].begin();
+                for (size_t j = 0; j < c; ++j) {
+                    if (row[j] != T(0)) {
+                        result.indices[p] = j;
+                        result.values[p++] = row[j];
+                    }
+                }
+            }
+        });
+        return result;
+    }
+
+    /**
+     * @brief Expands the matrix into a dense one.
+     */
+    Matrix<T> toDense() const {
+        Matrix<T> dense(rows, cols);
+        T* out = dense.mutableData();
+        if (format == SparseFormat::CSR) {
+            kernels::parallel_for(0, rows, kRowGrain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    T* row = out + i * cols;
+                    for (size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+                        row[indices[p]] = values[p];
+                    }
+                }
+            });
+        } else {
+            for (size_t j = 0; j < cols; ++j) {
+                for (size_t p = offsets[j]; p < offsets[j + 1]; ++p) {
+                    out[indices[p] * cols + j] = values[p];
+                }
+            }
+        }
+        return dense;
+    }
+
+    /**
+     * @brief Returns a copy of the matrix in CSR format.
+     */
+    SparseMatrix toCSR() const {
+        return format == SparseFormat::CSR ? *this : transposed(SparseFormat::CSR);
+    }
+
+    /**
+     * @brief Returns a copy of the matrix in CSC format.
+     */
+    SparseMatrix toCSC() const {
+        return format == SparseFormat::CSC ? *this : transposed(SparseFormat::CSC);
+    }
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    size_t getRows() const {
+        return rows;
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    size_t getCols() const {
+        return cols;
+    }
+
+    /**
+     * @brief Returns the storage order.
+     */
+    SparseFormat getFormat() const {
+        return format;
+    }
+
+    /**
+     * @brief Returns the number of stored nonzeros.
+     */
+    size_t nonZeros() const {
+        return values.size();
+    }
+
+    /**
+     * @brief Returns the start of every major line, plus the total count.
+     */
+    const std::vector<size_t>& getOffsets() const {
+        return offsets;
+    }
+
+    /**
+     * @brief Returns the minor index of every nonzero.
+     */
+    const std::vector<size_t>& getIndices() const {
+        return indices;
+    }
+
+    /**
+     * @brief Returns the value of every nonzero.
+     */
+    const std::vector<T>& getValues() const {
+        return values;
+    }
+
+    /**
+     * @brief Returns element (row, col), zero if it is not stored.
+     */
+    T at(size_t row, size_t col) const {
+        if (row >= rows || col >= cols) {
+            throw std::out_of_range("Index out of range.");
+        }
+        const size_t line = format == SparseFormat::CSR ? row : col;
+        const size_t index = format == SparseFormat::CSR ? col : row;
+        const auto first = indices.begin() + offsets[line];
+        const auto last = indices.begin() + offsets[line + 1];
+        const auto it = std::lower_bound(first, last, index);
+        return it != last && *it == index ? values[it - indices.begin()] : T(0);
+    }
+
+    /**
+     * @brief Sparse matrix-vector product (SpMV).
+     *
+     * @param x Dense vector with getCols() elements.
+     * @return Dense vector with getRows() elements.
+     */
+    Vector<T> operator*(const Vector<T>& x) const {
+        if (x.size() != cols) {
+            throw std::invalid_argument("Matrix and vector are not compatible for multiplication: size mismatch.");
+        }
+        Vector<T> y(rows);
+        if (format == SparseFormat::CSR) {
+            gather(x.begin(), y.begin());
+        } else {
+            scatter(x.begin(), y.begin(), rows);
+        }
+        return y;
+    }
+
+    /**
+     * @brief Sparse times dense matrix product (SpMM).
+     *
+     * CSC operands are converted to CSR first, which costs O(nonZeros()).
+     *
+     * @param b Dense matrix with getCols() rows.
+     * @return Dense matrix with getRows() rows.
+     */
+    Matrix<T> operator*(const Matrix<T>& b) const {
+        if (static_cast<size_t>(b.getRows()) != cols) {
+            throw std::invalid_argument("Matrices are not compatible for multiplication: size mismatch.");
+        }
+        if (format == SparseFormat::CSC) {
+            return toCSR() * b;
+        }
+        const size_t n = b.getCols();
+        Matrix<T> c(rows, n);
+        T* out = c.mutableData();
+        const auto& bRows = b.getData();
+        forEachRowRange([&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                T* ci = out + i * n;
+                for (size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+                    const T v = values[p];
+                    const T* bp = bRows[indices[p]].begin();
+                    for (size_t j = 0; j < n; ++j) {
+                        ci[j] += v * bp[j];
+                    }
+                }
+            }
+        });
+        return c;
+    }
+
+    /**
+     * @brief Sparse plus dense addition.
+     *
+     * @param dense Dense matrix of the same size.
+     * @return Dense matrix holding the sum.
+     */
+    Matrix<T> operator+(const Matrix<T>& dense) const {
+        if (static_cast<size_t>(dense.getRows()) != rows || static_cast<size_t>(dense.getCols()) != cols) {
+            throw std::invalid_argument("Matrices are not compatible for addition: size mismatch.");
+        }
+        Matrix<T> result = dense;
+        T* out = result.mutableData();
+        if (format == SparseFormat::CSR) {
+            kernels::parallel_for(0, rows, kRowGrain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    T* row = out + i * cols;
+                    for (size_t p = offsets[i]; p < offsets[i + 1]; ++p) {
+                        row[indices[p]] += values[p];
+                    }
+                }
+            });
+        } else {
+            for (size_t j = 0; j < cols; ++j) {
+                for (size_t p = offsets[j]; p < offsets[j + 1]; ++p) {
+                    out[indices[p] * cols + j] += values[p];
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Dense plus sparse addition.
+     */
+    friend Matrix<T> operator+(const Matrix<T>& dense, const SparseMatrix& sparse) {
+        return sparse + dense;
+    }
+
+    /**
+     * @brief Equality operator. Matrices in different formats compare by content.
+     */
+    bool operator==(const SparseMatrix& other) const {
+        if (format != other.format) {
+            return *this == other.transposed(format);
+        }
+        return rows == other.rows && cols == other.cols && offsets == other.offsets &&
+               indices == other.indices && values == other.values;
+    }
+
+    /**
+     * @brief Inequality operator.
+     */
+    bool operator!=(const SparseMatrix& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Stream insertion operator. Prints one "row col value" triplet per line.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const SparseMatrix& matrix) {
+        const bool csr = matrix.format == SparseFormat::CSR;
+        for (size_t line = 0; line < matrix.major(); ++line) {
+            for (size_t p = matrix.offsets[line]; p < matrix.offsets[line + 1]; ++p) {
+                const size_t r = csr ? line : matrix.indices[p];
+                const size_t c = csr ? matrix.indices[p] : line;
+                os << r << ' ' << c << ' ' << matrix.values[p] << '\n';
+            }
+        }
+        return os;
+    }
+
+private:
+    static constexpr size_t kRowGrain = 256;    ///< Rows per chunk for row-wise dense loops.
+    static constexpr size_t kNonZeroGrain = 1 << 15; ///< Nonzeros per chunk for SpMV and SpMM.
+    static constexpr size_t kScatterChunks = 16;     ///< Most private buffers one scatter() allocates.
+
+    size_t rows = 0;
+    size_t cols = 0;
+    SparseFormat format = SparseFormat::CSR;
+    std::vector<size_t> offsets{0}; ///< Start of every major line, plus the total count.
+    std::vector<size_t> indices;    ///< Minor index of every nonzero.
+    std::vector<T> values;          ///< Value of every nonzero.
+
+    size_t major() const {
+        return format == SparseFormat::CSR ? rows : cols;
+    }
+
+    size_t minor() const {
+        return format == SparseFormat::CSR ? cols : rows;
+    }
+
+    void validate() const {
+        if (offsets.size() != major() + 1 || offsets.front() != 0 || offsets.back() != indices.size() ||
+            indices.size() != values.size()) {
+            throw std::invalid_argument("Sparse matrix arrays are inconsistent.");
+        }
+        for (size_t line = 0; line < major(); ++line) {
+            if (offsets[line] > offsets[line + 1]) {
+                throw std::invalid_argument("Sparse matrix offsets must be non-decreasing.");
+            }
+            for (size_t p = offsets[line]; p < offsets[line + 1]; ++p) {
+                if (indices[p] >= minor() || (p > offsets[line] && indices[p] <= indices[p - 1])) {
+                    throw std::invalid_argument("Sparse matrix indices must be sorted and in range.");
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Runs fn(lo, hi) over major lines, in chunks of about kNonZeroGrain nonzeros.
+     *
+     * Chunk boundaries come from the offsets alone, so rows with many
+     * nonzeros do not pile up in one task.
+     */
+    template<typename F>
+    void forEachRowRange(F&& fn) const {
+        const size_t lines = major();
+        const size_t chunks = std::max<size_t>(1, nonZeros() / kNonZeroGrain);
+        if (chunks == 1) {
+            fn(0, lines);
+            return;
+        }
+        auto boundary = [&](size_t c) {
+            if (c == 0 || c == chunks) {
+                return c == 0 ? size_t(0) : lines;
+            }
+            const size_t target = nonZeros() / chunks * c;
+            return static_cast<size_t>(std::upper_bound(offsets.begin(), offsets.end(), target) - offsets.begin()) - 1;
+        };
+        kernels::ThreadPool::instance().run(chunks, [&](size_t c) {
+            const size_t lo = boundary(c), hi = boundary(c + 1);
+            if (lo < hi) {
+                fn(lo, hi);
+            }
+        });
+    }
+
+    /**
+     * @brief y[line] = sum over the line of value * x[index]; parallel over lines.
+     */
+    void gather(const T* x, T* y) const {
+        forEachRowRange([&](size_t lo, size_t hi) {
+            for (size_t line = lo; line < hi; ++line) {
+                T sum = T(0);
+                for (size_t p = offsets[line]; p < offsets[line + 1]; ++p) {
+                    sum += values[p] * x[indices[p]];
+                }
+                y[line] = sum;
+            }
+        });
+    }
+
+    /**
+     * @brief y[index] += value * x[line] for every nonzero.
+     *
+     * Each chunk of lines scatters into its own buffer; buffers are summed
+     * in chunk order. The chunk count comes from the number of nonzeros
+     * and the output length alone, so the result is the same on every
+     * machine and pool size. Each buffer costs length to clear and to sum,
+     * so there are never more chunks than nonzeros per output element: a
+     * long, sparse output is scattered serially.
+     */
+    void scatter(const T* x, T* y, size_t length) const {
+        const size_t lines = major();
+        const size_t chunks = std::min({kScatterChunks, nonZeros() / std::max<size_t>(1, length),
+                                        std::max<size_t>(1, nonZeros() / kNonZeroGrain)});
+        if (chunks <= 1) {
+            for (size_t line = 0; line < lines; ++line) {
+                for (size_t p = offsets[line]; p < offsets[line + 1]; ++p) {
+                    y[indices[p]] += values[p] * x[line];
+                }
+            }
+            return;
+        }
+        std::vector<std::vector<T>> partial(chunks, std::vector<T>(length, T(0)));
+        const size_t grain = (lines + chunks - 1) / chunks;
+        kernels::ThreadPool::instance().run(chunks, [&](size_t c) {
+            T* out = partial[c].data();
+            for (size_t line = c * grain; line < std::min(lines, (c + 1) * grain); ++line) {
+                for (size_t p = offsets[line]; p < offsets[line + 1]; ++p) {
+                    out[indices[p]] += values[p] * x[line];
+                }
+            }
+        });
+        kernels::parallel_for(0, length, kNonZeroGrain, [&](size_t lo, size_t hi) {
+            for (const auto& part : partial) {
+                for (size_t i = lo; i < hi; ++i) {
+                    y[i] += part[i];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Returns the same matrix stored in the other format (a structural transpose).
+     */
+    SparseMatrix transposed(SparseFormat target) const {
+        SparseMatrix result(rows, cols, target);
+        const size_t lines = minor();
+        for (size_t index : indices) {
+            ++result.offsets[index + 1];
+        }
+        std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+        result.indices.resize(nonZeros());
+        result.values.resize(nonZeros());
+        std::vector<size_t> next(result.offsets.begin(), result.offsets.begin() + lines);
+        for (size_t line = 0; line < major(); ++line) {
+            for (size_t p = offsets[line]; p < offsets[line + 1]; ++p) {
+                const size_t q = next[indices[p]]++;
+                result.indices[q] = line;
+                result.values[q] = values[p];
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * @class CooBuilder
+ * @brief Collects (row, col, value) triplets and compresses them into a SparseMatrix.
+ *
+ * @tparam T Type of the elements in the matrix.
+ *
+ * Triplets may come in any order; duplicates are summed when the matrix is built.
+ */
+template<typename T>
+class CooBuilder final {
+public:
+    /**
+     * @brief Constructor.
+     *
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     */
+    CooBuilder(size_t rows, size_t cols) : rows(rows), cols(cols) {}
+
+    /**
+     * @brief Reserves space for a number of triplets.
+     */
+    void reserve(size_t count) {
+        entries.reserve(count);
+    }
+
+    /**
+     * @brief Adds a value at (row, col).
+     *
+     * @throws std::out_of_range if the position is outside the matrix.
+     */
+    void add(size_t row, size_t col, T value) {
+        if (row >= rows || col >= cols) {
+            throw std::out_of_range("Index out of range.");
+        }
+        entries.emplace_back(row, col, value);
+    }
+
+    /**
+     * @brief Returns the number of triplets added so far.
+     */
+    size_t size() const {
+        return entries.size();
+    }
+
+    /**
+     * @brief Compresses the triplets.
+     *
+     * @param format Storage order of the result.
+     */
+    SparseMatrix<T> build(SparseFormat format = SparseFormat::CSR) const {
+        const bool csr = format == SparseFormat::CSR;
+        const size_t lines = csr ? rows : cols;
+        std::vector<size_t> offsets(lines + 1, 0);
+        for (const auto& [r, c, v] : entries) {
+            ++offsets[(csr ? r : c) + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+        // Bucket by major line, then sort and merge duplicates within each line.
+        std::vector<std::pair<size_t, T>> bucketed(entries.size());
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        for (const auto& [r, c, v] : entries) {
+            bucketed[next[csr ? r : c]++] = {csr ? c : r, v};
+        }
+        std::vector<size_t> compressed(lines + 1, 0);
+        std::vector<size_t> indices;
+        std::vector<T> values;
+        indices.reserve(entries.size());
+        values.reserve(entries.size());
+        for (size_t line = 0; line < lines; ++line) {
+            auto first = bucketed.begin() + offsets[line];
+            auto last = bucketed.begin() + offsets[line + 1];
+            std::sort(first, last, [](const auto& a, const auto& b) { return a.first < b.first; });
+            for (auto it = first; it != last; ++it) {
+                if (indices.size() > compressed[line] && indices.back() == it->first) {
+                    values.back() += it->second;
+                } else {
+                    indices.push_back(it->first);
+                    values.push_back(it->second);
+                }
+            }
+            compressed[line + 1] = indices.size();
+        }
+        return SparseMatrix<T>(rows, cols, format, std::move(compressed), std::move(indices), std::move(values));
+    }
+
+private:
+    size_t rows;
+    size_t cols;
+    std::vector<std::tuple<size_t, size_t, T>> entries; ///< Triplets in insertion order.
+};
+
+#endif // SPARSE_MATRIX_H
@@ -0,0 +1,332 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SPARSE_VECTOR_H
+#define SPARSE_VECTOR_H
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "vector.hpp"
+#include "../kernels/sparse.hpp"
+
+/**
+ * @class SparseVector
+ * @brief A sparse vector holding the sorted indices and values of its nonzeros.
+ *
+ * @tparam T Type of the elements in the vector.
+ *
+ * Memory and the cost of every operation scale with the number of
+ * nonzeros, not with size(). Dense operands are taken as views, so rows
+ * and slices of dense data work without copying.
+ */
+template<typename T>
+class SparseVector final {
+public:
+    /**
+     * @brief Default constructor.
+     */
+    SparseVector() = default;
+
+    /**
+     * @brief Constructor for an all-zero vector.
+     *
+     * @param n Size of the vector.
+     */
+    explicit SparseVector(size_t n) : n(n) {}
+
+    /**
+     * @brief Constructor from index and value arrays.
+     *
+     * @param n Size of the vector.
+     * @param indices Strictly increasing positions of the nonzeros.
+     * @param values Value of every nonzero.
+     * @throws std::invalid_argument if the arrays are inconsistent.
+     */
+    SparseVector(size_t n, std::vector<size_t> indices, std::vector<T> values)
+        : n(n), indices(std::move(indices)), values(std::move(values)) {
+        validate();
+    }
+
+    /**
+     * @brief Builds a sparse vector from the nonzeros of a dense one.
+     *
+     * @param dense Source vector or view.
+     */
+    static SparseVector fromDense(VectorView<const T> dense) {
+        SparseVector result(dense.size());
+        const T* x = dense.begin();
+        const size_t count = std::count_if(x, x + dense.size(), [](const T& v) { return v != T(0); });
+        result.indices.reserve(count);
+        result.values.reserve(count);
+        for (size_t i = 0; i < dense.size(); ++i) {
+            if (x[i] != T(0)) {
+                result.indices.push_back(i);
+                result.values.push_back(x[i]);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Builds a sparse vector from the nonzeros of a dense one.
+     */
+    static SparseVector fromDense(const Vector<T>& dense) {
+        return fromDense(dense.view());
+    }
+
+    /**
+     * @brief Gathers dense[indices[p]] into a sparse vector with the given pattern.
+     *
+     * @param dense Source vector or view.
+     * @param indices Strictly increasing positions to gather.
+     * @throws std::invalid_argument if the indices are not sorted or out of range.
+     */
+    static SparseVector gather(VectorView<const T> dense, std::vector<size_t> indices) {
+        std::vector<T> values(indices.size());
+        SparseVector result(dense.size(), std::move(indices), std::move(values));
+        kernels::gather(result.nonZeros(), result.indices.data(), dense.begin(), result.values.data());
+        return result;
+    }
+
+    /**
+     * @brief Gathers dense[indices[p]] into a sparse vector with the given pattern.
+     */
+    static SparseVector gather(const Vector<T>& dense, std::vector<size_t> indices) {
+        return gather(dense.view(), std::move(indices));
+    }
+
+    /**
+     * @brief Expands the vector into a dense one.
+     */
+    Vector<T> toDense() const {
+        Vector<T> dense(n);
+        scatter(dense.view());
+        return dense;
+    }
+
+    /**
+     * @brief Writes the nonzeros into dense; other elements are left unchanged.
+     *
+     * @throws std::invalid_argument if the sizes differ.
+     */
+    void scatter(VectorView<T> dense) const {
+        checkSize(dense.size());
+        kernels::scatter(nonZeros(), indices.data(), values.data(), dense.begin());
+    }
+
+    /**
+     * @brief Writes the nonzeros into dense; other elements are left unchanged.
+     */
+    void scatter(Vector<T>& dense) const {
+        scatter(dense.view());
+    }
+
+    /**
+     * @brief Returns the size of the vector.
+     */
+    size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns the number of stored nonzeros.
+     */
+    size_t nonZeros() const {
+        return values.size();
+    }
+
+    /**
+     * @brief Returns the positions of the nonzeros.
+     */
+    const std::vector<size_t>& getIndices() const {
+        return indices;
+    }
+
+    /**
+     * @brief Returns the values of the nonzeros.
+     */
+    const std::vector<T>& getValues() const {
+        return values;
+    }
+
+    /**
+     * @brief Returns element i, found by binary search.
+     *
+     * @throws std::out_of_range if i >= size().
+     */
+    T at(size_t i) const {
+        if (i >= n) {
+            throw std::out_of_range("Index out of range.");
+        }
+        const auto it = std::lower_bound(indices.begin(), indices.end(), i);
+        return it != indices.end() && *it == i ? values[it - indices.begin()] : T(0);
+    }
+
+    /**
+     * @brief Sparse-dense dot product.
+     *
+     * @param dense Vector or view of the same size.
+     */
+    T dot(VectorView<const T> dense) const {
+        checkSize(dense.size());
+        return kernels::gatherDot(nonZeros(), indices.data(), values.data(), dense.begin());
+    }
+
+    /**
+     * @brief Sparse-dense dot product.
+     */
+    T dot(const Vector<T>& dense) const {
+        return dot(dense.view());
+    }
+
+    /**
+     * @brief Sparse-sparse dot product.
+     */
+    T dot(const SparseVector& other) const {
+        checkSize(other.n);
+        return kernels::sparseDot(nonZeros(), indices.data(), values.data(),
+                                  other.nonZeros(), other.indices.data(), other.values.data());
+    }
+
+    /**
+     * @brief dense += alpha * this (sparse AXPY); only the nonzero positions are touched.
+     *
+     * @throws std::invalid_argument if the sizes differ.
+     */
+    void axpy(T alpha, VectorView<T> dense) const {
+        checkSize(dense.size());
+        kernels::scatterAxpy(nonZeros(), alpha, indices.data(), values.data(), dense.begin());
+    }
+
+    /**
+     * @brief dense += alpha * this (sparse AXPY).
+     */
+    void axpy(T alpha, Vector<T>& dense) const {
+        axpy(alpha, dense.view());
+    }
+
+    /**
+     * @brief Sparse plus sparse; the pattern is the union, exact zeros are dropped.
+     */
+    SparseVector operator+(const SparseVector& other) const {
+        return merge<kernels::BinaryOp::Add>(other);
+    }
+
+    /**
+     * @brief Sparse minus sparse; the pattern is the union, exact zeros are dropped.
+     */
+    SparseVector operator-(const SparseVector& other) const {
+        return merge<kernels::BinaryOp::Sub>(other);
+    }
+
+    /**
+     * @brief Multiplication by a scalar.
+     */
+    SparseVector operator*(const T& scalar) const {
+        if (scalar == T(0)) {
+            return SparseVector(n);
+        }
+        SparseVector result(*this);
+        for (auto& v : result.values) {
+            v *= scalar;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Multiplication of a scalar by a sparse vector.
+     */
+    friend SparseVector operator*(const T& scalar, const SparseVector& vec) {
+        return vec * scalar;
+    }
+
+    /**
+     * @brief Equality operator, by size and stored entries.
+     */
+    bool operator==(const SparseVector& other) const {
+        return n == other.n && indices == other.indices && values == other.values;
+    }
+
+    /**
+     * @brief Inequality operator.
+     */
+    bool operator!=(const SparseVector& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Stream insertion operator. Prints one "index value" pair per line.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const SparseVector& vec) {
+        for (size_t p = 0; p < vec.nonZeros(); ++p) {
+            os << vec.indices[p] << ' ' << vec.values[p] << '\n';
+        }
+        return os;
+    }
+
+private:
+    size_t n = 0;
+    std::vector<size_t> indices; ///< Position of every nonzero, strictly increasing.
+    std::vector<T> values;       ///< Value of every nonzero.
+
+    void checkSize(size_t size) const {
+        if (size != n) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+    }
+
+    void validate() const {
+        if (indices.size() != values.size()) {
+            throw std::invalid_argument("Sparse vector arrays are inconsistent.");
+        }
+        for (size_t p = 0; p < indices.size(); ++p) {
+            if (indices[p] >= n || (p > 0 && indices[p] <= indices[p - 1])) {
+                throw std::invalid_argument("Sparse vector indices must be sorted and in range.");
+            }
+        }
+    }
+
+    template<kernels::BinaryOp op>
+    SparseVector merge(const SparseVector& other) const {
+        checkSize(other.n);
+        SparseVector result(n);
+        result.indices.resize(nonZeros() + other.nonZeros());
+        result.values.resize(nonZeros() + other.nonZeros());
+        const size_t count = kernels::sparseMerge<op>(nonZeros(), indices.data(), values.data(),
+                                                      other.nonZeros(), other.indices.data(), other.values.data(),
+                                                      result.indices.data(), result.values.data());
+        result.indices.resize(count);
+        result.values.resize(count);
+        return result;
+    }
+};
+
+#endif // SPARSE_VECTOR_H
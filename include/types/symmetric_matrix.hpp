@@ -0,0 +1,203 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SYMMETRIC_MATRIX_H
+#define SYMMETRIC_MATRIX_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "matrix.hpp"
+#include "../kernels/blas.hpp"
+
+/**
+ * @class SymmetricMatrix
+ * @brief A symmetric matrix in packed storage.
+ *
+ * @tparam T Type of the elements in the matrix.
+ *
+ * Only the lower triangle is stored, row by row, so element (i, j) and
+ * element (j, i) are the same object. Products stream the stored triangle
+ * twice: row by row for the part on and below the diagonal, then in
+ * column stripes for the mirrored part, so no two tasks write the same
+ * output row.
+ */
+template<typename T>
+class SymmetricMatrix final {
+public:
+    /**
+     * @brief Default constructor.
+     */
+    SymmetricMatrix() = default;
+
+    /**
+     * @brief Constructor for a zero matrix.
+     *
+     * @param n Order of the matrix.
+     */
+    explicit SymmetricMatrix(size_t n) : n(n), data(n * (n + 1) / 2) {}
+
+    /**
+     * @brief Packs the lower triangle of a dense square matrix.
+     *
+     * @param dense Source matrix; its upper triangle is ignored.
+     */
+    static SymmetricMatrix fromDense(const Matrix<T>& dense) {
+        if (dense.getRows() != dense.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        SymmetricMatrix result(dense.getRows());
+        for (size_t i = 0; i < result.n; ++i) {
+            const T* src = dense.getData()[i].begin();
+            std::copy(src, src + i + 1, result.row(i));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Expands the matrix into a dense one.
+     */
+    Matrix<T> toDense() const {
+        Matrix<T> dense(n, n);
+        T* out = dense.mutableData();
+        for (size_t i = 0; i < n; ++i) {
+            T* dst = out + i * n;
+            std::copy(row(i), row(i) + i + 1, dst);
+            for (size_t j = i + 1; j < n; ++j) {
+                dst[j] = row(j)[i];
+            }
+        }
+        return dense;
+    }
+
+    /**
+     * @brief Returns the order of the matrix.
+     */
+    size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns element (i, j).
+     */
+    T at(size_t i, size_t j) const {
+        if (i >= n || j >= n) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return i >= j ? row(i)[j] : row(j)[i];
+    }
+
+    /**
+     * @brief Returns a reference to element (i, j), shared with element (j, i).
+     */
+    T& operator()(size_t i, size_t j) {
+        if (i >= n || j >= n) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return i >= j ? row(i)[j] : row(j)[i];
+    }
+
+    /**
+     * @brief Symmetric matrix-vector product (SYMV).
+     */
+    Vector<T> operator*(const Vector<T>& x) const {
+        if (x.size() != n) {
+            throw std::invalid_argument("Matrix and vector are not compatible for multiplication: size mismatch.");
+        }
+        Vector<T> y(n);
+        const T* px = x.begin();
+        T* py = y.begin();
+        kernels::parallel_for(0, n, rowGrain(1), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                py[i] = kernels::dot(i + 1, row(i), px);
+            }
+        });
+        kernels::parallel_for(0, n, stripeGrain(1), [&](size_t lo, size_t hi) {
+            for (size_t i = lo + 1; i < n; ++i) {
+                const size_t end = std::min(hi, i);
+                kernels::axpy(end - lo, px[i], row(i) + lo, py + lo);
+            }
+        });
+        return y;
+    }
+
+    /**
+     * @brief Symmetric times dense matrix product (SYMM).
+     */
+    Matrix<T> operator*(const Matrix<T>& b) const {
+        if (static_cast<size_t>(b.getRows()) != n) {
+            throw std::invalid_argument("Matrices are not compatible for multiplication: size mismatch.");
+        }
+        const size_t k = b.getCols();
+        Matrix<T> c(n, k);
+        T* out = c.mutableData();
+        const auto& bRows = b.getData();
+        kernels::parallel_for(0, n, rowGrain(k), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                T* ci = out + i * k;
+                const T* ai = row(i);
+                for (size_t p = 0; p <= i; ++p) {
+                    kernels::axpy(k, ai[p], bRows[p].begin(), ci);
+                }
+            }
+        });
+        kernels::parallel_for(0, n, stripeGrain(k), [&](size_t lo, size_t hi) {
+            for (size_t i = lo + 1; i < n; ++i) {
+                const T* ai = row(i);
+                const T* bi = bRows[i].begin();
+                for (size_t j = lo; j < std::min(hi, i); ++j) {
+                    kernels::axpy(k, ai[j], bi, out + j * k);
+                }
+            }
+        });
+        return c;
+    }
+
+private:
+    size_t n = 0;
+    std::vector<T> data; ///< Packed rows of the lower triangle.
+
+    T* row(size_t i) {
+        return data.data() + i * (i + 1) / 2;
+    }
+
+    const T* row(size_t i) const {
+        return data.data() + i * (i + 1) / 2;
+    }
+
+    size_t rowGrain(size_t k) const {
+        return std::max<size_t>(1, kernels::kStreamGrain / (n * k / 2 + 1));
+    }
+
+    size_t stripeGrain(size_t k) const {
+        return std::max<size_t>(16, kernels::kStreamGrain / (n * k + 1));
+    }
+};
+
+#endif // SYMMETRIC_MATRIX_H
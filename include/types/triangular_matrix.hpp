@@ -0,0 +1,286 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TRIANGULAR_MATRIX_H
+#define TRIANGULAR_MATRIX_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "matrix.hpp"
+#include "../kernels/blas.hpp"
+
+/**
+ * @brief Which triangle of a square matrix is stored.
+ */
+enum class Triangle {
+    Lower, ///< Elements on and below the diagonal.
+    Upper  ///< Elements on and above the diagonal.
+};
+
+/**
+ * @class TriangularMatrix
+ * @brief A square triangular matrix in packed row-major storage.
+ *
+ * @tparam T Type of the elements in the matrix.
+ *
+ * Only the n * (n + 1) / 2 elements of the stored triangle are kept, and
+ * every kernel (TRMV, TRMM, TRSV, TRSM) skips the zero triangle.
+ */
+template<typename T>
+class TriangularMatrix final {
+public:
+    /**
+     * @brief Default constructor.
+     */
+    TriangularMatrix() = default;
+
+    /**
+     * @brief Constructor for a zero matrix.
+     *
+     * @param n Order of the matrix.
+     * @param triangle Which triangle is stored.
+     */
+    explicit TriangularMatrix(size_t n, Triangle triangle = Triangle::Lower)
+        : n(n), triangle(triangle), data(n * (n + 1) / 2) {}
+
+    /**
+     * @brief Packs one triangle of a dense square matrix; the other one is ignored.
+     *
+     * @param dense Source matrix.
+     * @param triangle Which triangle to keep.
+     */
+    static TriangularMatrix fromDense(const Matrix<T>& dense, Triangle triangle = Triangle::Lower) {
+        if (dense.getRows() != dense.getCols()) {
+            throw std::invalid_argument("Matrix must be square.");
+        }
+        TriangularMatrix result(dense.getRows(), triangle);
+        for (size_t i = 0; i < result.n; ++i) {
+            const T* src = dense.getData()[i].begin();
+            std::copy(src + result.first(i), src + result.last(i), result.row(i));
+        }
+        return result;
+    }
+
+    /**
+     * @brief Expands the matrix into a dense one.
+     */
+    Matrix<T> toDense() const {
+        Matrix<T> dense(n, n);
+        T* out = dense.mutableData();
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(row(i), row(i) + last(i) - first(i), out + i * n + first(i));
+        }
+        return dense;
+    }
+
+    /**
+     * @brief Returns the order of the matrix.
+     */
+    size_t size() const {
+        return n;
+    }
+
+    /**
+     * @brief Returns which triangle is stored.
+     */
+    Triangle getTriangle() const {
+        return triangle;
+    }
+
+    /**
+     * @brief Returns element (i, j), zero outside the stored triangle.
+     */
+    T at(size_t i, size_t j) const {
+        if (i >= n || j >= n) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return j >= first(i) && j < last(i) ? row(i)[j - first(i)] : T(0);
+    }
+
+    /**
+     * @brief Returns a reference to element (i, j) of the stored triangle.
+     *
+     * @throws std::out_of_range if (i, j) lies outside the stored triangle.
+     */
+    T& operator()(size_t i, size_t j) {
+        if (i >= n || j < first(i) || j >= last(i)) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return row(i)[j - first(i)];
+    }
+
+    /**
+     * @brief Triangular matrix-vector product (TRMV).
+     */
+    Vector<T> operator*(const Vector<T>& x) const {
+        if (x.size() != n) {
+            throw std::invalid_argument("Matrix and vector are not compatible for multiplication: size mismatch.");
+        }
+        Vector<T> y(n);
+        T* out = y.mutableData();
+        kernels::parallel_for(0, n, grain(1), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                out[i] = kernels::dot(last(i) - first(i), row(i), x.begin() + first(i));
+            }
+        });
+        return y;
+    }
+
+    /**
+     * @brief Triangular times dense matrix product (TRMM).
+     */
+    Matrix<T> operator*(const Matrix<T>& b) const {
+        if (static_cast<size_t>(b.getRows()) != n) {
+            throw std::invalid_argument("Matrices are not compatible for multiplication: size mismatch.");
+        }
+        const size_t k = b.getCols();
+        Matrix<T> c(n, k);
+        T* out = c.mutableData();
+        const auto& bRows = b.getData();
+        kernels::parallel_for(0, n, grain(k), [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                T* ci = out + i * k;
+                const T* ai = row(i);
+                for (size_t p = first(i); p < last(i); ++p) {
+                    kernels::axpy(k, ai[p - first(i)], bRows[p].begin(), ci);
+                }
+            }
+        });
+        return c;
+    }
+
+    /**
+     * @brief Solves A * x = b by substitution (TRSV).
+     *
+     * @throws std::invalid_argument if the diagonal holds a zero.
+     */
+    Vector<T> solve(const Vector<T>& b) const {
+        if (b.size() != n) {
+            throw std::invalid_argument("Right-hand side size does not match the matrix.");
+        }
+        checkDiagonal();
+        Vector<T> x(b);
+        T* px = x.mutableData();
+        const bool lower = triangle == Triangle::Lower;
+        for (size_t step = 0; step < n; ++step) {
+            const size_t i = lower ? step : n - 1 - step;
+            const T* ai = row(i);
+            // Off-diagonal part of row i, and where the diagonal sits in it.
+            const size_t offset = lower ? 0 : 1;
+            const size_t count = last(i) - first(i) - 1;
+            const size_t from = lower ? first(i) : i + 1;
+            const T diag = lower ? ai[count] : ai[0];
+            px[i] = (px[i] - kernels::dot(count, ai + offset, px + from)) / diag;
+        }
+        return x;
+    }
+
+    /**
+     * @brief Solves A * X = B for all columns of B at once (TRSM).
+     *
+     * Rows are eliminated in order; each step updates all right-hand sides
+     * with one vectorized row operation, split across column stripes.
+     *
+     * @throws std::invalid_argument if the diagonal holds a zero.
+     */
+    Matrix<T> solve(const Matrix<T>& b) const {
+        if (static_cast<size_t>(b.getRows()) != n) {
+            throw std::invalid_argument("Right-hand side rows do not match the matrix.");
+        }
+        checkDiagonal();
+        const size_t k = b.getCols();
+        Matrix<T> x = b;
+        T* out = x.mutableData();
+        const bool lower = triangle == Triangle::Lower;
+        kernels::parallel_for(0, k, std::max<size_t>(64, kernels::kStreamGrain / (n * n / 2 + 1)),
+                              [&](size_t lo, size_t hi) {
+            for (size_t step = 0; step < n; ++step) {
+                const size_t i = lower ? step : n - 1 - step;
+                T* xi = out + i * k;
+                const T* ai = row(i);
+                for (size_t p = first(i); p < last(i); ++p) {
+                    if (p != i) {
+                        kernels::axpy(hi - lo, -ai[p - first(i)], out + p * k + lo, xi + lo);
+                    }
+                }
+                const T diag = ai[i - first(i)];
+                for (size_t j = lo; j < hi; ++j) {
+                    xi[j] /= diag;
+                }
+            }
+        });
+        return x;
+    }
+
+private:
+    size_t n = 0;
+    Triangle triangle = Triangle::Lower;
+    std::vector<T> data; ///< Packed rows of the stored triangle.
+
+    /**
+     * @brief First stored column of row i.
+     */
+    size_t first(size_t i) const {
+        return triangle == Triangle::Lower ? 0 : i;
+    }
+
+    /**
+     * @brief One past the last stored column of row i.
+     */
+    size_t last(size_t i) const {
+        return triangle == Triangle::Lower ? i + 1 : n;
+    }
+
+    size_t offset(size_t i) const {
+        return triangle == Triangle::Lower ? i * (i + 1) / 2 : i * n - i * (i - 1) / 2;
+    }
+
+    T* row(size_t i) {
+        return data.data() + offset(i);
+    }
+
+    const T* row(size_t i) const {
+        return data.data() + offset(i);
+    }
+
+    size_t grain(size_t width) const {
+        return std::max<size_t>(1, kernels::kStreamGrain / (std::max<size_t>(n, 1) * width / 2 + 1));
+    }
+
+    void checkDiagonal() const {
+        for (size_t i = 0; i < n; ++i) {
+            if (row(i)[i - first(i)] == T(0)) {
+                throw std::invalid_argument("Matrix is singular.");
+            }
+        }
+    }
+};
+
+#endif // TRIANGULAR_MATRIX_H
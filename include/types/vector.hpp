@@ -30,23 +30,40 @@
 #ifndef VECTOR_H
 #define VECTOR_H
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <stdexcept>
 #include <numeric> // Для std::accumulate
 #include <iterator> // Add this line to include the <iterator> header
+#include <utility>
+#include <type_traits>
+#include "shared_buffer.hpp"
+#include "vector_expression.hpp"
+#include "view.hpp"
 
 /**
  * @class Vector
  * @brief A template class that represents a mathematical vector.
  *
  * @tparam T The type of elements stored in the vector.
+ * @tparam Bounds Whether operator[] checks indices: Checked (default),
+ *         DebugChecked or Unchecked.
  *
  * This class provides various operators for vector arithmetic and comparison.
+ * Reductions (dot, sum, norms, extrema) come from Reductions and are shared
+ * with the views.
+ *
+ * Copies share the elements (see SharedBuffer) until one of them asks for
+ * write access through a non-const member, so passing vectors by value is
+ * O(1). A mutable view or pointer must not be kept across a copy of the
+ * vector it came from: it would write into both.
  */
-template<typename T>
-class Vector final {
+template<typename T, typename Bounds>
+class Vector<T, Dynamic, Bounds> final : public Reductions<Vector<T, Dynamic, Bounds>, T> {
 public:
+    using value_type = T;
+
     /**
      * @brief Default constructor.
      */
@@ -56,8 +73,14 @@ public:
      * @brief Constructor.
      *
      * @param size The size of the vector.
+     * @param resource Where the elements are allocated, e.g. an arena; must outlive them.
      */
-    explicit Vector(size_t size) : data(size) {}
+    explicit Vector(size_t size, std::pmr::memory_resource* resource = kernels::defaultResource())
+        : data(size, resource) {
+        if constexpr (std::is_trivially_default_constructible_v<T>) {
+            kernels::fill(size, data.mutableData(), T(0));
+        }
+    }
 
     /**
      * @brief Move constructor.
@@ -66,8 +89,10 @@ public:
      */
     Vector(Vector&& other) noexcept : data(std::move(other.data)) {}
     /**
-     * @brief Copy constructor 
-     * 
+     * @brief Copy constructor, shares the elements until either vector is written.
+     *
+     * Elements already handed out through a reference or a view are copied at once.
+     *
      * @param other The vector to copy from.
      */
     Vector(const Vector& other) : data(other.data) {}
@@ -80,7 +105,7 @@ public:
      * @brief Prints the vector.
      */
     void print() const {
-        for (const auto& elem : data) {
+        for (const auto& elem : *this) {
             std::cout << elem << ' ';
         }
         std::cout << std::endl;
@@ -91,7 +116,7 @@ public:
      * @return Reference to the incremented vector.
      */
     Vector& operator++() requires std::is_arithmetic_v<T> {
-        for (auto& elem : data) {
+        for (auto& elem : *this) {
             ++elem;
         }
         return *this;
@@ -102,28 +127,12 @@ public:
      * @return Reference to the decremented vector.
      */
     Vector& operator--() requires std::is_arithmetic_v<T> {
-        for (auto& elem : data) {
+        for (auto& elem : *this) {
             --elem;
         }
         return *this;
     }
 
-    /**
-     * @brief Modulus operator.
-     * @param other The other vector to perform the operation with.
-     * @return A new vector representing the modulus.
-     */
-    Vector operator%(const Vector& other) const {
-        if (data.size() != other.data.size()) {
-            throw std::invalid_argument("Vectors must have the same size.");
-        }
-        Vector result(data.size());
-        for (size_t i = 0; i < data.size(); ++i) {
-            result.data[i] = data[i] % other.data[i];
-        }
-        return result;
-    }
-
     /**
      * @brief Equality operator.
      *
@@ -131,7 +140,7 @@ public:
      * @return True if the vectors are equal, false otherwise.
      */
     bool operator==(const Vector& other) const {
-        return data == other.data;
+        return std::equal(begin(), end(), other.begin(), other.end());
     }
 
     /**
@@ -151,7 +160,7 @@ public:
      * @return True if this vector is less than the other, false otherwise.
      */
     bool operator<(const Vector& other) const {
-        return std::lexicographical_compare(data.begin(), data.end(), other.data.begin(), other.data.end());
+        return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
     }
 
     /**
@@ -185,125 +194,187 @@ public:
     }
 
     /**
-     * @brief Addition operator.
+     * @brief Constructor that evaluates an elementwise expression in one pass.
      *
-     * @param other The other vector to add.
-     * @return A new vector representing the sum.
+     * @param e Expression such as `a + b * c`.
      */
-    Vector operator+(const Vector& other) const {
-        if (data.size() != other.data.size()) {
-            throw std::invalid_argument("Vectors must have the same size.");
-        }
-        Vector result(data.size());
-        for (size_t i = 0; i < data.size(); ++i) {
-            result.data[i] = data[i] + other.data[i];
-        }
-        return result;
+    template<expr::Node E>
+    Vector(const E& e) : data(e.size()) {
+        evaluate(e);
     }
 
     /**
-     * @brief Subtraction operator.
+     * @brief Copies the elements of a view into a new vector.
      *
-     * @param other The other vector to subtract.
-     * @return A new vector representing the difference.
+     * @param view Contiguous or strided view.
      */
-    Vector operator-(const Vector& other) const {
-        if (data.size() != other.data.size()) {
-            throw std::invalid_argument("Vectors must have the same size.");
-        }
-        Vector result(data.size());
-        for (size_t i = 0; i < data.size(); ++i) {
-            result.data[i] = data[i] - other.data[i];
-        }
-        return result;
+    template<typename V>
+        requires expr::IsView<V>::value
+    explicit Vector(const V& view) : data(view.size()) {
+        evaluate(expr::operand(view));
     }
 
     /**
-     * @brief Multiplication operator.
+     * @brief Copies a vector that uses another access policy.
      *
-     * @param other The other vector to multiply.
-     * @return A new vector representing the product.
+     * @param other Vector with the same element type.
      */
-    Vector operator*(const Vector& other) const {
-        if (data.size() != other.data.size()) {
-            throw std::invalid_argument("Vectors must have the same size.");
-        }
-        Vector result(data.size());
-        for (size_t i = 0; i < data.size(); ++i) {
-            result.data[i] = data[i] * other.data[i];
-        }
-        return result;
+    template<typename B>
+        requires (!std::is_same_v<B, Bounds>)
+    explicit Vector(const Vector<T, Dynamic, B>& other) : data(other.size()) {
+        evaluate(expr::operand(other));
     }
 
     /**
-     * @brief Division operator.
+     * @brief Assigns an elementwise expression, reusing the buffer when the size matches.
      *
-     * @param other The other vector to divide.
-     * @return A new vector representing the quotient.
+     * Operands may be this vector itself: every element only depends on
+     * the operands' elements at the same index. A slice of this vector can
+     * only be an operand when the size changes, and then the result goes to
+     * a new buffer while the old one is still being read. Shared elements
+     * are not copied first; the result goes to a fresh buffer instead.
+     *
+     * @param e Expression such as `a + b * c`.
      */
-    Vector operator/(const Vector& other) const {
-        if (data.size() != other.data.size()) {
-            throw std::invalid_argument("Vectors must have the same size.");
+    template<expr::Node E>
+    Vector& operator=(const E& e) {
+        if (e.size() != data.size()) {
+            SharedBuffer<T> result(e.size());
+            expr::evaluate(e, result.mutableData());
+            data = std::move(result);
+            return *this;
         }
-        Vector result(data.size());
-        for (size_t i = 0; i < data.size(); ++i) {
-            if (other.data[i] == 0) {
-                throw std::invalid_argument("Cannot divide by zero.");
-            }
-            result.data[i] = data[i] / other.data[i];
-        }
-        return result;
+        evaluate(e);
+        return *this;
     }
 
     /**
-     * @brief Addition assignment operator.
+     * @brief Addition assignment operator, in place.
      *
-     * @param other The other vector to add.
-     * @return Reference to the current vector after addition.
+     * @param other The vector or expression to add.
      */
-    Vector& operator+=(const Vector& other) {
-        *this = *this + other;
-        return *this;
+    template<expr::Operand E>
+    Vector& operator+=(const E& other) {
+        return update<expr::Add>(other);
     }
 
     /**
-     * @brief Subtraction assignment operator.
+     * @brief Subtraction assignment operator, in place.
      *
-     * @param other The other vector to subtract.
-     * @return Reference to the current vector after subtraction.
+     * @param other The vector or expression to subtract.
      */
-    Vector& operator-=(const Vector& other) {
-        *this = *this - other;
-        return *this;
+    template<expr::Operand E>
+    Vector& operator-=(const E& other) {
+        return update<expr::Sub>(other);
     }
 
     /**
-     * @brief Multiplication assignment operator.
+     * @brief Multiplication assignment operator, in place.
      *
-     * @param other The other vector to multiply.
-     * @return Reference to the current vector after multiplication.
+     * @param other The vector or expression to multiply by.
      */
-    Vector& operator*=(const Vector& other) {
-        *this = *this * other;
-        return *this;
+    template<expr::Operand E>
+    Vector& operator*=(const E& other) {
+        return update<expr::Mul>(other);
     }
 
     /**
-     * @brief Division assignment operator.
+     * @brief Division assignment operator, in place.
      *
-     * @param other The other vector to divide.
-     * @return Reference to the current vector after division.
+     * @param other The vector or expression to divide by.
+     * @throws std::invalid_argument if other holds a zero.
      */
-    Vector& operator/=(const Vector& other) {
-        *this = *this / other;
-        return *this;
+    template<expr::Operand E>
+    Vector& operator/=(const E& other) {
+        return update<expr::Div>(other);
     }
-    
+
+    /**
+     * @brief Adds a scalar in place, broadcast to every element.
+     */
+    Vector& operator+=(const T& scalar) {
+        return update<expr::Add>(expr::Scalar<T>(scalar));
+    }
+
+    /**
+     * @brief Subtracts a scalar in place, broadcast to every element.
+     */
+    Vector& operator-=(const T& scalar) {
+        return update<expr::Sub>(expr::Scalar<T>(scalar));
+    }
+
+    /**
+     * @brief Multiplies by a scalar in place, broadcast to every element.
+     */
+    Vector& operator*=(const T& scalar) {
+        return update<expr::Mul>(expr::Scalar<T>(scalar));
+    }
+
+    /**
+     * @brief Divides by a scalar in place, broadcast to every element.
+     *
+     * @throws std::invalid_argument if the scalar is zero.
+     */
+    Vector& operator/=(const T& scalar) {
+        return update<expr::Div>(expr::Scalar<T>(scalar));
+    }
+
     /**
      * @brief Get data
+     * @return Read-only view of the elements, without copying them.
      */
-    inline std::vector<T> getData() const {
-        return data;
+    VectorView<const T> getData() const {
+        return view();
+    }
+
+    /**
+     * @brief Returns a view of all elements.
+     */
+    VectorView<T> view() {
+        return VectorView<T>(data.leak(), data.size());
+    }
+
+    /**
+     * @brief Returns a read-only view of all elements.
+     */
+    VectorView<const T> view() const noexcept {
+        return VectorView<const T>(data.data(), data.size());
+    }
+
+    /**
+     * @brief Returns a view of count elements starting at offset.
+     *
+     * @throws std::out_of_range if the range does not fit.
+     */
+    VectorView<T> slice(size_t offset, size_t count) {
+        return view().slice(offset, count);
+    }
+
+    /**
+     * @brief Returns a read-only view of count elements starting at offset.
+     *
+     * @throws std::out_of_range if the range does not fit.
+     */
+    VectorView<const T> slice(size_t offset, size_t count) const {
+        return view().slice(offset, count);
+    }
+
+    /**
+     * @brief Returns a view of count elements starting at offset, step apart.
+     *
+     * @throws std::out_of_range if the range does not fit or step is zero.
+     */
+    StridedView<T> slice(size_t offset, size_t count, size_t step) {
+        return view().slice(offset, count, step);
+    }
+
+    /**
+     * @brief Returns a read-only view of count elements starting at offset, step apart.
+     *
+     * @throws std::out_of_range if the range does not fit or step is zero.
+     */
+    StridedView<const T> slice(size_t offset, size_t count, size_t step) const {
+        return view().slice(offset, count, step);
     }
 
     /**
@@ -315,27 +386,112 @@ public:
     }
 
     /**
-     * @brief Const subscript operator.
+     * @brief Returns the memory resource the elements were allocated from.
+     */
+    std::pmr::memory_resource* resource() const noexcept {
+        return data.resource();
+    }
+
+    /**
+     * @brief Distance between consecutive elements, always 1.
+     */
+    static constexpr size_t stride() noexcept {
+        return 1;
+    }
+
+    /**
+     * @brief Returns a pointer to the first element.
+     */
+    T* begin() {
+        return data.leak();
+    }
+
+    /**
+     * @brief Returns a const pointer to the first element.
+     */
+    const T* begin() const noexcept {
+        return data.data();
+    }
+
+    /**
+     * @brief Returns a pointer one past the last element.
+     */
+    T* end() {
+        return begin() + data.size();
+    }
+
+    /**
+     * @brief Returns a pointer for filling the elements.
+     *
+     * Unlike begin() this does not stop later copies from sharing the
+     * elements, so the pointer is only good until the vector is next copied.
+     */
+    T* mutableData() {
+        return data.mutableData();
+    }
+
+    /**
+     * @brief Returns a const pointer one past the last element.
+     */
+    const T* end() const noexcept {
+        return data.data() + data.size();
+    }
+
+    /**
+     * @brief Subscript operator.
      *
      * @param index Index of the element to access.
      * @return Reference to the element at the specified index.
+     * @throws std::out_of_range if index >= size() and Bounds checks indices.
      */
-    T& operator[](size_t index){
-        if (index >= data.size()) {
-            throw std::out_of_range("Index out of range.");
-        }
-        return data[index];
+    T& operator[](size_t index) {
+        checkIndex<Bounds>(index, data.size());
+        return data.leak()[index];
     }
-    
+
     /**
      * @brief Const subscript operator.
-     * 
+     *
+     * @param index Index of the element to access.
+     * @return Const reference to the element at the specified index.
+     * @throws std::out_of_range if index >= size() and Bounds checks indices.
+     */
+    const T& operator[](size_t index) const {
+        checkIndex<Bounds>(index, data.size());
+        return data.data()[index];
+    }
+
+    /**
+     * @brief Element access without a bounds check, for inner loops.
+     */
+    T& unchecked(size_t index) {
+        return data.leak()[index];
+    }
+
+    /**
+     * @brief Const element access without a bounds check, for inner loops.
+     */
+    const T& unchecked(size_t index) const noexcept {
+        return data.data()[index];
+    }
+
+    /**
+     * @brief Copy assignment, shares the elements of other.
+     *
      * @param other The vector
      */
     Vector& operator=(const Vector& other) {
-        if (this != &other) {
-            data = other.data;
-        }
+        data = other.data;
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment, takes over the elements of other.
+     *
+     * @param other The vector to move from; left empty.
+     */
+    Vector& operator=(Vector&& other) noexcept {
+        data = std::move(other.data);
         return *this;
     }
 
@@ -346,7 +502,7 @@ public:
      * @param vector Vector to extract from the stream.
      */
     friend std::istream& operator>>(std::istream& is, Vector& vector) {
-        for (auto& elem : vector.data) {
+        for (auto& elem : vector) {
             is >> elem;
         }
         return is;
@@ -356,7 +512,313 @@ public:
      * @param os Output stream.
      * @param vec Vector to insert into the stream.
      */
-    friend std::ostream& operator<<(std::ostream& os, const Vector<T>& vec) {
+    friend std::ostream& operator<<(std::ostream& os, const Vector& vec) {
+        for (const auto& element : vec) {
+            os << element << ' ';
+        }
+        return os;
+    }
+
+private:
+    /// Left uninitialized on allocation, so the kernel that first writes the
+    /// elements (in parallel for long vectors) also places the pages.
+    SharedBuffer<T> data;
+
+    /**
+     * @brief Writes every element from e; shared elements are replaced, not copied.
+     */
+    template<typename E>
+    void evaluate(const E& e) {
+        expr::evaluate(e, data.overwrite());
+    }
+
+    template<typename Op, typename E>
+    Vector& update(const E& other) {
+        // Building the node checks sizes and divisors before anything is written.
+        const expr::Binary<Op, expr::Leaf<T>, expr::OperandType<E>> e(expr::operand(*this), expr::operand(other));
+        evaluate(e);
+        return *this;
+    }
+};
+
+/**
+ * @class Vector
+ * @brief A vector with N elements stored inline.
+ *
+ * @tparam T The type of elements stored in the vector.
+ * @tparam N Number of elements, fixed at compile time.
+ * @tparam Bounds Whether operator[] checks indices.
+ *
+ * Small geometry vectors never touch the heap, every elementwise operation
+ * is unrolled over a compile-time index pack, and mixing sizes is a
+ * compile error instead of a run-time exception. All operations are
+ * constexpr.
+ */
+template<typename T, size_t N, typename Bounds>
+class Vector final {
+    static_assert(N > 0, "Fixed-size vector must have at least one element.");
+
+public:
+    /**
+     * @brief Default constructor, all elements are zero.
+     */
+    constexpr Vector() = default;
+
+    /**
+     * @brief Constructor from exactly N elements.
+     */
+    template<typename... Args>
+        requires (sizeof...(Args) == N && (std::is_convertible_v<Args, T> && ...))
+    constexpr Vector(Args... args) : data{static_cast<T>(args)...} {}
+
+    /**
+     * @brief Converting constructor from a dynamic vector.
+     *
+     * @throws std::invalid_argument if the sizes differ.
+     */
+    explicit Vector(const Vector<T>& other) {
+        if (other.size() != N) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+        std::copy(other.begin(), other.end(), data);
+    }
+
+    /**
+     * @brief Builds a vector from f(0), ..., f(N - 1).
+     */
+    template<typename F>
+    static constexpr Vector generate(F&& f) {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return Vector(static_cast<T>(f(I))...);
+        }(std::make_index_sequence<N>{});
+    }
+
+    /**
+     * @brief Returns a vector with every element equal to value.
+     */
+    static constexpr Vector filled(const T& value) {
+        return generate([&](size_t) { return value; });
+    }
+
+    /**
+     * @brief Copies the elements into a dynamic vector.
+     */
+    Vector<T> toDynamic() const {
+        Vector<T> result(N);
+        std::copy(data, data + N, result.begin());
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    static constexpr size_t size() noexcept {
+        return N;
+    }
+
+    /**
+     * @brief Returns a pointer to the first element.
+     */
+    constexpr T* begin() noexcept {
+        return data;
+    }
+
+    /**
+     * @brief Returns a const pointer to the first element.
+     */
+    constexpr const T* begin() const noexcept {
+        return data;
+    }
+
+    /**
+     * @brief Returns a pointer one past the last element.
+     */
+    constexpr T* end() noexcept {
+        return data + N;
+    }
+
+    /**
+     * @brief Returns a const pointer one past the last element.
+     */
+    constexpr const T* end() const noexcept {
+        return data + N;
+    }
+
+    /**
+     * @brief Subscript operator.
+     *
+     * @throws std::out_of_range if index >= N and Bounds checks indices.
+     */
+    constexpr T& operator[](size_t index) {
+        checkIndex<Bounds>(index, N);
+        return data[index];
+    }
+
+    /**
+     * @brief Const subscript operator.
+     *
+     * @throws std::out_of_range if index >= N and Bounds checks indices.
+     */
+    constexpr const T& operator[](size_t index) const {
+        checkIndex<Bounds>(index, N);
+        return data[index];
+    }
+
+    /**
+     * @brief Element access without a bounds check.
+     */
+    constexpr T& unchecked(size_t index) noexcept {
+        return data[index];
+    }
+
+    /**
+     * @brief Const element access without a bounds check.
+     */
+    constexpr const T& unchecked(size_t index) const noexcept {
+        return data[index];
+    }
+
+    /**
+     * @brief Unchecked element access with a compile-time index.
+     */
+    template<size_t I>
+    constexpr const T& get() const noexcept {
+        static_assert(I < N, "Index out of range.");
+        return data[I];
+    }
+
+    /**
+     * @brief Equality operator.
+     */
+    constexpr bool operator==(const Vector& other) const {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return ((data[I] == other.data[I]) && ...);
+        }(std::make_index_sequence<N>{});
+    }
+
+    /**
+     * @brief Inequality operator.
+     */
+    constexpr bool operator!=(const Vector& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Addition operator.
+     */
+    constexpr Vector operator+(const Vector& other) const {
+        return zip(other, [](const T& a, const T& b) { return a + b; });
+    }
+
+    /**
+     * @brief Subtraction operator.
+     */
+    constexpr Vector operator-(const Vector& other) const {
+        return zip(other, [](const T& a, const T& b) { return a - b; });
+    }
+
+    /**
+     * @brief Unary minus.
+     */
+    constexpr Vector operator-() const {
+        return generate([&](size_t i) { return -data[i]; });
+    }
+
+    /**
+     * @brief Elementwise product.
+     */
+    constexpr Vector operator*(const Vector& other) const {
+        return zip(other, [](const T& a, const T& b) { return a * b; });
+    }
+
+    /**
+     * @brief Elementwise quotient.
+     *
+     * @throws std::invalid_argument if other holds a zero.
+     */
+    constexpr Vector operator/(const Vector& other) const {
+        if (other.hasZero()) {
+            throw std::invalid_argument("Cannot divide by zero.");
+        }
+        return zip(other, [](const T& a, const T& b) { return a / b; });
+    }
+
+    /**
+     * @brief Multiplication by a scalar.
+     */
+    constexpr Vector operator*(const T& scalar) const {
+        return generate([&](size_t i) { return data[i] * scalar; });
+    }
+
+    /**
+     * @brief Multiplication of a scalar by a vector.
+     */
+    friend constexpr Vector operator*(const T& scalar, const Vector& vec) {
+        return vec * scalar;
+    }
+
+    /**
+     * @brief Division by a scalar.
+     *
+     * @throws std::invalid_argument if scalar is zero.
+     */
+    constexpr Vector operator/(const T& scalar) const {
+        if (scalar == T(0)) {
+            throw std::invalid_argument("Cannot divide by zero.");
+        }
+        return generate([&](size_t i) { return data[i] / scalar; });
+    }
+
+    /**
+     * @brief Addition assignment operator.
+     */
+    constexpr Vector& operator+=(const Vector& other) {
+        return *this = *this + other;
+    }
+
+    /**
+     * @brief Subtraction assignment operator.
+     */
+    constexpr Vector& operator-=(const Vector& other) {
+        return *this = *this - other;
+    }
+
+    /**
+     * @brief Elementwise multiplication assignment operator.
+     */
+    constexpr Vector& operator*=(const Vector& other) {
+        return *this = *this * other;
+    }
+
+    /**
+     * @brief Elementwise division assignment operator.
+     */
+    constexpr Vector& operator/=(const Vector& other) {
+        return *this = *this / other;
+    }
+
+    /**
+     * @brief Dot product.
+     */
+    constexpr T dot(const Vector& other) const {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return ((data[I] * other.data[I]) + ...);
+        }(std::make_index_sequence<N>{});
+    }
+
+    /**
+     * @brief Cross product of two 3-vectors.
+     */
+    constexpr Vector cross(const Vector& other) const requires (N == 3) {
+        return Vector(data[1] * other.data[2] - data[2] * other.data[1],
+                      data[2] * other.data[0] - data[0] * other.data[2],
+                      data[0] * other.data[1] - data[1] * other.data[0]);
+    }
+
+    /**
+     * @brief Stream insertion operator.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const Vector& vec) {
         for (const auto& element : vec.data) {
             os << element << ' ';
         }
@@ -364,7 +826,18 @@ public:
     }
 
 private:
-    std::vector<T> data; ///< Container for storing elements of type T.
+    T data[N]{}; ///< Inline storage.
+
+    template<typename F>
+    constexpr Vector zip(const Vector& other, F f) const {
+        return generate([&](size_t i) { return f(data[i], other.data[i]); });
+    }
+
+    constexpr bool hasZero() const {
+        return [&]<size_t... I>(std::index_sequence<I...>) {
+            return ((data[I] == T(0)) || ...);
+        }(std::make_index_sequence<N>{});
+    }
 };
 
 #endif // VECTOR_H
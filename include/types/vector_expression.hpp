@@ -0,0 +1,682 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef VECTOR_EXPRESSION_H
+#define VECTOR_EXPRESSION_H
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../kernels/convert.hpp"
+#include "../kernels/parallel.hpp"
+#include "../kernels/simd.hpp"
+#include "bounds.hpp"
+
+/**
+ * @brief Size marker for vectors and matrices whose extent is only known at run time.
+ */
+inline constexpr size_t Dynamic = static_cast<size_t>(-1);
+
+/**
+ * @brief Mathematical vector with N elements, or a run-time size when N is Dynamic.
+ *
+ * Bounds is the element access policy: Checked, DebugChecked or Unchecked.
+ */
+template<typename T, size_t N = Dynamic, typename Bounds = Checked>
+class Vector;
+
+template<typename T, typename Bounds = Checked>
+class VectorView;
+
+template<typename T>
+class StridedView;
+
+/**
+ * @brief Lazy elementwise expressions over dynamic vectors.
+ *
+ * `a + b * c - d` builds a small tree of nodes that hold raw pointers to
+ * the operands instead of three temporaries. The tree is evaluated in a
+ * single loop when it is assigned to a Vector, so the whole expression
+ * costs one pass over memory and one allocation at most. Sizes are
+ * checked, and divisors scanned for zeros, when a node is built, so
+ * errors surface at the same point as with eager operators.
+ *
+ * Nodes refer to their leaves, so an expression must be assigned before
+ * the vectors it reads go out of scope; do not keep one in an `auto`
+ * variable past the end of the statement that built it from temporaries.
+ */
+namespace expr {
+
+/**
+ * @brief A dynamic vector seen as an expression.
+ */
+template<typename T>
+class Leaf {
+public:
+    using value_type = T;
+
+    Leaf(const T* ptr, size_t n) : ptr(ptr), n(n) {}
+
+    size_t size() const {
+        return n;
+    }
+
+    const T& operator[](size_t i) const {
+        return ptr[i];
+    }
+
+    const T* data() const {
+        return ptr;
+    }
+
+private:
+    const T* ptr;
+    size_t n;
+};
+
+/**
+ * @brief Elements spaced stride apart, such as a matrix column, seen as an expression.
+ */
+template<typename T>
+class StridedLeaf {
+public:
+    using value_type = T;
+
+    StridedLeaf(const T* ptr, size_t n, size_t stride) : ptr(ptr), n(n), step(stride) {}
+
+    size_t size() const {
+        return n;
+    }
+
+    const T& operator[](size_t i) const {
+        return ptr[i * step];
+    }
+
+    const T* data() const {
+        return ptr;
+    }
+
+    size_t stride() const {
+        return step;
+    }
+
+private:
+    const T* ptr;
+    size_t n;
+    size_t step;
+};
+
+/**
+ * @brief A scalar broadcast to every element of the other operand.
+ */
+template<typename T>
+class Scalar {
+public:
+    using value_type = T;
+
+    explicit Scalar(const T& value) : value(value) {}
+
+    const T& operator[](size_t) const {
+        return value;
+    }
+
+private:
+    T value;
+};
+
+template<typename X>
+struct IsScalar : std::false_type {};
+
+template<typename T>
+struct IsScalar<Scalar<T>> : std::true_type {};
+
+struct Add {
+    static constexpr kernels::BinaryOp kind = kernels::BinaryOp::Add;
+
+    template<typename T>
+    static T apply(const T& a, const T& b) {
+        return a + b;
+    }
+};
+
+struct Sub {
+    static constexpr kernels::BinaryOp kind = kernels::BinaryOp::Sub;
+
+    template<typename T>
+    static T apply(const T& a, const T& b) {
+        return a - b;
+    }
+};
+
+struct Mul {
+    static constexpr kernels::BinaryOp kind = kernels::BinaryOp::Mul;
+
+    template<typename T>
+    static T apply(const T& a, const T& b) {
+        return a * b;
+    }
+};
+
+struct Div {
+    static constexpr kernels::BinaryOp kind = kernels::BinaryOp::Div;
+
+    template<typename T>
+    static T apply(const T& a, const T& b) {
+        return a / b;
+    }
+};
+
+struct Mod {
+    template<typename T>
+    static T apply(const T& a, const T& b) {
+        return a % b;
+    }
+};
+
+/**
+ * @brief Returns true if any element of e equals zero.
+ *
+ * The scan has no early exit so that it vectorizes like the main loop;
+ * plain vectors go through the explicit SIMD kernel.
+ */
+template<typename E>
+bool hasZero(const E& e) {
+    using T = typename E::value_type;
+    if constexpr (IsScalar<E>::value) {
+        return e[0] == T(0);
+    } else if constexpr (std::is_same_v<E, Leaf<T>> && kernels::kSimdElement<T>) {
+        return kernels::anyZero(e.size(), e.data());
+    } else {
+        bool zero = false;
+        for (size_t i = 0; i < e.size(); ++i) {
+            zero |= e[i] == T(0);
+        }
+        return zero;
+    }
+}
+
+/**
+ * @brief Elementwise binary operation Op(l[i], r[i]); either side may be a Scalar.
+ */
+template<typename Op, typename L, typename R>
+class Binary {
+public:
+    using value_type = typename L::value_type;
+    using Operation = Op;
+
+    /**
+     * @throws std::invalid_argument if the sizes differ, or on a zero divisor.
+     */
+    Binary(const L& l, const R& r) : l(l), r(r) {
+        if constexpr (!IsScalar<L>::value && !IsScalar<R>::value) {
+            if (l.size() != r.size()) {
+                throw std::invalid_argument("Vectors must have the same size.");
+            }
+        }
+        if constexpr (std::is_same_v<Op, Div>) {
+            if (hasZero(r)) {
+                throw std::invalid_argument("Cannot divide by zero.");
+            }
+        }
+    }
+
+    size_t size() const {
+        if constexpr (IsScalar<L>::value) {
+            return r.size();
+        } else {
+            return l.size();
+        }
+    }
+
+    value_type operator[](size_t i) const {
+        return Op::apply(l[i], r[i]);
+    }
+
+    const L& left() const {
+        return l;
+    }
+
+    const R& right() const {
+        return r;
+    }
+
+private:
+    L l;
+    R r;
+};
+
+template<typename X>
+struct IsNode : std::false_type {};
+
+template<typename Op, typename L, typename R>
+struct IsNode<Binary<Op, L, R>> : std::true_type {};
+
+template<typename X>
+struct IsVector : std::false_type {};
+
+template<typename T, typename B>
+struct IsVector<::Vector<T, Dynamic, B>> : std::true_type {};
+
+template<typename X>
+struct IsView : std::false_type {};
+
+template<typename T, typename B>
+struct IsView<::VectorView<T, B>> : std::true_type {};
+
+template<typename T>
+struct IsView<::StridedView<T>> : std::true_type {};
+
+/**
+ * @brief An unevaluated expression node.
+ */
+template<typename X>
+concept Node = IsNode<X>::value;
+
+/**
+ * @brief Anything that can appear in a vector expression.
+ */
+template<typename X>
+concept Operand = Node<X> || IsVector<X>::value || IsView<X>::value;
+
+template<typename T, typename B>
+Leaf<T> operand(const ::Vector<T, Dynamic, B>& v) {
+    return Leaf<T>(v.begin(), v.size());
+}
+
+template<typename T, typename B>
+Leaf<std::remove_const_t<T>> operand(const ::VectorView<T, B>& v) {
+    return Leaf<std::remove_const_t<T>>(v.begin(), v.size());
+}
+
+template<typename T>
+StridedLeaf<std::remove_const_t<T>> operand(const ::StridedView<T>& v) {
+    return StridedLeaf<std::remove_const_t<T>>(v.begin(), v.size(), v.stride());
+}
+
+template<Node E>
+const E& operand(const E& e) {
+    return e;
+}
+
+template<typename T>
+const Scalar<T>& operand(const Scalar<T>& s) {
+    return s;
+}
+
+template<typename X>
+using OperandType = std::decay_t<decltype(operand(std::declval<const X&>()))>;
+
+template<typename L, typename R>
+concept Compatible = Operand<std::remove_cvref_t<L>> && Operand<std::remove_cvref_t<R>> &&
+    std::same_as<typename OperandType<L>::value_type, typename OperandType<R>::value_type>;
+
+/**
+ * @brief A vector operand and a scalar of a type convertible to its elements.
+ */
+template<typename V, typename S>
+concept Broadcast = Operand<std::remove_cvref_t<V>> && !Operand<std::remove_cvref_t<S>> &&
+    std::convertible_to<const S&, typename OperandType<V>::value_type>;
+
+/**
+ * @brief A non-const dynamic vector passed as an rvalue, whose buffer can hold a result.
+ */
+template<typename X>
+concept Expiring = !std::is_lvalue_reference_v<X> && !std::is_const_v<std::remove_reference_t<X>> &&
+    IsVector<std::remove_cvref_t<X>>::value;
+
+/**
+ * @brief Returns node unevaluated, unless l or r is an expiring vector.
+ *
+ * In that case node is evaluated into the expiring vector's buffer, which
+ * is then returned, so `f(x) + y * z` allocates nothing beyond the
+ * temporary f(x). Every element only depends on operands at the same
+ * index, so writing over an operand is safe.
+ */
+template<typename L, typename R, typename N>
+auto result(L&& l, R&& r, const N& node) {
+    if constexpr (Expiring<L>) {
+        l = node;
+        return std::remove_cvref_t<L>(std::move(l));
+    } else if constexpr (Expiring<R>) {
+        r = node;
+        return std::remove_cvref_t<R>(std::move(r));
+    } else {
+        return node;
+    }
+}
+
+template<typename Op, typename L, typename R>
+Binary<Op, OperandType<L>, OperandType<R>> make(const L& l, const R& r) {
+    return {operand(l), operand(r)};
+}
+
+template<typename Op, typename L, typename S>
+    requires Broadcast<L, S>
+auto broadcastRight(const L& l, const S& s) {
+    using T = typename OperandType<L>::value_type;
+    return Binary<Op, OperandType<L>, Scalar<T>>(operand(l), Scalar<T>(s));
+}
+
+template<typename Op, typename S, typename R>
+    requires Broadcast<R, S>
+auto broadcastLeft(const S& s, const R& r) {
+    using T = typename OperandType<R>::value_type;
+    return Binary<Op, Scalar<T>, OperandType<R>>(Scalar<T>(s), operand(r));
+}
+
+/**
+ * @brief Matches `a * x` and `x * a` with a plain vector x.
+ */
+template<typename E>
+struct Scaled : std::false_type {};
+
+template<typename T>
+struct Scaled<Binary<Mul, Scalar<T>, Leaf<T>>> : std::true_type {
+    static T factor(const Binary<Mul, Scalar<T>, Leaf<T>>& e) {
+        return e.left()[0];
+    }
+
+    static const T* data(const Binary<Mul, Scalar<T>, Leaf<T>>& e) {
+        return e.right().data();
+    }
+};
+
+template<typename T>
+struct Scaled<Binary<Mul, Leaf<T>, Scalar<T>>> : std::true_type {
+    static T factor(const Binary<Mul, Leaf<T>, Scalar<T>>& e) {
+        return e.right()[0];
+    }
+
+    static const T* data(const Binary<Mul, Leaf<T>, Scalar<T>>& e) {
+        return e.left().data();
+    }
+};
+
+/**
+ * @brief Writes elements [lo, hi) of e into dst[0..hi - lo).
+ *
+ * A single operation on two plain vectors, the common `a + b` case, goes
+ * to the SIMD kernel for the active instruction set, and so do the scaling
+ * `a * x` and the update `a * x + y`. Deeper trees run as one fused loop
+ * that the compiler vectorizes for the baseline target. Half and BFloat16
+ * take the same kernels, which widen to float block by block.
+ */
+template<typename E>
+void evaluateRange(const E& e, size_t lo, size_t hi, typename E::value_type* dst) {
+    using T = typename E::value_type;
+    constexpr bool kernel = kernels::kSimdElement<T> || kernels::kReducedFloat<T>;
+    if constexpr (kernel && Scaled<E>::value) {
+        kernels::fused<kernels::FusedOp::Scal, T>(hi - lo, Scaled<E>::factor(e), T(0), Scaled<E>::data(e) + lo,
+                                                  nullptr, nullptr, dst);
+        return;
+    } else if constexpr (requires { E::Operation::kind; }) {
+        if constexpr (kernel && std::is_same_v<typename E::Operation, Add> &&
+                      Scaled<std::decay_t<decltype(e.left())>>::value &&
+                      std::is_same_v<std::decay_t<decltype(e.right())>, Leaf<T>>) {
+            using S = Scaled<std::decay_t<decltype(e.left())>>;
+            kernels::fused<kernels::FusedOp::Axpy, T>(hi - lo, S::factor(e.left()), T(0), S::data(e.left()) + lo,
+                                                      e.right().data() + lo, nullptr, dst);
+            return;
+        }
+    }
+    if constexpr (requires { E::Operation::kind; }) {
+        constexpr kernels::BinaryOp op = E::Operation::kind;
+        if constexpr (std::is_same_v<E, Binary<typename E::Operation, Leaf<T>, Leaf<T>>> &&
+                      (kernels::kSimdBinary<op, T> || kernels::kReducedFloat<T>)) {
+            kernels::binary<op>(hi - lo, e.left().data() + lo, e.right().data() + lo, dst);
+            return;
+        }
+    }
+    for (size_t i = lo; i < hi; ++i) {
+        dst[i - lo] = e[i];
+    }
+}
+
+/**
+ * @brief Writes e into out[0..e.size()).
+ *
+ * Long arrays are split into page-aligned chunks across the thread pool
+ * according to kernels::activeExecution(); short ones take one serial pass.
+ */
+template<typename E>
+void evaluate(const E& e, typename E::value_type* out) {
+    kernels::forEachChunk(e.size(), out, [&](size_t lo, size_t hi) {
+        evaluateRange(e, lo, hi, out + lo);
+    });
+}
+
+/**
+ * @brief Writes e into out[0], out[stride], ..., for strided destinations.
+ */
+template<typename E>
+void evaluate(const E& e, typename E::value_type* out, size_t stride) {
+    if (stride == 1) {
+        evaluate(e, out);
+        return;
+    }
+    for (size_t i = 0; i < e.size(); ++i) {
+        out[i * stride] = e[i];
+    }
+}
+
+/**
+ * @brief True if n elements step apart from a and from b share memory without lining up.
+ *
+ * Equal ranges are fine to evaluate in place, and so are ranges with the
+ * same step that interleave without touching, such as two matrix columns.
+ */
+template<typename T>
+bool partiallyOverlaps(const T* a, size_t aStep, const T* b, size_t bStep, size_t n) {
+    if (n == 0 || (a == b && aStep == bStep)) {
+        return false;
+    }
+    const auto lo = [](const T* p) { return reinterpret_cast<std::uintptr_t>(p); };
+    const auto hi = [&](const T* p, size_t step) { return lo(p + (n - 1) * step) + sizeof(T); };
+    if (hi(a, aStep) <= lo(b) || hi(b, bStep) <= lo(a)) {
+        return false;
+    }
+    const size_t distance = a < b ? static_cast<size_t>(b - a) : static_cast<size_t>(a - b);
+    return aStep != bStep || distance % aStep == 0;
+}
+
+/**
+ * @brief True if a leaf of e partially overlaps out[0], out[stride], ....
+ *
+ * Evaluation reads element i of every leaf before it writes element i,
+ * so a leaf that is the destination itself is safe. A shifted one is not:
+ * the loop would read elements it has already written, in an order that
+ * depends on the instruction set and on how the work was split.
+ */
+template<typename E>
+bool overlaps(const E& e, const typename E::value_type* out, size_t stride, size_t n) {
+    using T = typename E::value_type;
+    if constexpr (IsNode<E>::value) {
+        return overlaps(e.left(), out, stride, n) || overlaps(e.right(), out, stride, n);
+    } else if constexpr (std::is_same_v<E, Leaf<T>>) {
+        return partiallyOverlaps(e.data(), 1, out, stride, n);
+    } else if constexpr (std::is_same_v<E, StridedLeaf<T>>) {
+        return partiallyOverlaps(e.data(), e.stride(), out, stride, n);
+    } else {
+        return false;
+    }
+}
+
+/**
+ * @brief Writes e into out[0], out[stride], ..., where out may be a view of e's operands.
+ *
+ * When a leaf partially overlaps the destination, e is evaluated into a
+ * temporary first and then copied.
+ */
+template<typename E>
+void assign(const E& e, typename E::value_type* out, size_t stride) {
+    using T = typename E::value_type;
+    if (!overlaps(e, out, stride, e.size())) {
+        evaluate(e, out, stride);
+        return;
+    }
+    std::vector<T> temporary(e.size());
+    evaluate(e, temporary.data());
+    for (size_t i = 0; i < temporary.size(); ++i) {
+        out[i * stride] = temporary[i];
+    }
+}
+
+} // namespace expr
+
+/**
+ * @brief Elementwise sum, evaluated lazily.
+ *
+ * This and the other operators below evaluate at once into the buffer of
+ * an operand that is an expiring vector; see expr::result.
+ */
+template<typename L, typename R>
+    requires expr::Compatible<L, R>
+auto operator+(L&& l, R&& r) {
+    return expr::result(std::forward<L>(l), std::forward<R>(r), expr::make<expr::Add>(l, r));
+}
+
+/**
+ * @brief Elementwise difference, evaluated lazily.
+ */
+template<typename L, typename R>
+    requires expr::Compatible<L, R>
+auto operator-(L&& l, R&& r) {
+    return expr::result(std::forward<L>(l), std::forward<R>(r), expr::make<expr::Sub>(l, r));
+}
+
+/**
+ * @brief Elementwise product, evaluated lazily.
+ */
+template<typename L, typename R>
+    requires expr::Compatible<L, R>
+auto operator*(L&& l, R&& r) {
+    return expr::result(std::forward<L>(l), std::forward<R>(r), expr::make<expr::Mul>(l, r));
+}
+
+/**
+ * @brief Elementwise quotient, evaluated lazily.
+ *
+ * @throws std::invalid_argument if r holds a zero.
+ */
+template<typename L, typename R>
+    requires expr::Compatible<L, R>
+auto operator/(L&& l, R&& r) {
+    return expr::result(std::forward<L>(l), std::forward<R>(r), expr::make<expr::Div>(l, r));
+}
+
+/**
+ * @brief Elementwise remainder, evaluated lazily.
+ */
+template<typename L, typename R>
+    requires expr::Compatible<L, R>
+auto operator%(L&& l, R&& r) {
+    return expr::result(std::forward<L>(l), std::forward<R>(r), expr::make<expr::Mod>(l, r));
+}
+
+/**
+ * @brief Elementwise sum with a scalar broadcast to every element.
+ */
+template<typename L, typename S>
+    requires expr::Broadcast<L, S>
+auto operator+(L&& l, const S& s) {
+    return expr::result(std::forward<L>(l), s, expr::broadcastRight<expr::Add>(l, s));
+}
+
+/**
+ * @brief Elementwise sum of a broadcast scalar and a vector.
+ */
+template<typename S, typename R>
+    requires expr::Broadcast<R, S>
+auto operator+(const S& s, R&& r) {
+    return expr::result(s, std::forward<R>(r), expr::broadcastLeft<expr::Add>(s, r));
+}
+
+/**
+ * @brief Elementwise difference with a scalar broadcast to every element.
+ */
+template<typename L, typename S>
+    requires expr::Broadcast<L, S>
+auto operator-(L&& l, const S& s) {
+    return expr::result(std::forward<L>(l), s, expr::broadcastRight<expr::Sub>(l, s));
+}
+
+/**
+ * @brief Elementwise difference of a broadcast scalar and a vector.
+ */
+template<typename S, typename R>
+    requires expr::Broadcast<R, S>
+auto operator-(const S& s, R&& r) {
+    return expr::result(s, std::forward<R>(r), expr::broadcastLeft<expr::Sub>(s, r));
+}
+
+/**
+ * @brief Elementwise product with a scalar broadcast to every element.
+ */
+template<typename L, typename S>
+    requires expr::Broadcast<L, S>
+auto operator*(L&& l, const S& s) {
+    return expr::result(std::forward<L>(l), s, expr::broadcastRight<expr::Mul>(l, s));
+}
+
+/**
+ * @brief Elementwise product of a broadcast scalar and a vector.
+ */
+template<typename S, typename R>
+    requires expr::Broadcast<R, S>
+auto operator*(const S& s, R&& r) {
+    return expr::result(s, std::forward<R>(r), expr::broadcastLeft<expr::Mul>(s, r));
+}
+
+/**
+ * @brief Elementwise quotient with a scalar broadcast to every element.
+ *
+ * @throws std::invalid_argument if the scalar is zero.
+ */
+template<typename L, typename S>
+    requires expr::Broadcast<L, S>
+auto operator/(L&& l, const S& s) {
+    return expr::result(std::forward<L>(l), s, expr::broadcastRight<expr::Div>(l, s));
+}
+
+/**
+ * @brief Elementwise quotient of a broadcast scalar by a vector.
+ *
+ * @throws std::invalid_argument if r holds a zero.
+ */
+template<typename S, typename R>
+    requires expr::Broadcast<R, S>
+auto operator/(const S& s, R&& r) {
+    return expr::result(s, std::forward<R>(r), expr::broadcastLeft<expr::Div>(s, r));
+}
+
+#endif // VECTOR_EXPRESSION_H
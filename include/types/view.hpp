@@ -0,0 +1,781 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include "vector_expression.hpp"
+#include "../kernels/reduce.hpp"
+
+/**
+ * @class Reductions
+ * @brief Reductions shared by Vector and the vector views.
+ *
+ * @tparam Derived Class providing size(), begin() (pointer to the first
+ *         element) and stride() (distance between consecutive elements).
+ * @tparam T Element type.
+ *
+ * Sums, means and norms are returned as Accumulator, which is float for
+ * Half and BFloat16 elements and T otherwise.
+ */
+template<typename Derived, typename T>
+class Reductions {
+public:
+    using Accumulator = kernels::Widened<T>;
+
+    /**
+     * @brief Dot product with a vector or view of the same size.
+     *
+     * @param other Vector or view of the same size.
+     * @param mode Plain or compensated summation.
+     */
+    template<typename Other>
+        requires expr::IsVector<Other>::value || expr::IsView<Other>::value
+    Accumulator dot(const Other& other, kernels::Summation mode = kernels::Summation::Plain) const {
+        if (self().size() != other.size()) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+        return kernels::dot(self().size(), self().begin(), self().stride(), other.begin(), other.stride(), mode);
+    }
+
+    /**
+     * @brief Dot product with an elementwise expression, evaluated first.
+     */
+    template<expr::Node E>
+    Accumulator dot(const E& e, kernels::Summation mode = kernels::Summation::Plain) const {
+        return dot(Vector<T>(e), mode);
+    }
+
+    /**
+     * @brief Sum of the elements.
+     *
+     * @param mode Plain or compensated summation.
+     */
+    Accumulator sum(kernels::Summation mode = kernels::Summation::Plain) const {
+        return kernels::sum(self().size(), self().begin(), self().stride(), mode);
+    }
+
+    /**
+     * @brief Arithmetic mean of the elements.
+     *
+     * @param mode Plain or compensated summation.
+     * @throws std::invalid_argument if there are no elements.
+     */
+    Accumulator mean(kernels::Summation mode = kernels::Summation::Plain) const requires std::is_floating_point_v<Accumulator> {
+        checkNotEmpty();
+        return sum(mode) / static_cast<Accumulator>(self().size());
+    }
+
+    /**
+     * @brief L1 norm, the sum of absolute values.
+     *
+     * @param mode Plain or compensated summation.
+     */
+    Accumulator norm1(kernels::Summation mode = kernels::Summation::Plain) const {
+        return kernels::asum(self().size(), self().begin(), self().stride(), mode);
+    }
+
+    /**
+     * @brief Euclidean (L2) norm.
+     *
+     * @param mode Plain or compensated summation of the squares.
+     */
+    Accumulator norm2(kernels::Summation mode = kernels::Summation::Plain) const requires std::is_floating_point_v<Accumulator> {
+        return kernels::nrm2(self().size(), self().begin(), self().stride(), mode);
+    }
+
+    /**
+     * @brief L-infinity norm, the largest absolute value; zero when there are no elements.
+     */
+    T normInf() const {
+        return kernels::amax(self().size(), self().begin(), self().stride());
+    }
+
+    /**
+     * @brief Smallest element.
+     *
+     * @throws std::invalid_argument if there are no elements.
+     */
+    T min() const {
+        return extrema().min;
+    }
+
+    /**
+     * @brief Largest element.
+     *
+     * @throws std::invalid_argument if there are no elements.
+     */
+    T max() const {
+        return extrema().max;
+    }
+
+    /**
+     * @brief Index of the first smallest element.
+     *
+     * @throws std::invalid_argument if there are no elements.
+     */
+    size_t argmin() const {
+        return extrema().argmin;
+    }
+
+    /**
+     * @brief Index of the first largest element.
+     *
+     * @throws std::invalid_argument if there are no elements.
+     */
+    size_t argmax() const {
+        return extrema().argmax;
+    }
+
+private:
+    const Derived& self() const {
+        return static_cast<const Derived&>(*this);
+    }
+
+    void checkNotEmpty() const {
+        if (self().size() == 0) {
+            throw std::invalid_argument("Vector is empty.");
+        }
+    }
+
+    kernels::MinMax<T> extrema() const {
+        checkNotEmpty();
+        return kernels::minmax(self().size(), self().begin(), self().stride());
+    }
+};
+
+/**
+ * @class VectorView
+ * @brief Non-owning view of contiguous elements, like std::span.
+ *
+ * @tparam T Element type; const T gives a read-only view.
+ * @tparam Bounds Policy of operator[], taken from the matrix whose row is viewed.
+ *
+ * Views take part in vector expressions and reductions exactly like
+ * Vector. Assigning to a view writes through to the viewed elements
+ * instead of rebinding it.
+ */
+template<typename T, typename Bounds>
+class VectorView final : public Reductions<VectorView<T, Bounds>, std::remove_const_t<T>> {
+public:
+    using value_type = std::remove_const_t<T>;
+
+    /**
+     * @brief Default constructor, an empty view.
+     */
+    VectorView() = default;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param ptr Pointer to the first element.
+     * @param n Number of elements.
+     */
+    VectorView(T* ptr, size_t n) : ptr(ptr), n(n) {}
+
+    VectorView(const VectorView&) = default;
+
+    /**
+     * @brief Conversion to a read-only view, or to a view with another bounds policy.
+     */
+    template<typename U, typename B>
+        requires std::is_convertible_v<T*, U*> && (!std::is_same_v<VectorView<U, B>, VectorView>)
+    operator VectorView<U, B>() const {
+        return VectorView<U, B>(ptr, n);
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_t size() const noexcept {
+        return n;
+    }
+
+    /**
+     * @brief Distance between consecutive elements, always 1.
+     */
+    static constexpr size_t stride() noexcept {
+        return 1;
+    }
+
+    /**
+     * @brief Returns a pointer to the first element.
+     */
+    T* begin() const noexcept {
+        return ptr;
+    }
+
+    /**
+     * @brief Returns the view itself, so views and vectors can be used alike.
+     */
+    VectorView view() const noexcept {
+        return *this;
+    }
+
+    /**
+     * @brief Returns a pointer one past the last element.
+     */
+    T* end() const noexcept {
+        return ptr + n;
+    }
+
+    /**
+     * @brief Subscript operator.
+     *
+     * @throws std::out_of_range if index >= size() and Bounds checks indices.
+     */
+    T& operator[](size_t index) const {
+        checkIndex<Bounds>(index, n);
+        return ptr[index];
+    }
+
+    /**
+     * @brief Element access without a bounds check.
+     */
+    T& unchecked(size_t index) const noexcept {
+        return ptr[index];
+    }
+
+    /**
+     * @brief Returns the view of count elements starting at offset.
+     *
+     * @throws std::out_of_range if the range does not fit.
+     */
+    VectorView slice(size_t offset, size_t count) const {
+        if (offset > n || count > n - offset) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return VectorView(ptr + offset, count);
+    }
+
+    /**
+     * @brief Returns the view of count elements starting at offset, step apart.
+     *
+     * @throws std::out_of_range if the range does not fit or step is zero.
+     */
+    StridedView<T> slice(size_t offset, size_t count, size_t step) const {
+        if (step == 0 || (count > 0 && (offset >= n || (count - 1) > (n - 1 - offset) / step))) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return StridedView<T>(ptr + offset, count, step);
+    }
+
+    /**
+     * @brief Copies the elements of other into the viewed elements.
+     *
+     * @throws std::invalid_argument if the sizes differ.
+     */
+    VectorView& operator=(const VectorView& other) requires (!std::is_const_v<T>) {
+        checkSize(other.size());
+        if (ptr <= other.ptr) {
+            std::copy(other.begin(), other.end(), ptr);
+        } else {
+            std::copy_backward(other.begin(), other.end(), ptr + n);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Evaluates a vector, view or expression into the viewed elements.
+     *
+     * @throws std::invalid_argument if the sizes differ.
+     */
+    template<expr::Operand E>
+    VectorView& operator=(const E& e) requires (!std::is_const_v<T>) {
+        const auto source = expr::operand(e);
+        checkSize(source.size());
+        expr::assign(source, ptr, 1);
+        return *this;
+    }
+
+    /**
+     * @brief Adds a vector, view or expression in place.
+     */
+    template<expr::Operand E>
+    VectorView& operator+=(const E& e) requires (!std::is_const_v<T>) {
+        return update<expr::Add>(e);
+    }
+
+    /**
+     * @brief Subtracts a vector, view or expression in place.
+     */
+    template<expr::Operand E>
+    VectorView& operator-=(const E& e) requires (!std::is_const_v<T>) {
+        return update<expr::Sub>(e);
+    }
+
+    /**
+     * @brief Multiplies by a vector, view or expression in place.
+     */
+    template<expr::Operand E>
+    VectorView& operator*=(const E& e) requires (!std::is_const_v<T>) {
+        return update<expr::Mul>(e);
+    }
+
+    /**
+     * @brief Divides by a vector, view or expression in place.
+     *
+     * @throws std::invalid_argument if e holds a zero.
+     */
+    template<expr::Operand E>
+    VectorView& operator/=(const E& e) requires (!std::is_const_v<T>) {
+        return update<expr::Div>(e);
+    }
+
+    /**
+     * @brief Adds a scalar in place, broadcast to every element.
+     */
+    VectorView& operator+=(const value_type& scalar) requires (!std::is_const_v<T>) {
+        return update<expr::Add>(expr::Scalar<value_type>(scalar));
+    }
+
+    /**
+     * @brief Subtracts a scalar in place, broadcast to every element.
+     */
+    VectorView& operator-=(const value_type& scalar) requires (!std::is_const_v<T>) {
+        return update<expr::Sub>(expr::Scalar<value_type>(scalar));
+    }
+
+    /**
+     * @brief Multiplies by a scalar in place, broadcast to every element.
+     */
+    VectorView& operator*=(const value_type& scalar) requires (!std::is_const_v<T>) {
+        return update<expr::Mul>(expr::Scalar<value_type>(scalar));
+    }
+
+    /**
+     * @brief Divides by a scalar in place, broadcast to every element.
+     *
+     * @throws std::invalid_argument if the scalar is zero.
+     */
+    VectorView& operator/=(const value_type& scalar) requires (!std::is_const_v<T>) {
+        return update<expr::Div>(expr::Scalar<value_type>(scalar));
+    }
+
+private:
+    T* ptr = nullptr;
+    size_t n = 0;
+
+    void checkSize(size_t size) const {
+        if (size != n) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+    }
+
+    template<typename Op, typename E>
+    VectorView& update(const E& e) {
+        const expr::Binary<Op, expr::Leaf<value_type>, expr::OperandType<E>> node(expr::operand(*this), expr::operand(e));
+        expr::assign(node, ptr, 1);
+        return *this;
+    }
+};
+
+/**
+ * @class StridedView
+ * @brief Non-owning view of n elements spaced a fixed stride apart.
+ *
+ * @tparam T Element type; const T gives a read-only view.
+ *
+ * Used for matrix columns and diagonals. begin() returns the first
+ * element for kernels that take a BLAS-style increment; the view is not
+ * an iterator range.
+ */
+template<typename T>
+class StridedView final : public Reductions<StridedView<T>, std::remove_const_t<T>> {
+public:
+    using value_type = std::remove_const_t<T>;
+
+    /**
+     * @brief Default constructor, an empty view.
+     */
+    StridedView() = default;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param ptr Pointer to the first element.
+     * @param n Number of elements.
+     * @param step Distance between consecutive elements.
+     */
+    StridedView(T* ptr, size_t n, size_t step) : ptr(ptr), n(n), step(step) {}
+
+    StridedView(const StridedView&) = default;
+
+    /**
+     * @brief Conversion to a read-only view.
+     */
+    operator StridedView<const T>() const requires (!std::is_const_v<T>) {
+        return StridedView<const T>(ptr, n, step);
+    }
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    size_t size() const noexcept {
+        return n;
+    }
+
+    /**
+     * @brief Returns the distance between consecutive elements.
+     */
+    size_t stride() const noexcept {
+        return step;
+    }
+
+    /**
+     * @brief Returns a pointer to the first element.
+     */
+    T* begin() const noexcept {
+        return ptr;
+    }
+
+    /**
+     * @brief Subscript operator.
+     *
+     * @throws std::out_of_range if index >= size().
+     */
+    T& operator[](size_t index) const {
+        if (index >= n) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return ptr[index * step];
+    }
+
+    /**
+     * @brief Element access without a bounds check.
+     */
+    T& unchecked(size_t index) const noexcept {
+        return ptr[index * step];
+    }
+
+    /**
+     * @brief Copies the elements of other into the viewed elements.
+     *
+     * @throws std::invalid_argument if the sizes differ.
+     */
+    StridedView& operator=(const StridedView& other) requires (!std::is_const_v<T>) {
+        return assign(other);
+    }
+
+    /**
+     * @brief Evaluates a vector, view or expression into the viewed elements.
+     *
+     * @throws std::invalid_argument if the sizes differ.
+     */
+    template<expr::Operand E>
+    StridedView& operator=(const E& e) requires (!std::is_const_v<T>) {
+        return assign(e);
+    }
+
+    /**
+     * @brief Adds a vector, view or expression in place.
+     */
+    template<expr::Operand E>
+    StridedView& operator+=(const E& e) requires (!std::is_const_v<T>) {
+        return update<expr::Add>(e);
+    }
+
+    /**
+     * @brief Subtracts a vector, view or expression in place.
+     */
+    template<expr::Operand E>
+    StridedView& operator-=(const E& e) requires (!std::is_const_v<T>) {
+        return update<expr::Sub>(e);
+    }
+
+    /**
+     * @brief Multiplies by a vector, view or expression in place.
+     */
+    template<expr::Operand E>
+    StridedView& operator*=(const E& e) requires (!std::is_const_v<T>) {
+        return update<expr::Mul>(e);
+    }
+
+    /**
+     * @brief Divides by a vector, view or expression in place.
+     *
+     * @throws std::invalid_argument if e holds a zero.
+     */
+    template<expr::Operand E>
+    StridedView& operator/=(const E& e) requires (!std::is_const_v<T>) {
+        return update<expr::Div>(e);
+    }
+
+    /**
+     * @brief Adds a scalar in place, broadcast to every element.
+     */
+    StridedView& operator+=(const value_type& scalar) requires (!std::is_const_v<T>) {
+        return update<expr::Add>(expr::Scalar<value_type>(scalar));
+    }
+
+    /**
+     * @brief Subtracts a scalar in place, broadcast to every element.
+     */
+    StridedView& operator-=(const value_type& scalar) requires (!std::is_const_v<T>) {
+        return update<expr::Sub>(expr::Scalar<value_type>(scalar));
+    }
+
+    /**
+     * @brief Multiplies by a scalar in place, broadcast to every element.
+     */
+    StridedView& operator*=(const value_type& scalar) requires (!std::is_const_v<T>) {
+        return update<expr::Mul>(expr::Scalar<value_type>(scalar));
+    }
+
+    /**
+     * @brief Divides by a scalar in place, broadcast to every element.
+     *
+     * @throws std::invalid_argument if the scalar is zero.
+     */
+    StridedView& operator/=(const value_type& scalar) requires (!std::is_const_v<T>) {
+        return update<expr::Div>(expr::Scalar<value_type>(scalar));
+    }
+
+private:
+    T* ptr = nullptr;
+    size_t n = 0;
+    size_t step = 1;
+
+    template<typename E>
+    StridedView& assign(const E& e) {
+        const auto source = expr::operand(e);
+        if (source.size() != n) {
+            throw std::invalid_argument("Vectors must have the same size.");
+        }
+        expr::assign(source, ptr, step);
+        return *this;
+    }
+
+    template<typename Op, typename E>
+    StridedView& update(const E& e) {
+        const expr::Binary<Op, expr::StridedLeaf<value_type>, expr::OperandType<E>> node(expr::operand(*this),
+                                                                                        expr::operand(e));
+        expr::assign(node, ptr, step);
+        return *this;
+    }
+};
+
+/**
+ * @class MatrixView
+ * @brief Non-owning view of a row-major block with a leading dimension.
+ *
+ * @tparam T Element type; const T gives a read-only view.
+ *
+ * Element (i, j) lives at data()[i * leadingDimension() + j], so a view
+ * can describe a whole matrix or any rectangular block of one, and hand
+ * it to the kernels without copying. Assigning to a view writes through.
+ */
+template<typename T>
+class MatrixView final {
+public:
+    using value_type = std::remove_const_t<T>;
+
+    /**
+     * @brief Default constructor, an empty view.
+     */
+    MatrixView() = default;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param ptr Pointer to element (0, 0).
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param ld Distance between consecutive rows.
+     */
+    MatrixView(T* ptr, size_t rows, size_t cols, size_t ld) : ptr(ptr), rows(rows), cols(cols), ld(ld) {}
+
+    MatrixView(const MatrixView&) = default;
+
+    /**
+     * @brief Conversion to a read-only view.
+     */
+    operator MatrixView<const T>() const requires (!std::is_const_v<T>) {
+        return MatrixView<const T>(ptr, rows, cols, ld);
+    }
+
+    /**
+     * @brief Returns the number of rows.
+     */
+    int getRows() const {
+        return static_cast<int>(rows);
+    }
+
+    /**
+     * @brief Returns the number of columns.
+     */
+    int getCols() const {
+        return static_cast<int>(cols);
+    }
+
+    /**
+     * @brief Returns the distance between consecutive rows.
+     */
+    size_t leadingDimension() const noexcept {
+        return ld;
+    }
+
+    /**
+     * @brief Returns a pointer to element (0, 0).
+     */
+    T* data() const noexcept {
+        return ptr;
+    }
+
+    /**
+     * @brief Subscript operator, returns row index.
+     *
+     * @throws std::out_of_range if index >= getRows().
+     */
+    VectorView<T> operator[](size_t index) const {
+        return row(index);
+    }
+
+    /**
+     * @brief Element (i, j) without a bounds check.
+     */
+    T& unchecked(size_t i, size_t j) const noexcept {
+        return ptr[i * ld + j];
+    }
+
+    /**
+     * @brief Returns row i.
+     *
+     * @throws std::out_of_range if i >= getRows().
+     */
+    VectorView<T> row(size_t i) const {
+        if (i >= rows) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return VectorView<T>(ptr + i * ld, cols);
+    }
+
+    /**
+     * @brief Returns column j.
+     *
+     * @throws std::out_of_range if j >= getCols().
+     */
+    StridedView<T> col(size_t j) const {
+        if (j >= cols) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return StridedView<T>(ptr + j, rows, ld);
+    }
+
+    /**
+     * @brief Returns the main diagonal.
+     */
+    StridedView<T> diagonal() const {
+        return StridedView<T>(ptr, std::min(rows, cols), ld + 1);
+    }
+
+    /**
+     * @brief Returns the block of rowCount x colCount elements at (row, col).
+     *
+     * @throws std::out_of_range if the block does not fit.
+     */
+    MatrixView block(size_t row, size_t col, size_t rowCount, size_t colCount) const {
+        if (row > rows || col > cols || rowCount > rows - row || colCount > cols - col) {
+            throw std::out_of_range("Index out of range.");
+        }
+        return MatrixView(ptr + row * ld + col, rowCount, colCount, ld);
+    }
+
+    /**
+     * @brief Copies the elements of other into the viewed elements.
+     *
+     * @throws std::invalid_argument if the shapes differ.
+     */
+    MatrixView& operator=(const MatrixView& other) requires (!std::is_const_v<T>) {
+        return rowwise(other, [](VectorView<T> dst, auto src) { dst = src; });
+    }
+
+    /**
+     * @brief Copies a matrix or another view into the viewed elements.
+     *
+     * @throws std::invalid_argument if the shapes differ.
+     */
+    template<typename M>
+    MatrixView& operator=(const M& other) requires (!std::is_const_v<T>) {
+        return rowwise(other, [](VectorView<T> dst, auto src) { dst = src; });
+    }
+
+    /**
+     * @brief Adds a matrix or another view in place.
+     */
+    template<typename M>
+    MatrixView& operator+=(const M& other) requires (!std::is_const_v<T>) {
+        return rowwise(other, [](VectorView<T> dst, auto src) { dst += src; });
+    }
+
+    /**
+     * @brief Subtracts a matrix or another view in place.
+     */
+    template<typename M>
+    MatrixView& operator-=(const M& other) requires (!std::is_const_v<T>) {
+        return rowwise(other, [](VectorView<T> dst, auto src) { dst -= src; });
+    }
+
+private:
+    T* ptr = nullptr;
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t ld = 0;
+
+    /**
+     * @brief Applies f(row of this, row of other) to every row.
+     *
+     * When other is a block of the same matrix further up, destination
+     * row i may cover source row i + 1, so the rows are then visited
+     * bottom-up to read each source row before it is overwritten. Overlap
+     * within a row is left to the row views.
+     */
+    template<typename M, typename F>
+    MatrixView& rowwise(const M& other, F f) {
+        if (other.getRows() != getRows() || other.getCols() != getCols()) {
+            throw std::invalid_argument("Matrices must have the same size.");
+        }
+        if (rows > 0 && std::less<const value_type*>()(other[0].begin(), ptr)) {
+            for (size_t i = rows; i-- > 0;) {
+                f(row(i), other[i]);
+            }
+        } else {
+            for (size_t i = 0; i < rows; ++i) {
+                f(row(i), other[i]);
+            }
+        }
+        return *this;
+    }
+};
+
+#endif // VIEW_H
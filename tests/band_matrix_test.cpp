@@ -0,0 +1,140 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/linalg/band_lu.hpp"
+
+// Случайная ленточная матрица; diagonal усиливает главную диагональ
+static BandMatrix<double> randomBand(size_t n, size_t kl, size_t ku, unsigned seed, double diagonal = 0.0) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    BandMatrix<double> band(n, kl, ku);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = band.first(i); j < band.last(i); ++j) {
+            band(i, j) = dist(gen);
+        }
+        band(i, i) += diagonal;
+    }
+    return band;
+}
+
+// Тест для упаковки и распаковки
+TEST(BandMatrixTest, DenseRoundTrip) {
+    Matrix<int> dense(4, 4);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            dense[i][j] = 10 * i + j + 1;
+        }
+    }
+
+    BandMatrix<int> band = BandMatrix<int>::fromDense(dense, 1, 2);
+    Matrix<int> packed = band.toDense();
+
+    EXPECT_EQ(band.getLower(), 1u);
+    EXPECT_EQ(band.getUpper(), 2u);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            const bool inside = j - i <= 2 && i - j <= 1;
+            EXPECT_EQ(packed[i][j], inside ? dense[i][j] : 0);
+            EXPECT_EQ(band.at(i, j), packed[i][j]);
+        }
+    }
+}
+
+// Тест для умножения на вектор
+TEST(BandMatrixTest, MatrixVectorProduct) {
+    BandMatrix<double> band = randomBand(200, 3, 5, 1);
+    Matrix<double> dense = band.toDense();
+    Vector<double> x(200);
+    for (size_t i = 0; i < 200; ++i) {
+        x[i] = 0.5 * i;
+    }
+
+    Vector<double> y = band * x;
+    Vector<double> expected = dense * x;
+    for (size_t i = 0; i < 200; ++i) {
+        EXPECT_NEAR(y[i], expected[i], 1e-10);
+    }
+}
+
+// Тест для решения систем с выбором ведущего элемента
+TEST(BandMatrixTest, Solve) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const size_t n = 500;
+    BandMatrix<double> band = randomBand(n, 4, 2, 2, 3.0);
+    Vector<double> b(n);
+    Matrix<double> rhs(n, 300);
+    for (size_t i = 0; i < n; ++i) {
+        b[i] = 1.0 + i % 7;
+        for (size_t j = 0; j < 300; ++j) {
+            rhs[i][j] = std::sin(static_cast<double>(i + j));
+        }
+    }
+
+    Vector<double> r = band * solve(band, b);
+    Matrix<double> x = solve(band, rhs);
+    Matrix<double> check = band.toDense() * x;
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(r[i], b[i], 1e-8);
+        for (size_t j = 0; j < 300; ++j) {
+            EXPECT_NEAR(check[i][j], rhs[i][j], 1e-8);
+        }
+    }
+
+    pool.resize(threads);
+}
+
+// Тест для определителя и вырожденной матрицы
+TEST(BandMatrixTest, DeterminantAndSingular) {
+    Matrix<double> dense(3, 3);
+    dense[0][0] = 0; dense[0][1] = 2;
+    dense[1][0] = 1; dense[1][1] = 1; dense[1][2] = 3;
+    dense[2][1] = 4; dense[2][2] = 5;
+    BandLU<double> lu(BandMatrix<double>::fromDense(dense, 1, 1));
+    // det = 0 * (5 - 12) - 2 * (5 - 0) = -10
+    EXPECT_NEAR(lu.det(), -10.0, 1e-12);
+    EXPECT_FALSE(lu.isSingular());
+
+    BandLU<double> singular(BandMatrix<double>(3, 1, 1));
+    EXPECT_TRUE(singular.isSingular());
+    EXPECT_EQ(singular.det(), 0.0);
+    EXPECT_THROW(singular.solve(Vector<double>(3)), std::invalid_argument);
+    EXPECT_THROW(lu.solve(Vector<double>(2)), std::invalid_argument);
+    EXPECT_THROW(BandMatrix<double>(3, 0, 0)(0, 1), std::out_of_range);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
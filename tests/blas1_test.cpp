@@ -0,0 +1,126 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include "../include/linalg/blas1.hpp"
+
+namespace {
+
+Vector<double> iota(size_t n, double start) {
+    Vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = start + static_cast<double>(i);
+    }
+    return v;
+}
+
+} // namespace
+
+// Тест для axpy и axpby
+TEST(Blas1Test, AxpyAxpby) {
+    const Vector<double> x = iota(37, 1.0);
+    Vector<double> y = iota(37, 100.0);
+
+    axpy(2.0, x, y);
+    EXPECT_DOUBLE_EQ(y[0], 102.0);
+    EXPECT_DOUBLE_EQ(y[36], 136.0 + 74.0);
+
+    axpby(1.0, x, -1.0, y);
+    EXPECT_DOUBLE_EQ(y[0], 1.0 - 102.0);
+
+    // Запись в срез без копирования
+    Vector<double> z(40);
+    axpy(3.0, x.slice(0, 10), z.slice(5, 10));
+    EXPECT_DOUBLE_EQ(z[4], 0.0);
+    EXPECT_DOUBLE_EQ(z[5], 3.0);
+    EXPECT_DOUBLE_EQ(z[14], 30.0);
+    EXPECT_DOUBLE_EQ(z[15], 0.0);
+
+    EXPECT_THROW(axpy(1.0, x, z), std::invalid_argument);
+}
+
+// Тест для scal, fma и clamp на всех наборах инструкций
+TEST(Blas1Test, ScalFmaClamp) {
+    const kernels::Isa isa = kernels::activeIsa();
+    for (kernels::Isa target : {kernels::Isa::Scalar, kernels::Isa::SSE2, kernels::Isa::AVX2, kernels::Isa::AVX512}) {
+        kernels::setIsa(target);
+        Vector<double> x = iota(29, -14.0);
+        scal(0.5, x);
+        EXPECT_DOUBLE_EQ(x[0], -7.0);
+        EXPECT_DOUBLE_EQ(x[28], 7.0);
+
+        Vector<double> out(29);
+        fma(x, x, iota(29, 0.0), out);
+        EXPECT_DOUBLE_EQ(out[0], 49.0);
+        EXPECT_DOUBLE_EQ(out[28], 49.0 + 28.0);
+
+        clamp(x, -2.0, 3.0);
+        EXPECT_DOUBLE_EQ(x[0], -2.0);
+        EXPECT_DOUBLE_EQ(x[14], 0.0);
+        EXPECT_DOUBLE_EQ(x[15], 0.5);
+        EXPECT_DOUBLE_EQ(x[28], 3.0);
+    }
+    kernels::setIsa(isa);
+
+    Vector<int> counts(10);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] = static_cast<int>(i) - 5;
+    }
+    clamp(counts, 0, 3);
+    EXPECT_EQ(counts[0], 0);
+    EXPECT_EQ(counts[7], 2);
+    EXPECT_EQ(counts[9], 3);
+
+    EXPECT_THROW(clamp(counts, 3, 0), std::invalid_argument);
+    Vector<double> shorter(3);
+    EXPECT_THROW(fma(shorter, shorter, Vector<double>(4), shorter), std::invalid_argument);
+}
+
+// Тест для длинных векторов в пуле потоков
+TEST(Blas1Test, LongVectorsInParallel) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const size_t n = 1 << 20;
+    const Vector<double> x = iota(n, 0.0);
+    Vector<double> y = iota(n, 1.0);
+    axpby(2.0, x, 0.5, y);
+    for (size_t i : {size_t(0), n / 3, n - 1}) {
+        EXPECT_DOUBLE_EQ(y[i], 2.0 * i + 0.5 * (i + 1.0));
+    }
+
+    pool.resize(threads);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
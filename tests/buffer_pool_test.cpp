@@ -0,0 +1,131 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <utility>
+#include "../include/kernels/buffer_pool.hpp"
+#include "../include/types/matrix.hpp"
+
+// Тест классов размеров: четыре класса на октаву, не больше 25% запаса
+TEST(BufferPoolTest, SizeClasses) {
+    EXPECT_EQ(kernels::BufferPool::classBytes(1), 256u);
+    EXPECT_EQ(kernels::BufferPool::classBytes(256), 256u);
+    EXPECT_EQ(kernels::BufferPool::classBytes(257), 320u);
+    EXPECT_EQ(kernels::BufferPool::classBytes(512), 512u);
+    EXPECT_EQ(kernels::BufferPool::classBytes(513), 640u);
+    EXPECT_EQ(kernels::BufferPool::classBytes(1000), 1024u);
+    for (size_t bytes = 300; bytes < (1 << 20); bytes = bytes * 3 / 2) {
+        const size_t rounded = kernels::BufferPool::classBytes(bytes);
+        EXPECT_GE(rounded, bytes);
+        EXPECT_LE(rounded, bytes + bytes / 4);
+    }
+}
+
+// Тест повторного использования: вычисления в цикле берут буферы из пула
+TEST(BufferPoolTest, SteadyStateReuse) {
+    kernels::BufferPool pool;
+    Matrix<double> a(16, 16);
+    ++a;
+    Vector<double> x(16);
+    x += 1.0;
+    {
+        kernels::ScopedResource scope(&pool);
+        for (int i = 0; i < 100; ++i) {
+            const Matrix<double> b = a + a;
+            const Vector<double> y = b * x + x;
+            EXPECT_DOUBLE_EQ(y[0], 33.0);
+        }
+    }
+    const kernels::PoolStats& stats = pool.stats();
+    EXPECT_EQ(stats.requests, 200u);
+    EXPECT_EQ(stats.requests - stats.reused, 2u);
+    EXPECT_GT(stats.reuseRate(), 0.98);
+    EXPECT_EQ(stats.blocksHeld, 2u);
+    EXPECT_GT(stats.bytesHeld, 16 * 16 * sizeof(double));
+
+    pool.resetStats();
+    EXPECT_EQ(pool.stats().requests, 0u);
+    EXPECT_EQ(pool.stats().blocksHeld, 2u);
+    pool.trim();
+    EXPECT_EQ(pool.stats().bytesHeld, 0u);
+    EXPECT_EQ(pool.stats().blocksHeld, 0u);
+}
+
+// Тест ограничений: лишние блоки возвращаются в вышестоящий ресурс
+TEST(BufferPoolTest, Caps) {
+    kernels::BufferPool pool(kernels::PoolLimits{1 << 20, 2});
+    {
+        kernels::ScopedResource scope(&pool);
+        std::vector<Vector<float>> live;
+        for (int i = 0; i < 5; ++i) {
+            live.emplace_back(100);
+        }
+    }
+    EXPECT_EQ(pool.stats().blocksHeld, 2u);
+    EXPECT_EQ(pool.stats().bytesTrimmed, 0u);
+
+    {
+        kernels::ScopedResource scope(&pool);
+        const Vector<double> big(1 << 16);
+        const Vector<double> small(8);
+    }
+    EXPECT_EQ(pool.stats().blocksHeld, 4u);
+    pool.setLimits(kernels::PoolLimits{1 << 10, 1});
+    EXPECT_LE(pool.stats().bytesHeld, 1u << 10);
+    EXPECT_GT(pool.stats().bytesTrimmed, 0u);
+}
+
+// Тест потоков: буфер, освобождённый в другом потоке, уходит мимо пула
+TEST(BufferPoolTest, ForeignThreads) {
+    kernels::BufferPool pool;
+    Vector<double> v(64, &pool);
+    std::thread([moved = std::move(v)]() mutable {
+        Vector<double> copy = moved;
+        copy[0] = 1.0; // копия при записи выделяется в чужом потоке
+    }).join();
+    EXPECT_EQ(pool.stats().requests, 1u);
+    EXPECT_EQ(pool.stats().blocksHeld, 0u);
+
+    // Пул потока переживает поток, пока его буферы живы
+    Vector<double> escaped;
+    std::thread([&escaped] {
+        kernels::ScopedResource scope(&kernels::BufferPool::local());
+        escaped = Vector<double>(32);
+        escaped += 2.0;
+    }).join();
+    EXPECT_DOUBLE_EQ(escaped.sum(), 64.0);
+    escaped = Vector<double>();
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/linalg/cholesky.hpp"
+
+// Симметричная положительно определённая матрица B * B^T + n * I
+static Matrix<double> randomSpd(int n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> b(n * n);
+    for (auto& x : b) {
+        x = dist(gen);
+    }
+    Matrix<double> mat(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double sum = i == j ? n : 0.0;
+            for (int k = 0; k < n; ++k) {
+                sum += b[i * n + k] * b[j * n + k];
+            }
+            mat[i][j] = sum;
+        }
+    }
+    return mat;
+}
+
+TEST(CholeskyTest, Factor) {
+    Matrix<double> mat(3, 3);
+    mat[0][0] = 4;   mat[0][1] = 12;  mat[0][2] = -16;
+    mat[1][0] = 12;  mat[1][1] = 37;  mat[1][2] = -43;
+    mat[2][0] = -16; mat[2][1] = -43; mat[2][2] = 98;
+
+    Cholesky<double> chol(mat);
+    Matrix<double> l = chol.getL();
+
+    EXPECT_NEAR(l[0][0], 2.0, 1e-12);
+    EXPECT_NEAR(l[1][0], 6.0, 1e-12);
+    EXPECT_NEAR(l[1][1], 1.0, 1e-12);
+    EXPECT_NEAR(l[2][0], -8.0, 1e-12);
+    EXPECT_NEAR(l[2][1], 5.0, 1e-12);
+    EXPECT_NEAR(l[2][2], 3.0, 1e-12);
+    EXPECT_EQ(l[0][1], 0.0);
+    EXPECT_NEAR(chol.det(), 36.0, 1e-9);
+}
+
+TEST(CholeskyTest, SolveInParallel) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+    const int n = 230;
+    Matrix<double> mat = randomSpd(n, 7);
+    Vector<double> b(n);
+    for (int i = 0; i < n; ++i) {
+        b[i] = i % 5 - 2.0;
+    }
+    Vector<double> x = Cholesky<double>(mat).solve(b);
+    pool.resize(threads);
+
+    for (int i = 0; i < n; ++i) {
+        double sum = 0.0;
+        for (int j = 0; j < n; ++j) {
+            sum += mat[i][j] * x[j];
+        }
+        EXPECT_NEAR(sum, b[i], 1e-9);
+    }
+}
+
+// Тесты на исключения
+TEST(CholeskyTest, NotPositiveDefinite) {
+    Matrix<double> mat(2, 2);
+    mat[0][0] = 1; mat[0][1] = 2;
+    mat[1][0] = 2; mat[1][1] = 1;
+
+    EXPECT_THROW(Cholesky<double> chol(mat), std::invalid_argument);
+}
+
+TEST(CholeskyTest, NotSquare) {
+    Matrix<double> mat(3, 2);
+    EXPECT_THROW(Cholesky<double> chol(mat), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
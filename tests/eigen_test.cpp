@@ -0,0 +1,154 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../include/linalg/eigen.hpp"
+#include "test_utils.hpp"
+
+// Проверяет A V = V diag(w) и V^T V = I
+static void expectDecomposition(const Matrix<double>& mat, const SymmetricEigen<double>& eig, double tol) {
+    const int n = mat.getRows();
+    Vector<double> w = eig.getEigenvalues();
+    Matrix<double> vec = eig.getEigenvectors();
+    Matrix<double> av = mat * vec;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            ASSERT_NEAR(av(i, j), vec(i, j) * w[j], tol);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (int k = 0; k < n; ++k) {
+                sum += vec(k, i) * vec(k, j);
+            }
+            ASSERT_NEAR(sum, i == j ? 1.0 : 0.0, tol);
+        }
+    }
+    for (int i = 1; i < n; ++i) {
+        EXPECT_LE(w[i - 1], w[i]);
+    }
+}
+
+TEST(SymmetricEigenTest, TwoByTwo) {
+    Matrix<double> mat(2, 2);
+    mat[0][0] = 2; mat[0][1] = 1;
+    mat[1][0] = 1; mat[1][1] = 2;
+
+    SymmetricEigen<double> eig(mat);
+    Vector<double> w = eig.getEigenvalues();
+    Matrix<double> vec = eig.getEigenvectors();
+
+    EXPECT_NEAR(w[0], 1.0, 1e-14);
+    EXPECT_NEAR(w[1], 3.0, 1e-14);
+    EXPECT_NEAR(std::abs(vec(0, 0)), std::sqrt(0.5), 1e-14);
+    EXPECT_NEAR(vec(0, 0), -vec(1, 0), 1e-14);
+    EXPECT_NEAR(vec(0, 1), vec(1, 1), 1e-14);
+}
+
+TEST(SymmetricEigenTest, RandomMatrices) {
+    // Размеры по обе стороны от ширины панели
+    for (int n : {1, 2, 3, 10, 64, 65, 150}) {
+        Matrix<double> mat = randomSymmetric(n, n);
+        SymmetricEigen<double> eig(mat);
+        expectDecomposition(mat, eig, 1e-12);
+
+        double trace = 0.0, sum = 0.0;
+        Vector<double> w = eig.getEigenvalues();
+        for (int i = 0; i < n; ++i) {
+            trace += mat(i, i);
+            sum += w[i];
+        }
+        EXPECT_NEAR(trace, sum, 1e-11);
+    }
+}
+
+TEST(SymmetricEigenTest, RepeatedEigenvalues) {
+    // Q diag(1, 1, 1, 5, 5) Q^T с ортогональной Q из отражения Хаусхолдера
+    const int n = 5;
+    const double values[] = {1, 1, 1, 5, 5};
+    Vector<double> u(n);
+    for (int i = 0; i < n; ++i) {
+        u[i] = 1.0 / std::sqrt(double(n));
+    }
+    Matrix<double> mat(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            for (int k = 0; k < n; ++k) {
+                const double qik = (i == k) - 2 * u[i] * u[k];
+                const double qjk = (j == k) - 2 * u[j] * u[k];
+                mat(i, j) += qik * values[k] * qjk;
+            }
+        }
+    }
+    SymmetricEigen<double> eig(mat);
+    expectDecomposition(mat, eig, 1e-13);
+    Vector<double> w = eig.getEigenvalues();
+    for (int i = 0; i < n; ++i) {
+        EXPECT_NEAR(w[i], values[i], 1e-13);
+    }
+}
+
+TEST(SymmetricEigenTest, ReadsLowerTriangle) {
+    Matrix<double> mat = randomSymmetric(20, 7);
+    Matrix<double> lower = mat;
+    for (int i = 0; i < 20; ++i) {
+        for (int j = i + 1; j < 20; ++j) {
+            lower(i, j) = 100.0;
+        }
+    }
+    Vector<double> expected = symmetricEigenvalues(mat);
+    Vector<double> actual = symmetricEigenvalues(lower);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_NEAR(actual[i], expected[i], 1e-13);
+    }
+}
+
+TEST(SymmetricEigenTest, EigenvaluesOnly) {
+    Matrix<double> mat = randomSymmetric(80, 3);
+    Vector<double> full = SymmetricEigen<double>(mat).getEigenvalues();
+    SymmetricEigen<double> eig(mat, false);
+    Vector<double> w = eig.getEigenvalues();
+    for (int i = 0; i < 80; ++i) {
+        EXPECT_NEAR(w[i], full[i], 1e-12);
+    }
+    EXPECT_THROW(eig.getEigenvectors(), std::logic_error);
+}
+
+TEST(SymmetricEigenTest, NotSquare) {
+    Matrix<double> mat(2, 3);
+    EXPECT_THROW(SymmetricEigen<double> eig(mat), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include "../include/types/matrix.hpp"
+#include "../include/types/half.hpp"
+
+namespace {
+
+const kernels::Isa kIsas[] = {kernels::Isa::Scalar, kernels::Isa::SSE2, kernels::Isa::AVX2, kernels::Isa::AVX512};
+
+} // namespace
+
+// Тест для точных значений, округления и особых случаев fp16
+TEST(HalfTest, HalfConversion) {
+    EXPECT_EQ(Half(1.0f).toBits(), 0x3C00);
+    EXPECT_EQ(Half(-2.0f).toBits(), 0xC000);
+    EXPECT_EQ(Half(65504.0f).toBits(), 0x7BFF);
+    EXPECT_EQ(Half(65520.0f).toBits(), 0x7C00); // переполнение в бесконечность
+    EXPECT_EQ(Half(0x1p-24f).toBits(), 0x0001); // наименьшее субнормальное
+    EXPECT_EQ(Half(0x1p-26f).toBits(), 0x0000);
+    EXPECT_EQ(Half(-0.0f).toBits(), 0x8000);
+    EXPECT_TRUE(std::isnan(static_cast<float>(Half(std::numeric_limits<float>::quiet_NaN()))));
+    EXPECT_EQ(static_cast<float>(Half::fromBits(0x7C00)), std::numeric_limits<float>::infinity());
+
+    // Округление к ближайшему чётному: 1 + 2^-11 лежит ровно посередине
+    EXPECT_EQ(Half(1.0f + 0x1p-11f).toBits(), 0x3C00);
+    EXPECT_EQ(Half(1.0f + 3 * 0x1p-11f).toBits(), 0x3C02);
+
+    // Все конечные значения переживают круговое преобразование
+    for (std::uint32_t bits = 0; bits < 0x10000; ++bits) {
+        const Half h = Half::fromBits(static_cast<std::uint16_t>(bits));
+        if (!std::isnan(static_cast<float>(h))) {
+            ASSERT_EQ(Half(static_cast<float>(h)).toBits(), bits);
+        }
+    }
+
+    constexpr Half c = 0.5;
+    static_assert(c.toBits() == 0x3800);
+    static_assert(sizeof(Half) == 2);
+}
+
+// Тест для преобразований bfloat16
+TEST(HalfTest, BFloat16Conversion) {
+    EXPECT_EQ(BFloat16(1.0f).toBits(), 0x3F80);
+    EXPECT_EQ(static_cast<float>(BFloat16(0x1p100f)), 0x1p100f); // диапазон как у float
+    EXPECT_EQ(BFloat16(1.0f + 0x1p-8f).toBits(), 0x3F80); // посередине, к чётному
+    EXPECT_EQ(BFloat16(1.0f + 3 * 0x1p-8f).toBits(), 0x3F82);
+    EXPECT_TRUE(std::isnan(static_cast<float>(BFloat16(std::numeric_limits<float>::quiet_NaN()))));
+    static_assert(BFloat16(2.0).toBits() == 0x4000);
+}
+
+// Тест для векторных преобразований на всех наборах инструкций
+TEST(HalfTest, ConversionKernels) {
+    std::vector<float> source(1037);
+    for (size_t i = 0; i < source.size(); ++i) {
+        source[i] = std::ldexp(static_cast<float>(i) - 500.0f, static_cast<int>(i % 40) - 20) / 3.0f;
+    }
+    source[7] = std::numeric_limits<float>::infinity();
+    source[8] = std::numeric_limits<float>::quiet_NaN();
+
+    const kernels::Isa isa = kernels::activeIsa();
+    for (kernels::Isa target : kIsas) {
+        kernels::setIsa(target);
+        std::vector<Half> h(source.size());
+        std::vector<BFloat16> b(source.size());
+        kernels::fromFloat(source.size(), source.data(), h.data());
+        kernels::fromFloat(source.size(), source.data(), b.data());
+        std::vector<float> hf(source.size());
+        std::vector<float> bf(source.size());
+        kernels::toFloat(h.size(), h.data(), hf.data());
+        kernels::toFloat(b.size(), b.data(), bf.data());
+        for (size_t i = 0; i < source.size(); ++i) {
+            ASSERT_EQ(h[i].toBits(), Half::encode(source[i])) << i;
+            ASSERT_EQ(b[i].toBits(), BFloat16::encode(source[i])) << i;
+            if (i != 8) {
+                ASSERT_EQ(hf[i], Half::decode(h[i].toBits())) << i;
+                ASSERT_EQ(bf[i], BFloat16::decode(b[i].toBits())) << i;
+            }
+        }
+    }
+    kernels::setIsa(isa);
+}
+
+// Тест для поэлементных операций и редукций с накоплением во float
+TEST(HalfTest, VectorArithmeticAndReductions) {
+    const kernels::Isa isa = kernels::activeIsa();
+    for (kernels::Isa target : kIsas) {
+        kernels::setIsa(target);
+        Vector<Half> a(5000);
+        Vector<Half> b(5000);
+        a += Half(1.0f);
+        for (size_t i = 0; i < b.size(); ++i) {
+            b[i] = static_cast<float>(i % 8) * 0.25f;
+        }
+
+        // Сумма 5000 единиц в fp16 остановилась бы на 2048
+        EXPECT_FLOAT_EQ(a.sum(), 5000.0f);
+        EXPECT_FLOAT_EQ(a.dot(b), 625.0f * 7.0f);
+        EXPECT_FLOAT_EQ(a.norm2(), std::sqrt(5000.0f));
+        EXPECT_FLOAT_EQ(b.max(), 1.75f);
+        EXPECT_EQ(b.argmax(), 7u);
+
+        const Vector<Half> c = a + b;
+        EXPECT_FLOAT_EQ(c[7], 2.75f);
+        const Vector<Half> d = 2.0f * b + a;
+        EXPECT_FLOAT_EQ(d[3], 2.5f);
+        Vector<Half> e = b;
+        e *= a;
+        EXPECT_EQ(e, b);
+
+        Vector<BFloat16> x(100);
+        x += BFloat16(0.5f);
+        const Vector<BFloat16> y = x * x;
+        EXPECT_FLOAT_EQ(y[99], 0.25f);
+        EXPECT_FLOAT_EQ(y.sum(), 25.0f);
+    }
+    kernels::setIsa(isa);
+}
+
+// Тест для произведения матриц fp16 и bfloat16
+TEST(HalfTest, MatrixProduct) {
+    const int n = 70;
+    const int k = 300;
+    Matrix<float> af(n, k);
+    Matrix<float> bf(k, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < k; ++j) {
+            af(i, j) = static_cast<float>((i + j) % 5) * 0.5f;
+            bf(j, i) = static_cast<float>((i * j) % 3) - 1.0f;
+        }
+    }
+    Matrix<Half> ah(n, k);
+    Matrix<Half> bh(k, n);
+    Matrix<BFloat16> ab(n, k);
+    Matrix<BFloat16> bb(k, n);
+    kernels::fromFloat(n * k, af.begin(), ah.begin());
+    kernels::fromFloat(n * k, bf.begin(), bh.begin());
+    kernels::fromFloat(n * k, af.begin(), ab.begin());
+    kernels::fromFloat(n * k, bf.begin(), bb.begin());
+
+    // Входы точно представимы, а накопление во float даёт точный результат до округления
+    const Matrix<float> expected = af * bf;
+    const Matrix<Half> ch = ah * bh;
+    const Matrix<BFloat16> cb = ab * bb;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            ASSERT_EQ(ch(i, j).toBits(), Half(expected(i, j)).toBits());
+            ASSERT_EQ(cb(i, j).toBits(), BFloat16(expected(i, j)).toBits());
+        }
+    }
+
+    const Vector<Half> ones = Vector<Half>(k) + Half(1.0f);
+    const Vector<Half> rowSums = ah * ones;
+    EXPECT_FLOAT_EQ(rowSums[0], Half(af[0].sum()));
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,221 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "../include/linalg/krylov.hpp"
+
+// Пятиточечный оператор на сетке g x g; skew > 0 добавляет конвекцию
+static SparseMatrix<double> convectionDiffusion(size_t g, double skew) {
+    const size_t n = g * g;
+    CooBuilder<double> coo(n, n);
+    for (size_t i = 0; i < g; ++i) {
+        for (size_t j = 0; j < g; ++j) {
+            const size_t r = i * g + j;
+            coo.add(r, r, 4.0);
+            if (i > 0) coo.add(r, r - g, -1.0);
+            if (i + 1 < g) coo.add(r, r + g, -1.0);
+            if (j > 0) coo.add(r, r - 1, -1.0 - skew);
+            if (j + 1 < g) coo.add(r, r + 1, -1.0 + skew);
+        }
+    }
+    return coo.build();
+}
+
+static Vector<double> ones(size_t n) {
+    Vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = 1.0;
+    }
+    return v;
+}
+
+// ||b - A x|| / ||b||, посчитанная заново
+static double trueResidual(const SparseMatrix<double>& a, const Vector<double>& b, const Vector<double>& x) {
+    Vector<double> r = a * x;
+    double sum = 0.0;
+    for (size_t i = 0; i < b.size(); ++i) {
+        sum += (b[i] - r[i]) * (b[i] - r[i]);
+    }
+    return std::sqrt(sum) / b.norm2();
+}
+
+TEST(KrylovTest, ConjugateGradient) {
+    SparseMatrix<double> a = convectionDiffusion(30, 0.0);
+    Vector<double> b = ones(900);
+
+    ConjugateGradient<double> cg;
+    Vector<double> plain(900), jacobi(900), ilu(900);
+    KrylovResult<double> r1 = cg.solve(a, b, plain);
+    KrylovResult<double> r2 = cg.solve(a, b, jacobi, JacobiPreconditioner<double>(a));
+    KrylovResult<double> r3 = cg.solve(a, b, ilu, ILU0Preconditioner<double>(a));
+
+    for (const auto& [result, x] : {std::pair{r1, &plain}, {r2, &jacobi}, {r3, &ilu}}) {
+        EXPECT_TRUE(result.converged);
+        EXPECT_LE(result.residual, 1e-8);
+        EXPECT_LT(trueResidual(a, b, *x), 1e-7);
+    }
+    EXPECT_LT(r3.iterations, r1.iterations);
+}
+
+TEST(KrylovTest, NonsymmetricSolvers) {
+    SparseMatrix<double> a = convectionDiffusion(30, 0.4);
+    Vector<double> b = ones(900);
+    ILU0Preconditioner<double> ilu(a);
+
+    BiCGSTAB<double> bicgstab;
+    GMRES<double> gmres;
+    Vector<double> x1(900), x2(900), x3(900), x4(900);
+    KrylovResult<double> plainBicg = bicgstab.solve(a, b, x1);
+    KrylovResult<double> iluBicg = bicgstab.solve(a, b, x2, ilu);
+    KrylovResult<double> plainGmres = gmres.solve(a, b, x3);
+    KrylovResult<double> iluGmres = gmres.solve(a, b, x4, ilu);
+
+    EXPECT_TRUE(plainBicg.converged);
+    EXPECT_TRUE(iluBicg.converged);
+    EXPECT_TRUE(plainGmres.converged);
+    EXPECT_TRUE(iluGmres.converged);
+    EXPECT_LT(iluBicg.iterations, plainBicg.iterations);
+    EXPECT_LT(iluGmres.iterations, plainGmres.iterations);
+    for (const Vector<double>* x : {&x1, &x2, &x3, &x4}) {
+        EXPECT_LT(trueResidual(a, b, *x), 1e-7);
+    }
+}
+
+TEST(KrylovTest, DenseAndMatrixFreeOperators) {
+    SparseMatrix<double> sparse = convectionDiffusion(8, 0.2);
+    Matrix<double> dense = sparse.toDense();
+    Vector<double> b = ones(64);
+    auto op = [&](const Vector<double>& x, Vector<double>& y) { y = sparse * x; };
+
+    GMRES<double> gmres;
+    Vector<double> x1(64), x2(64), x3(64);
+    EXPECT_TRUE(gmres.solve(sparse, b, x1).converged);
+    EXPECT_TRUE(gmres.solve(dense, b, x2, JacobiPreconditioner<double>(dense)).converged);
+    EXPECT_TRUE(gmres.solve(op, b, x3, ILU0Preconditioner<double>(dense)).converged);
+    for (size_t i = 0; i < 64; ++i) {
+        EXPECT_NEAR(x2[i], x1[i], 1e-7);
+        EXPECT_NEAR(x3[i], x1[i], 1e-7);
+    }
+}
+
+TEST(KrylovTest, GmresRestart) {
+    SparseMatrix<double> a = convectionDiffusion(6, 0.3);
+    Vector<double> b = ones(36);
+
+    // Без перезапуска GMRES сходится не более чем за n шагов
+    KrylovOptions<double> options;
+    options.restart = 36;
+    options.tolerance = 1e-12;
+    Vector<double> full(36);
+    KrylovResult<double> result = GMRES<double>(options).solve(a, b, full);
+    EXPECT_TRUE(result.converged);
+    EXPECT_LE(result.iterations, 36u);
+
+    options.restart = 4;
+    Vector<double> restarted(36);
+    result = GMRES<double>(options).solve(a, b, restarted);
+    EXPECT_TRUE(result.converged);
+    EXPECT_LT(trueResidual(a, b, restarted), 1e-11);
+}
+
+TEST(KrylovTest, ExactPreconditioner) {
+    // ILU(0) трёхдиагональной матрицы совпадает с LU: один шаг
+    CooBuilder<double> coo(50, 50);
+    for (size_t i = 0; i < 50; ++i) {
+        coo.add(i, i, 3.0);
+        if (i > 0) coo.add(i, i - 1, -1.0);
+        if (i + 1 < 50) coo.add(i, i + 1, -1.5);
+    }
+    SparseMatrix<double> a = coo.build();
+    Vector<double> b = ones(50);
+    Vector<double> x(50);
+    KrylovResult<double> result = GMRES<double>().solve(a, b, x, ILU0Preconditioner<double>(a.toCSC()));
+    EXPECT_TRUE(result.converged);
+    EXPECT_EQ(result.iterations, 1u);
+}
+
+TEST(KrylovTest, CallbackAndReuse) {
+    SparseMatrix<double> a = convectionDiffusion(20, 0.0);
+    Vector<double> b = ones(400);
+
+    std::vector<double> history;
+    KrylovOptions<double> options;
+    options.callback = [&](size_t iteration, double residual) {
+        EXPECT_EQ(iteration, history.size() + 1);
+        history.push_back(residual);
+        return iteration < 5;
+    };
+    ConjugateGradient<double> cg(options);
+    Vector<double> x(400);
+    KrylovResult<double> result = cg.solve(a, b, x);
+    EXPECT_FALSE(result.converged);
+    EXPECT_EQ(result.iterations, 5u);
+    EXPECT_EQ(history.size(), 5u);
+    EXPECT_EQ(result.residual, history.back());
+
+    // Тот же решатель продолжает с текущего x
+    cg.getOptions().callback = nullptr;
+    result = cg.solve(a, b, x);
+    EXPECT_TRUE(result.converged);
+    result = cg.solve(a, b, x);
+    EXPECT_TRUE(result.converged);
+    EXPECT_EQ(result.iterations, 0u);
+
+    // Нулевая правая часть даёт нулевое решение
+    Vector<double> zero(400);
+    result = cg.solve(a, zero, x);
+    EXPECT_TRUE(result.converged);
+    EXPECT_EQ(x.normInf(), 0.0);
+}
+
+TEST(KrylovTest, InvalidArguments) {
+    SparseMatrix<double> a = convectionDiffusion(3, 0.0);
+    Vector<double> b = ones(9);
+    Vector<double> x(8);
+    EXPECT_THROW(ConjugateGradient<double>().solve(a, b, x), std::invalid_argument);
+
+    Matrix<double> singular(2, 2);
+    singular(0, 1) = 1.0;
+    singular(1, 0) = 1.0;
+    EXPECT_THROW(JacobiPreconditioner<double>{singular}, std::invalid_argument);
+    EXPECT_THROW(ILU0Preconditioner<double>{singular}, std::invalid_argument);
+
+    KrylovOptions<double> options;
+    options.restart = 0;
+    Vector<double> y(9);
+    EXPECT_THROW(GMRES<double>(options).solve(a, b, y), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,139 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include "../include/linalg/lu.hpp"
+#include "test_utils.hpp"
+
+TEST(LUTest, SolveVector) {
+    Matrix<double> mat(3, 3);
+    mat[0][0] = 2; mat[0][1] = 1;  mat[0][2] = -1;
+    mat[1][0] = -3; mat[1][1] = -1; mat[1][2] = 2;
+    mat[2][0] = -2; mat[2][1] = 1;  mat[2][2] = 2;
+
+    Vector<double> b(3);
+    b[0] = 8; b[1] = -11; b[2] = -3;
+
+    Vector<double> x = solve(mat, b);
+
+    EXPECT_NEAR(x[0], 2.0, 1e-12);
+    EXPECT_NEAR(x[1], 3.0, 1e-12);
+    EXPECT_NEAR(x[2], -1.0, 1e-12);
+}
+
+TEST(LUTest, Determinant) {
+    Matrix<double> mat(3, 3);
+    mat[0][0] = 0; mat[0][1] = 2; mat[0][2] = 1;  // нулевой ведущий элемент требует перестановки
+    mat[1][0] = 1; mat[1][1] = 1; mat[1][2] = 1;
+    mat[2][0] = 2; mat[2][1] = 1; mat[2][2] = 3;
+
+    EXPECT_NEAR(det(mat), -3.0, 1e-12);
+}
+
+TEST(LUTest, FactorsReproduceMatrix) {
+    Matrix<double> mat = randomMatrix(5, 5, 1, -1.0, 1.0, 5);
+    LU<double> lu(mat);
+    Matrix<double> l = lu.getL();
+    Matrix<double> u = lu.getU();
+    Matrix<double> product = l * u;
+
+    // Повторяем перестановки строк исходной матрицы
+    std::vector<std::vector<double>> permuted(5);
+    for (int i = 0; i < 5; ++i) {
+        permuted[i].assign(mat[i].begin(), mat[i].end());
+    }
+    for (size_t i = 0; i < 5; ++i) {
+        std::swap(permuted[i], permuted[lu.getPivots()[i]]);
+    }
+    for (int i = 0; i < 5; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            EXPECT_NEAR(product[i][j], permuted[i][j], 1e-12);
+        }
+    }
+}
+
+TEST(LUTest, MultipleRightHandSides) {
+    const int n = 150;
+    Matrix<double> mat = randomMatrix(n, n, 2, -1.0, 1.0, n);
+    Matrix<double> b(n, 7);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < 7; ++j) {
+            b[i][j] = i - 3 * j;
+        }
+    }
+
+    LU<double> lu(mat);
+    Matrix<double> x = lu.solve(b);
+    Matrix<double> ax = mat * x;
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < 7; ++j) {
+            EXPECT_NEAR(ax[i][j], b[i][j], 1e-9);
+        }
+    }
+}
+
+TEST(LUTest, InverseInParallel) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+    const int n = 200;
+    Matrix<double> mat = randomMatrix(n, n, 3, -1.0, 1.0, n);
+    Matrix<double> inv = inverse(mat);
+    Matrix<double> identity = mat * inv;
+    pool.resize(threads);
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            EXPECT_NEAR(identity[i][j], i == j ? 1.0 : 0.0, 1e-10);
+        }
+    }
+}
+
+// Тесты на исключения
+TEST(LUTest, Singular) {
+    Matrix<double> mat(2, 2);
+    mat[0][0] = 1; mat[0][1] = 2;
+    mat[1][0] = 2; mat[1][1] = 4;
+
+    LU<double> lu(mat);
+    EXPECT_TRUE(lu.isSingular());
+    EXPECT_EQ(lu.det(), 0.0);
+    EXPECT_THROW(lu.inverse(), std::invalid_argument);
+}
+
+TEST(LUTest, NotSquare) {
+    Matrix<double> mat(2, 3);
+    EXPECT_THROW(LU<double> lu(mat), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../include/linalg/matrix_functions.hpp"
+#include "test_utils.hpp"
+
+static Matrix<double> identity(int n) {
+    Matrix<double> mat(n, n);
+    for (int i = 0; i < n; ++i) {
+        mat[i][i] = 1.0;
+    }
+    return mat;
+}
+
+static void expectNear(const Matrix<double>& a, const Matrix<double>& b, double tol) {
+    ASSERT_EQ(a.getRows(), b.getRows());
+    ASSERT_EQ(a.getCols(), b.getCols());
+    for (int i = 0; i < a.getRows(); ++i) {
+        for (int j = 0; j < a.getCols(); ++j) {
+            EXPECT_NEAR(a(i, j), b(i, j), tol) << "at (" << i << ", " << j << ")";
+        }
+    }
+}
+
+TEST(MatrixFunctionsTest, PowMatchesRepeatedProducts) {
+    Matrix<double> mat = randomMatrix(7, 7, 1, -0.3, 0.3);
+    Matrix<double> expected = identity(7);
+    for (unsigned k = 0; k <= 20; ++k) {
+        expectNear(pow(mat, k), expected, 1e-12);
+        expected = expected * mat;
+    }
+}
+
+TEST(MatrixFunctionsTest, PowLargeExponent) {
+    // Числа Фибоначчи: [[1, 1], [1, 0]]^k = [[F(k+1), F(k)], [F(k), F(k-1)]]
+    Matrix<long long> fib(2, 2);
+    fib(0, 0) = 1; fib(0, 1) = 1;
+    fib(1, 0) = 1;
+    Matrix<long long> result = pow(fib, 90);
+    EXPECT_EQ(result(0, 1), 2880067194370816120LL);
+    EXPECT_EQ(result(0, 0), result(0, 1) + result(1, 1));
+
+    // Стохастическая матрица сходится к стационарному распределению
+    Matrix<double> chain(2, 2);
+    chain(0, 0) = 0.9; chain(0, 1) = 0.1;
+    chain(1, 0) = 0.5; chain(1, 1) = 0.5;
+    Matrix<double> limit = pow(chain, 1000000);
+    EXPECT_NEAR(limit(0, 0), 5.0 / 6.0, 1e-9);
+    EXPECT_NEAR(limit(1, 1), 1.0 / 6.0, 1e-9);
+}
+
+TEST(MatrixFunctionsTest, ExpmDiagonal) {
+    const double values[] = {-1.0, 0.5, 3.0, 20.0};
+    Matrix<double> mat(4, 4);
+    for (int i = 0; i < 4; ++i) {
+        mat(i, i) = values[i];
+    }
+    Matrix<double> result = expm(mat);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            const double expected = i == j ? std::exp(values[i]) : 0.0;
+            EXPECT_NEAR(result(i, j), expected, 1e-13 * std::max(1.0, expected));
+        }
+    }
+}
+
+TEST(MatrixFunctionsTest, ExpmNilpotent) {
+    // exp(N) = I + N + N^2 / 2 для жордановой клетки с нулём на диагонали
+    Matrix<double> mat(3, 3);
+    mat(0, 1) = 2.0;
+    mat(1, 2) = 3.0;
+    Matrix<double> expected = identity(3);
+    expected(0, 1) = 2.0;
+    expected(1, 2) = 3.0;
+    expected(0, 2) = 3.0;
+    expectNear(expm(mat), expected, 1e-14);
+}
+
+TEST(MatrixFunctionsTest, ExpmRotation) {
+    for (double t : {0.01, 0.2, 1.0, 2.0, 10.0, 100.0}) {
+        Matrix<double> mat(2, 2);
+        mat(0, 1) = -t;
+        mat(1, 0) = t;
+        Matrix<double> expected(2, 2);
+        expected(0, 0) = std::cos(t); expected(0, 1) = -std::sin(t);
+        expected(1, 0) = std::sin(t); expected(1, 1) = std::cos(t);
+        expectNear(expm(mat), expected, 1e-12 * std::max(1.0, t));
+    }
+}
+
+TEST(MatrixFunctionsTest, ExpmOfNegationIsInverse) {
+    // Нормы покрывают все степени аппроксимации Паде и масштабирование
+    for (double scale : {0.001, 0.03, 0.1, 0.3, 1.0, 3.0}) {
+        Matrix<double> mat = randomMatrix(6, 6, 2, -scale, scale);
+        Matrix<double> product = expm(mat) * expm(Matrix<double>(mat * -1.0));
+        expectNear(product, identity(6), 1e-11);
+    }
+}
+
+TEST(MatrixFunctionsTest, NotSquare) {
+    Matrix<double> mat(2, 3);
+    EXPECT_THROW(pow(mat, 2), std::invalid_argument);
+    EXPECT_THROW(expm(mat), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -27,6 +27,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include <gtest/gtest.h>
+#include <type_traits>
+#include <utility>
 #include "../include/types/matrix.hpp"  // Убедитесь, что путь к вашему файлу Matrix.h верный
 
 // Тест для конструктора
@@ -149,6 +151,489 @@ TEST(MatrixTest, Input) {
     EXPECT_EQ(mat[1][1], 4);
 }
 
+// Тесты для умножения матрицы на вектор
+TEST(MatrixTest, MatrixVectorProduct) {
+    Matrix<int> mat(2, 3);
+    mat[0][0] = 1; mat[0][1] = 2; mat[0][2] = 3;
+    mat[1][0] = 4; mat[1][1] = 5; mat[1][2] = 6;
+
+    Vector<int> vec(3);
+    vec[0] = 1; vec[1] = 0; vec[2] = -1;
+
+    Vector<int> result = mat * vec;
+
+    EXPECT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0], -2);  // (1 - 3)
+    EXPECT_EQ(result[1], -2);  // (4 - 6)
+}
+
+TEST(MatrixTest, VectorMatrixProduct) {
+    Matrix<int> mat(2, 3);
+    mat[0][0] = 1; mat[0][1] = 2; mat[0][2] = 3;
+    mat[1][0] = 4; mat[1][1] = 5; mat[1][2] = 6;
+
+    Vector<int> vec(2);
+    vec[0] = 1; vec[1] = 2;
+
+    Vector<int> result = vec * mat;
+
+    EXPECT_EQ(result.size(), 3u);
+    EXPECT_EQ(result[0], 9);   // (1 + 8)
+    EXPECT_EQ(result[1], 12);  // (2 + 10)
+    EXPECT_EQ(result[2], 15);  // (3 + 12)
+}
+
+TEST(MatrixTest, LargeMatrixVectorProductInParallel) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const int rows = 700, cols = 500;
+    Matrix<long long> mat(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            mat[i][j] = (i * 31 + j * 17) % 11 - 5;
+        }
+    }
+    Vector<long long> x(cols), y(rows);
+    for (int j = 0; j < cols; ++j) x[j] = j % 13;
+    for (int i = 0; i < rows; ++i) y[i] = i % 7 - 3;
+
+    Vector<long long> ax = mat * x;
+    Vector<long long> ya = y * mat;
+    pool.resize(threads);
+
+    for (int i = 0; i < rows; ++i) {
+        long long sum = 0;
+        for (int j = 0; j < cols; ++j) sum += mat[i][j] * x[j];
+        ASSERT_EQ(ax[i], sum);
+    }
+    for (int j = 0; j < cols; ++j) {
+        long long sum = 0;
+        for (int i = 0; i < rows; ++i) sum += y[i] * mat[i][j];
+        ASSERT_EQ(ya[j], sum);
+    }
+}
+
+TEST(MatrixTest, MatrixVectorSizeMismatch) {
+    Matrix<int> mat(2, 3);
+    Vector<int> vec(2);
+    EXPECT_THROW(mat * vec, std::invalid_argument);
+    EXPECT_THROW(Vector<int>(3) * mat, std::invalid_argument);
+}
+
+// Тест для составного присваивания на месте
+TEST(MatrixTest, InPlaceAddSubtract) {
+    Matrix<int> mat1(2, 2);
+    mat1[0][0] = 1; mat1[0][1] = 2;
+    mat1[1][0] = 3; mat1[1][1] = 4;
+
+    Matrix<int> mat2(2, 2);
+    mat2[0][0] = 5; mat2[0][1] = 6;
+    mat2[1][0] = 7; mat2[1][1] = 8;
+
+    mat1 += mat2;
+    EXPECT_EQ(mat1[1][1], 12);
+    mat1 -= mat2;
+    mat1 -= mat2;
+    EXPECT_EQ(mat1[0][0], -4);
+    EXPECT_EQ(mat1[1][0], -4);
+    EXPECT_THROW(mat1 += Matrix<int>(2, 3), std::invalid_argument);
+}
+
+// Тест для матрицы фиксированного размера
+TEST(MatrixTest, FixedSizeArithmetic) {
+    constexpr Matrix<int, 2, 3> a(1, 2, 3,
+                                  4, 5, 6);
+    constexpr Matrix<int, 3, 2> b(7, 8,
+                                  9, 10,
+                                  11, 12);
+
+    // Размеры проверяются на этапе компиляции, результат вычисляется там же
+    static_assert(a * b == Matrix<int, 2, 2>(58, 64, 139, 154));
+    static_assert(a.transpose() * Vector<int, 2>(1, 1) == Vector<int, 3>(5, 7, 9));
+    static_assert(Vector<int, 2>(1, 1) * a == Vector<int, 3>(5, 7, 9));
+    static_assert(Matrix<int, 3, 3>::identity().det() == 1);
+    static_assert(sizeof(Matrix<float, 4, 4>) == 16 * sizeof(float));
+
+    Matrix<int, 2, 3> c = a + a;
+    c -= a;
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(2 * a, a + a);
+    EXPECT_EQ(c[1][2], 6);
+    EXPECT_THROW(c[2], std::out_of_range);
+}
+
+// Тест для определителя и обратной матрицы 2x2, 3x3 и 4x4
+TEST(MatrixTest, FixedSizeInverse) {
+    Matrix<double, 2, 2> m2(4.0, 7.0,
+                            2.0, 6.0);
+    Matrix<double, 3, 3> m3(2.0, -1.0, 0.0,
+                            -1.0, 2.0, -1.0,
+                            0.0, -1.0, 2.0);
+    Matrix<double, 4, 4> m4(1.0, 2.0, 0.0, 1.0,
+                            0.0, 1.0, 3.0, 0.0,
+                            2.0, 0.0, 1.0, 1.0,
+                            1.0, 1.0, 0.0, 2.0);
+
+    EXPECT_DOUBLE_EQ(m2.det(), 10.0);
+    EXPECT_DOUBLE_EQ(m3.det(), 4.0);
+    EXPECT_DOUBLE_EQ(m4.det(), 16.0);
+    EXPECT_DOUBLE_EQ(m4.transpose().det(), 16.0);
+
+    auto expectIdentity = [](const auto& product) {
+        for (int i = 0; i < product.getRows(); ++i) {
+            for (int j = 0; j < product.getCols(); ++j) {
+                EXPECT_NEAR(product[i][j], i == j ? 1.0 : 0.0, 1e-12);
+            }
+        }
+    };
+    expectIdentity(m2 * m2.inverse());
+    expectIdentity(m3 * m3.inverse());
+    expectIdentity(m4 * m4.inverse());
+    expectIdentity(m4.inverse() * m4);
+
+    EXPECT_THROW((Matrix<double, 2, 2>(1.0, 2.0, 2.0, 4.0).inverse()), std::invalid_argument);
+}
+
+// Тест для преобразования между фиксированной и динамической матрицей
+TEST(MatrixTest, FixedSizeDynamicInterop) {
+    Matrix<int, 2, 2> fixed(1, 2, 3, 4);
+    Matrix<int> dynamic = fixed.toDynamic();
+
+    EXPECT_EQ(dynamic.getRows(), 2);
+    EXPECT_EQ(dynamic[1][0], 3);
+    EXPECT_EQ((Matrix<int, 2, 2>(dynamic)), fixed);
+    EXPECT_THROW((Matrix<int, 3, 2>(dynamic)), std::invalid_argument);
+}
+
+// Тест для строк, столбцов и диагонали как представлений
+TEST(MatrixTest, RowColumnDiagonalViews) {
+    Matrix<double> mat(3, 4);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            mat[i][j] = 10 * i + j;
+        }
+    }
+
+    auto column = mat.col(1);
+    EXPECT_EQ(column.size(), 3u);
+    EXPECT_EQ(column.stride(), 4u);
+    EXPECT_DOUBLE_EQ(column[2], 21.0);
+    EXPECT_DOUBLE_EQ(column.sum(), 1.0 + 11.0 + 21.0);
+    column[0] = -1.0;
+    EXPECT_DOUBLE_EQ(mat[0][1], -1.0);
+
+    const Matrix<double>& view = mat;
+    EXPECT_DOUBLE_EQ(view.diagonal().sum(), 0.0 + 11.0 + 22.0);
+    EXPECT_DOUBLE_EQ(view.col(3).max(), 23.0);
+    EXPECT_DOUBLE_EQ(view[1].dot(view[2]), 10.0 * 20.0 + 11.0 * 21.0 + 12.0 * 22.0 + 13.0 * 23.0);
+
+    // Столбец, записанный выражением из двух других столбцов
+    mat.col(0) = mat.col(2) + mat.col(3);
+    EXPECT_DOUBLE_EQ(mat[0][0], 5.0);
+    EXPECT_DOUBLE_EQ(mat[2][0], 45.0);
+
+    // Копирование столбца в вектор и в строку
+    const Vector<double> copy(mat.col(2));
+    EXPECT_DOUBLE_EQ(copy[1], 12.0);
+    mat[0].slice(0, 3) = mat.col(2);
+    EXPECT_DOUBLE_EQ(mat[0][2], 22.0);
+
+    EXPECT_THROW(mat.col(4), std::out_of_range);
+    EXPECT_THROW(mat.col(0) = mat[0], std::invalid_argument);
+}
+
+// Тест для подматриц с ведущей размерностью
+TEST(MatrixTest, BlockViews) {
+    Matrix<int> mat(4, 5);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            mat[i][j] = 10 * i + j;
+        }
+    }
+
+    auto block = mat.block(1, 2, 2, 3);
+    EXPECT_EQ(block.getRows(), 2);
+    EXPECT_EQ(block.getCols(), 3);
+    EXPECT_EQ(block.leadingDimension(), 5u);
+    EXPECT_EQ(block[0][0], 12);
+    EXPECT_EQ(block[1][2], 24);
+    EXPECT_EQ(block.col(1).sum(), 13 + 23);
+
+    // Вложенная подматрица и копирование в новую матрицу
+    const Matrix<int> inner(block.block(1, 1, 1, 2));
+    EXPECT_EQ(inner.getRows(), 1);
+    EXPECT_EQ(inner.getCols(), 2);
+    EXPECT_EQ(inner[0][0], 23);
+    EXPECT_EQ(inner[0][1], 24);
+
+    // Запись одного блока в другой и сложение на месте
+    mat.block(0, 0, 2, 3) = mat.block(2, 2, 2, 3);
+    EXPECT_EQ(mat[0][0], 22);
+    EXPECT_EQ(mat[1][2], 34);
+    EXPECT_EQ(mat[2][2], 22); // источник не изменился
+    Matrix<int> ones(2, 3);
+    ++ones;
+    mat.block(0, 0, 2, 3) += ones;
+    EXPECT_EQ(mat[0][0], 23);
+    mat.block(0, 0, 2, 3) -= ones;
+    EXPECT_EQ(mat[1][2], 34);
+
+    EXPECT_THROW(mat.block(3, 0, 2, 1), std::out_of_range);
+    EXPECT_THROW(mat.block(0, 0, 2, 2) = ones, std::invalid_argument);
+    EXPECT_THROW(Matrix<int>(std::vector<Vector<int>>{Vector<int>(2), Vector<int>(3)}), std::invalid_argument);
+}
+
+TEST(MatrixTest, OverlappingBlocks) {
+    Matrix<int> mat(3, 2);
+    for (int i = 0; i < 3; ++i) {
+        mat[i][0] = 10 * i;
+        mat[i][1] = 10 * i + 1;
+    }
+
+    // Блок, сдвинутый вниз, читает строки источника до их перезаписи
+    mat.block(1, 0, 2, 2) = mat.block(0, 0, 2, 2);
+    EXPECT_EQ(mat[1][0], 0);
+    EXPECT_EQ(mat[1][1], 1);
+    EXPECT_EQ(mat[2][0], 10);
+    EXPECT_EQ(mat[2][1], 11);
+
+    // Сдвиг вверх и по диагонали
+    mat.block(0, 0, 2, 2) += mat.block(1, 0, 2, 2);
+    EXPECT_EQ(mat[0][0], 0);
+    EXPECT_EQ(mat[1][1], 12);
+    Matrix<int> big(4, 4);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            big[i][j] = 4 * i + j;
+        }
+    }
+    big.block(1, 1, 3, 3) -= big.block(0, 0, 3, 3);
+    for (int i = 1; i < 4; ++i) {
+        for (int j = 1; j < 4; ++j) {
+            EXPECT_EQ(big[i][j], 5) << i << ' ' << j;
+        }
+    }
+}
+
+TEST(MatrixTest, MatrixProduct) {
+    Matrix<double> a(2, 3);
+    Matrix<double> b(3, 2);
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            a(i, j) = i + j + 1;
+            b(j, i) = i - j;
+        }
+    }
+    const Matrix<double> c = a * b;
+    EXPECT_EQ(c.getRows(), 2);
+    EXPECT_EQ(c.getCols(), 2);
+    // a = [1 2 3; 2 3 4], b = [0 1; -1 0; -2 -1]
+    EXPECT_DOUBLE_EQ(c(0, 0), -8.0);
+    EXPECT_DOUBLE_EQ(c(0, 1), -2.0);
+    EXPECT_DOUBLE_EQ(c(1, 0), -11.0);
+    EXPECT_DOUBLE_EQ(c(1, 1), -2.0);
+    EXPECT_THROW(a * a, std::invalid_argument);
+}
+
+TEST(MatrixTest, BoundsPolicies) {
+    Matrix<int> checked(2, 3);
+    checked(1, 2) = 7;
+    EXPECT_EQ(checked[1][2], 7);
+    EXPECT_EQ(checked.unchecked(1, 2), 7);
+    EXPECT_THROW(checked(2, 0), std::out_of_range);
+    EXPECT_THROW(checked(0, 3), std::out_of_range);
+
+    const Matrix<int>& constRef = checked;
+    EXPECT_EQ(constRef(1, 2), 7);
+    EXPECT_THROW(constRef[2], std::out_of_range);
+    EXPECT_THROW(checked[0][3], std::out_of_range);
+
+    // Без проверки индексов строки и элементы выдаются напрямую
+    Matrix<int, Dynamic, Dynamic, Unchecked> fast(2, 2);
+    fast(0, 1) = 3;
+    fast[1][0] = 4;
+    EXPECT_EQ(fast.unchecked(0, 1), 3);
+    EXPECT_EQ((fast * fast)(0, 0), 12);
+
+    // Представление строки наследует политику матрицы
+    Matrix<int, Dynamic, Dynamic, Unchecked> wide(4, 4);
+    wide(1, 1) = 9;
+    EXPECT_EQ(wide[0][5], 9);
+    EXPECT_EQ(std::as_const(wide)[0][5], 9);
+    const VectorView<const int> row = wide[0];
+    EXPECT_THROW(row[5], std::out_of_range);
+
+    constexpr Matrix<int, 2, 2, Unchecked> small(1, 2, 3, 4);
+    static_assert(small(1, 0) == 3);
+    static_assert(small[1][1] == 4);
+    static_assert((small * small).unchecked(0, 0) == 7);
+    EXPECT_THROW((Matrix<int, 2, 2>()(2, 0)), std::out_of_range);
+}
+
+TEST(MatrixTest, CopyOnWrite) {
+    Matrix<double> source(2, 3);
+    source(0, 0) = 1.0;
+    Matrix<double> a = source;
+    Matrix<double> b = a;
+    EXPECT_EQ(std::as_const(a).begin(), std::as_const(b).begin());
+
+    // Запись через представление строки отделяет копию
+    b[1][2] = 5.0;
+    EXPECT_NE(std::as_const(a).begin(), std::as_const(b).begin());
+    EXPECT_DOUBLE_EQ(a(1, 2), 0.0);
+    EXPECT_DOUBLE_EQ(b(1, 2), 5.0);
+    EXPECT_DOUBLE_EQ(b(0, 0), 1.0);
+
+    Matrix<double> c;
+    c = b;
+    c /= 2.0;
+    EXPECT_DOUBLE_EQ(c(1, 2), 2.5);
+    EXPECT_DOUBLE_EQ(b(1, 2), 5.0);
+
+    b += b;
+    EXPECT_DOUBLE_EQ(b(1, 2), 10.0);
+    EXPECT_EQ(a, Matrix<double>(a));
+}
+
+TEST(MatrixTest, CopyDoesNotSeeEarlierViews) {
+    Matrix<double> m(2, 2);
+    auto row = m[0];
+    Matrix<double> c = m;
+    row[0] = 7.0;
+    EXPECT_DOUBLE_EQ(m(0, 0), 7.0);
+    EXPECT_DOUBLE_EQ(c(0, 0), 0.0);
+
+    // Ссылка на элемент тоже не должна попадать в последующие копии
+    double& r = c(1, 1);
+    Matrix<double> d;
+    d = c;
+    r = 3.0;
+    EXPECT_DOUBLE_EQ(c(1, 1), 3.0);
+    EXPECT_DOUBLE_EQ(d(1, 1), 0.0);
+}
+
+TEST(MatrixTest, FilledMatrixIsShared) {
+    // Матрица, заполненная через operator[] и перемещённая на место, снова разделяется копиями
+    auto build = [] {
+        Matrix<double> m(3, 3);
+        for (size_t i = 0; i < 3; ++i) {
+            for (size_t j = 0; j < 3; ++j) {
+                m[i][j] = double(i * 3 + j);
+            }
+        }
+        return m;
+    };
+    Matrix<double> m;
+    m = build();
+    Matrix<double> copy = m;
+    EXPECT_EQ(std::as_const(copy).begin(), std::as_const(m).begin());
+    m(2, 1) = -1.0;
+    EXPECT_NE(std::as_const(copy).begin(), std::as_const(m).begin());
+    EXPECT_DOUBLE_EQ(std::as_const(copy)(2, 1), 7.0);
+
+    // Присваивание снимает пометку: старых ссылок на новые элементы нет
+    Matrix<double> filled(2, 2);
+    filled[0][0] = 1.0;
+    Matrix<double> own = filled;
+    EXPECT_NE(std::as_const(own).begin(), std::as_const(filled).begin());
+    filled = own;
+    Matrix<double> shared = filled;
+    EXPECT_EQ(std::as_const(shared).begin(), std::as_const(own).begin());
+
+    // Результаты библиотеки заполняются без пометки
+    Matrix<double> block(std::as_const(copy).block(0, 0, 2, 2));
+    Matrix<double> alias = block;
+    EXPECT_EQ(std::as_const(alias).begin(), std::as_const(block).begin());
+    EXPECT_DOUBLE_EQ(alias(1, 1), 4.0);
+}
+
+TEST(MatrixTest, MoveSemantics) {
+    static_assert(std::is_nothrow_move_constructible_v<Matrix<double>>);
+    static_assert(std::is_nothrow_move_assignable_v<Matrix<double>>);
+
+    Matrix<double> a(2, 2);
+    a(0, 0) = 1.0;
+    a(1, 1) = 4.0;
+
+    // Временный операнд отдаёт свой буфер результату
+    Matrix<double> t = a + a;
+    const double* buffer = std::as_const(t).begin();
+    Matrix<double> r = a - (std::move(t) + a);
+    EXPECT_EQ(std::as_const(r).begin(), buffer);
+    EXPECT_DOUBLE_EQ(r(0, 0), -2.0);
+    EXPECT_DOUBLE_EQ(r(1, 1), -8.0);
+
+    Matrix<double> m;
+    m = std::move(r);
+    EXPECT_EQ(m.getRows(), 2);
+    EXPECT_EQ(r.getRows(), 0);
+    EXPECT_EQ(std::as_const(m).begin(), buffer);
+}
+
+TEST(MatrixTest, LazyExpressions) {
+    Matrix<double> a(3, 4), b(3, 4);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 4; ++j) {
+            a(i, j) = double(i * 4 + j);
+            b(i, j) = 1.0;
+        }
+    }
+
+    // Цепочка операций — ленивое выражение, вычисляемое за один проход
+    const auto e = a * 2.0 - b + a / 2.0;
+    static_assert(!std::is_same_v<std::decay_t<decltype(e)>, Matrix<double>>);
+    EXPECT_EQ(e.getRows(), 3);
+    EXPECT_DOUBLE_EQ(e(2, 3), 11.0 * 2.5 - 1.0);
+    const Matrix<double> c = e;
+    EXPECT_DOUBLE_EQ(c(1, 2), 6.0 * 2.5 - 1.0);
+
+    // Редукции по выражению не создают матрицу результата
+    EXPECT_DOUBLE_EQ((a - b).sum(), 66.0 - 12.0);
+    EXPECT_DOUBLE_EQ((a - a).frobeniusNorm(), 0.0);
+    EXPECT_DOUBLE_EQ((2.0 * b).squaredNorm(kernels::Summation::Compensated), 48.0);
+
+    // Составные операторы работают на месте, операнды могут совпадать с целью
+    const double* buffer = std::as_const(a).begin();
+    a += b * 3.0;
+    a -= b;
+    a /= 2.0;
+    a *= 4.0;
+    EXPECT_EQ(std::as_const(a).begin(), buffer);
+    EXPECT_DOUBLE_EQ(a(0, 1), (1.0 + 2.0) * 2.0);
+    a = a - a / 2.0;
+    EXPECT_EQ(std::as_const(a).begin(), buffer);
+    EXPECT_DOUBLE_EQ(a(0, 1), 3.0);
+
+    EXPECT_THROW(a /= 0.0, std::invalid_argument);
+    EXPECT_DOUBLE_EQ(a(0, 1), 3.0);
+    EXPECT_THROW(a + Matrix<double>(4, 3), std::invalid_argument);
+    EXPECT_THROW(a -= Matrix<double>(3, 3), std::invalid_argument);
+}
+
+TEST(MatrixTest, LazyReductionIsDeterministic) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    Matrix<double> a(300, 400), b(300, 400);
+    for (int i = 0; i < 300; ++i) {
+        for (int j = 0; j < 400; ++j) {
+            a(i, j) = 1.0 / (1 + i + j);
+            b(i, j) = 0.5;
+        }
+    }
+    // Результат совпадает с редукцией готовой матрицы и не зависит от числа потоков
+    const Matrix<double> r = a - b * 0.25;
+    const double expected = r.frobeniusNorm();
+    pool.resize(4);
+    kernels::setExecution(kernels::Execution::Parallel);
+    EXPECT_DOUBLE_EQ((a - b * 0.25).frobeniusNorm(), expected);
+    EXPECT_DOUBLE_EQ((a - b * 0.25).sum(), r.sum());
+    kernels::setExecution(kernels::Execution::Auto);
+    pool.resize(threads);
+    EXPECT_DOUBLE_EQ((a - b * 0.25).frobeniusNorm(), expected);
+}
+
 // Запуск тестов
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
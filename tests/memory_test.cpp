@@ -0,0 +1,159 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include "../include/kernels/memory.hpp"
+#include "../include/types/half.hpp"
+#include "../include/types/matrix.hpp"
+
+namespace {
+
+// Ресурс-обёртка, считающая выделения и освобождения
+class CountingResource final : public std::pmr::memory_resource {
+public:
+    size_t allocations = 0;
+    size_t deallocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+bool aligned(const void* p, size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+bool inside(const void* p, const std::byte* lo, const std::byte* hi) {
+    return static_cast<const std::byte*>(p) >= lo && static_cast<const std::byte*>(p) < hi;
+}
+
+} // namespace
+
+// Тест выравнивания: элементы начинаются на границе строки кэша при любом размере
+TEST(MemoryTest, BuffersAreCacheLineAligned) {
+    for (size_t n : {1, 3, 17, 1000}) {
+        const Vector<double> v(n);
+        EXPECT_TRUE(aligned(v.begin(), kernels::kBufferAlignment));
+        const Vector<Half> h(n);
+        EXPECT_TRUE(aligned(h.begin(), kernels::kBufferAlignment));
+        const Matrix<float> m(static_cast<int>(n), 3);
+        EXPECT_TRUE(aligned(m.begin(), kernels::kBufferAlignment));
+    }
+    const Vector<double> a(5);
+    const Vector<double> sum = a + a;
+    EXPECT_TRUE(aligned(sum.begin(), kernels::kBufferAlignment));
+    EXPECT_EQ(a.resource(), kernels::alignedResource());
+}
+
+// Тест арены: временные результаты в области видимости берутся из арены
+TEST(MemoryTest, ScopedArena) {
+    alignas(64) std::byte storage[1 << 14];
+    std::pmr::monotonic_buffer_resource arena(storage, sizeof(storage), std::pmr::null_memory_resource());
+    const std::byte* end = storage + sizeof(storage);
+    {
+        kernels::ScopedResource scope(&arena);
+        Vector<double> a(64);
+        a += 1.0;
+        const Vector<double> b = a * 2.0 + a;
+        const Matrix<double> m(4, 4);
+        EXPECT_TRUE(inside(std::as_const(a).begin(), storage, end));
+        EXPECT_TRUE(inside(b.begin(), storage, end));
+        EXPECT_TRUE(inside(m.begin(), storage, end));
+        EXPECT_TRUE(aligned(b.begin(), kernels::kBufferAlignment));
+        EXPECT_DOUBLE_EQ(b[63], 3.0);
+    }
+    const Vector<double> outside(8);
+    EXPECT_FALSE(inside(outside.begin(), storage, end));
+    EXPECT_EQ(kernels::defaultResource(), kernels::alignedResource());
+}
+
+// Тест явного ресурса: копия при записи выделяется из того же ресурса
+TEST(MemoryTest, ExplicitResource) {
+    CountingResource counting;
+    {
+        Vector<double> a(16, &counting);
+        EXPECT_EQ(a.resource(), &counting);
+        Vector<double> b = a;
+        b[0] = 1.0;
+        EXPECT_EQ(b.resource(), &counting);
+        EXPECT_EQ(counting.allocations, 2u);
+
+        Matrix<double> m(3, 3, &counting);
+        Matrix<double> copy = m;
+        copy(1, 1) = 2.0;
+        EXPECT_EQ(copy.resource(), &counting);
+        EXPECT_DOUBLE_EQ(m(1, 1), 0.0);
+        EXPECT_EQ(counting.allocations, 4u);
+    }
+    EXPECT_EQ(counting.deallocations, 4u);
+
+    kernels::setDefaultResource(&counting);
+    { const Vector<int> v(4); }
+    kernels::setDefaultResource(nullptr);
+    EXPECT_EQ(counting.allocations, 5u);
+    EXPECT_EQ(kernels::defaultResource(), kernels::alignedResource());
+}
+
+// Тест больших блоков: они выравниваются на границу большой страницы
+TEST(MemoryTest, HugePageBlocks) {
+    kernels::AlignedResource resource(kernels::kHugePageBytes);
+    void* small = resource.allocate(1000, 8);
+    EXPECT_TRUE(aligned(small, kernels::kBufferAlignment));
+    resource.deallocate(small, 1000, 8);
+
+    const size_t bytes = kernels::kHugePageBytes + 12345;
+    void* big = resource.allocate(bytes, 64);
+    EXPECT_TRUE(aligned(big, kernels::kHugePageBytes));
+    resource.deallocate(big, bytes, 64);
+
+    Vector<double> v(kernels::kHugePageBytes / sizeof(double), &resource);
+    v += 1.0;
+    EXPECT_DOUBLE_EQ(v.sum(), double(v.size()));
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
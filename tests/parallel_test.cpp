@@ -0,0 +1,144 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "../include/kernels/parallel.hpp"
+#include "../include/types/vector.hpp"
+
+// Тест для разбиения: куски покрывают массив и начинаются на границах страниц
+TEST(ParallelTest, ChunksArePageAligned) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+    kernels::setExecution(kernels::Execution::Parallel);
+
+    std::vector<double> buffer(1000003);
+    const double* out = buffer.data() + 3; // намеренно не выровнен
+    const size_t n = buffer.size() - 3;
+    std::mutex mutex;
+    std::vector<std::pair<size_t, size_t>> ranges;
+    kernels::forEachChunk(n, out, [&](size_t lo, size_t hi) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ranges.emplace_back(lo, hi);
+    });
+    std::sort(ranges.begin(), ranges.end());
+
+    ASSERT_GT(ranges.size(), 1u);
+    EXPECT_EQ(ranges.front().first, 0u);
+    EXPECT_EQ(ranges.back().second, n);
+    for (size_t c = 1; c < ranges.size(); ++c) {
+        EXPECT_EQ(ranges[c].first, ranges[c - 1].second);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(out + ranges[c].first) % kernels::kPageBytes, 0u);
+    }
+
+    kernels::setExecution(kernels::Execution::Auto);
+    pool.resize(threads);
+}
+
+// Тест для короткого массива: один вызов без пула
+TEST(ParallelTest, SmallArraysStaySerial) {
+    std::vector<float> buffer(1000);
+    size_t calls = 0;
+    kernels::forEachChunk(buffer.size(), buffer.data(), [&](size_t lo, size_t hi) {
+        ++calls;
+        EXPECT_EQ(lo, 0u);
+        EXPECT_EQ(hi, buffer.size());
+    });
+    EXPECT_EQ(calls, 1u);
+
+    kernels::setExecution(kernels::Execution::Serial);
+    EXPECT_FALSE(kernels::runsInParallel(1ull << 40));
+    kernels::setExecution(kernels::Execution::Auto);
+    EXPECT_FALSE(kernels::runsInParallel(kernels::kParallelBytes - 1));
+    EXPECT_TRUE(kernels::runsInParallel(kernels::kParallelBytes));
+}
+
+// Тест для политик: результаты совпадают побитово
+TEST(ParallelTest, PoliciesGiveIdenticalResults) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const size_t n = 3000001;
+    Vector<double> a(n), b(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = 1.0 / (1.0 + i);
+        b[i] = (i % 17) - 8.0;
+    }
+
+    kernels::setExecution(kernels::Execution::Serial);
+    const Vector<double> serial = a * b + a;
+    const double serialSum = serial.sum();
+    const double serialDot = a.dot(b, kernels::Summation::Compensated);
+
+    kernels::setExecution(kernels::Execution::Parallel);
+    const Vector<double> parallel = a * b + a;
+    EXPECT_EQ(parallel, serial);
+    EXPECT_EQ(parallel.sum(), serialSum);
+    EXPECT_EQ(a.dot(b, kernels::Summation::Compensated), serialDot);
+
+    Vector<double> inPlace(a);
+    inPlace += b;
+    EXPECT_DOUBLE_EQ(inPlace[n - 1], a[n - 1] + b[n - 1]);
+    const Vector<double> zeros(n);
+    EXPECT_EQ(zeros.normInf(), 0.0);
+
+    kernels::setExecution(kernels::Execution::Auto);
+    pool.resize(threads);
+}
+
+// Тест для пула: после resize новые потоки не принимают прошлое задание за новое
+TEST(ParallelTest, ResizeBetweenJobs) {
+    kernels::ThreadPool pool(2);
+    std::atomic<size_t> count{0};
+    pool.run(8, [&](size_t) { count.fetch_add(1); });
+    EXPECT_EQ(count.load(), 8u);
+
+    for (size_t round = 0; round < 50; ++round) {
+        pool.resize(2 + round % 3);
+        for (size_t job = 0; job < 4; ++job) {
+            count.store(0);
+            pool.run(16, [&](size_t) { count.fetch_add(1); });
+            // run() возвращается только после завершения всех задач
+            ASSERT_EQ(count.load(), 16u) << round;
+        }
+    }
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include "../include/linalg/qr.hpp"
+#include "test_utils.hpp"
+
+TEST(QRTest, LineFit) {
+    // y = 1 + 2x, точки без шума
+    Matrix<double> mat(4, 2);
+    Vector<double> y(4);
+    for (int i = 0; i < 4; ++i) {
+        mat[i][0] = 1.0;
+        mat[i][1] = i;
+        y[i] = 1.0 + 2.0 * i;
+    }
+
+    Vector<double> x = leastSquares(mat, y);
+
+    EXPECT_NEAR(x[0], 1.0, 1e-12);
+    EXPECT_NEAR(x[1], 2.0, 1e-12);
+}
+
+TEST(QRTest, LeastSquaresResidualIsOrthogonal) {
+    const int m = 40, n = 6;
+    Matrix<double> mat = randomMatrix(m, n, 11);
+    Vector<double> b(m);
+    for (int i = 0; i < m; ++i) {
+        b[i] = std::sin(i);
+    }
+
+    Vector<double> x = QR<double>(mat).solve(b);
+
+    // A^T (A x - b) = 0
+    for (int j = 0; j < n; ++j) {
+        double sum = 0.0;
+        for (int i = 0; i < m; ++i) {
+            double r = -b[i];
+            for (int k = 0; k < n; ++k) {
+                r += mat[i][k] * x[k];
+            }
+            sum += mat[i][j] * r;
+        }
+        EXPECT_NEAR(sum, 0.0, 1e-10);
+    }
+}
+
+TEST(QRTest, FactorsInParallel) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+    const int m = 300, n = 140;
+    Matrix<double> mat = randomMatrix(m, n, 5);
+    QR<double> qr(mat);
+    Matrix<double> q = qr.getQ();
+    Matrix<double> r = qr.getR();
+    Matrix<double> product = q * r;
+    pool.resize(threads);
+
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            EXPECT_NEAR(product[i][j], mat[i][j], 1e-10);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double dot = 0.0;
+            for (int k = 0; k < m; ++k) {
+                dot += q[k][i] * q[k][j];
+            }
+            EXPECT_NEAR(dot, i == j ? 1.0 : 0.0, 1e-10);
+        }
+        for (int j = 0; j < i; ++j) {
+            EXPECT_EQ(r[i][j], 0.0);
+        }
+    }
+}
+
+// Тесты на исключения
+TEST(QRTest, Wide) {
+    Matrix<double> mat(2, 3);
+    EXPECT_THROW(QR<double> qr(mat), std::invalid_argument);
+}
+
+TEST(QRTest, RankDeficient) {
+    Matrix<double> mat(3, 2);
+    mat[0][0] = 1; mat[0][1] = 2;
+    mat[1][0] = 2; mat[1][1] = 4;
+    mat[2][0] = 3; mat[2][1] = 6;
+    // Второй столбец пропорционален первому
+    QR<double> qr(mat);
+    Matrix<double> r = qr.getR();
+    EXPECT_NEAR(r[1][1], 0.0, 1e-12);
+}
+
+TEST(QRTest, SolveRejectsDependentColumn) {
+    // Третий столбец - точная линейная комбинация первых двух, r_22 лишь близко к нулю
+    Matrix<double> mat = randomMatrix(8, 3, 4);
+    for (int i = 0; i < 8; ++i) {
+        mat[i][2] = 0.3 * mat[i][0] - 1.7 * mat[i][1];
+    }
+    QR<double> qr(mat);
+    EXPECT_THROW(qr.solve(Vector<double>(8)), std::invalid_argument);
+    EXPECT_THROW(qr.solve(Matrix<double>(8, 2)), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
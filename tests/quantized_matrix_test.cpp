@@ -0,0 +1,170 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include "../include/types/quantized_matrix.hpp"
+
+namespace {
+
+Matrix<float> randomMatrix(int rows, int cols, float lo, float hi, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(lo, hi);
+    Matrix<float> m(rows, cols);
+    for (float* p = m.begin(); p != m.end(); ++p) {
+        *p = dist(gen);
+    }
+    return m;
+}
+
+} // namespace
+
+// Тест для точности целочисленного ядра на всех наборах инструкций
+TEST(QuantizedMatrixTest, Int8KernelIsExact) {
+    const size_t m = 9;
+    const size_t n = 11; // не кратно блоку из четырёх строк
+    const size_t k = 200; // хвост после 64- и 16-байтных шагов
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(-128, 127);
+    std::vector<std::int8_t> a(m * k);
+    std::vector<std::int8_t> b(n * k);
+    for (auto& x : a) {
+        x = static_cast<std::int8_t>(dist(gen));
+    }
+    for (auto& x : b) {
+        x = static_cast<std::int8_t>(dist(gen));
+    }
+    // Крайние значения: пары -128 * -128 переполнили бы vpmaddubsw
+    std::fill(a.begin(), a.begin() + k, std::int8_t(-128));
+    std::fill(b.begin(), b.begin() + k, std::int8_t(-128));
+
+    std::vector<std::int32_t> expected(m * n);
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            for (size_t p = 0; p < k; ++p) {
+                expected[i * n + j] += a[i * k + p] * b[j * k + p];
+            }
+        }
+    }
+    EXPECT_EQ(expected[0], 128 * 128 * static_cast<std::int32_t>(k));
+
+    const kernels::Isa isa = kernels::activeIsa();
+    for (kernels::Isa target : {kernels::Isa::Scalar, kernels::Isa::SSE2, kernels::Isa::AVX2, kernels::Isa::AVX512}) {
+        kernels::setIsa(target);
+        std::vector<std::int32_t> c(m * n, -1);
+        kernels::gemmInt8(m, n, k, a.data(), k, b.data(), k, c.data(), n);
+        EXPECT_EQ(c, expected);
+    }
+    kernels::setIsa(isa);
+}
+
+// Тест для квантования и обратного преобразования
+TEST(QuantizedMatrixTest, QuantizeDequantize) {
+    const Matrix<float> source = randomMatrix(6, 40, -3.0f, 5.0f, 1);
+    for (QuantAxis axis : {QuantAxis::Row, QuantAxis::Column}) {
+        for (QuantScheme scheme : {QuantScheme::Symmetric, QuantScheme::Asymmetric}) {
+            const auto q = QuantizedMatrix<float>::quantize(source, axis, scheme);
+            const Matrix<float> back = q.dequantize();
+            for (int i = 0; i < source.getRows(); ++i) {
+                for (int j = 0; j < source.getCols(); ++j) {
+                    const float s = q.scale(axis == QuantAxis::Row ? i : j);
+                    ASSERT_LE(std::abs(back(i, j) - source(i, j)), 0.5f * s + 1e-6f);
+                }
+            }
+            if (scheme == QuantScheme::Symmetric) {
+                EXPECT_EQ(q.zeroPoint(0), 0);
+            }
+        }
+    }
+
+    // Ноль представим точно, нулевая строка не делит на ноль
+    Matrix<float> zeros(2, 3);
+    zeros(1, 1) = 2.0f;
+    const auto q = QuantizedMatrix<float>::quantize(zeros, QuantAxis::Row);
+    EXPECT_EQ(q.dequantize()(0, 2), 0.0f);
+    EXPECT_EQ(q.dequantize()(1, 0), 0.0f);
+    EXPECT_FLOAT_EQ(q.dequantize()(1, 1), 2.0f);
+    EXPECT_THROW(q.scale(2), std::out_of_range);
+    EXPECT_THROW(q(0, 3), std::out_of_range);
+}
+
+// Тест для квантованного произведения матриц
+TEST(QuantizedMatrixTest, Product) {
+    const Matrix<float> a = randomMatrix(33, 150, -1.0f, 2.0f, 2);
+    const Matrix<float> b = randomMatrix(150, 21, -0.5f, 0.5f, 3);
+    const Matrix<float> expected = a * b;
+
+    const auto qa = QuantizedMatrix<float>::quantize(a, QuantAxis::Row);
+    const auto qb = QuantizedMatrix<float>::quantize(b, QuantAxis::Column, QuantScheme::Symmetric);
+    const Matrix<float> c = qa * qb;
+
+    // Сравнение с точным произведением деквантованных матриц и с исходным
+    const Matrix<float> reference = qa.dequantize() * qb.dequantize();
+    float worst = 0.0f;
+    for (int i = 0; i < c.getRows(); ++i) {
+        for (int j = 0; j < c.getCols(); ++j) {
+            ASSERT_NEAR(c(i, j), reference(i, j), 1e-3f);
+            worst = std::max(worst, std::abs(c(i, j) - expected(i, j)));
+        }
+    }
+    EXPECT_LT(worst, 0.1f);
+
+    EXPECT_THROW(qb * qa, std::invalid_argument);
+    const auto wrong = QuantizedMatrix<float>::quantize(b, QuantAxis::Row);
+    EXPECT_THROW(qa * wrong, std::invalid_argument);
+    const auto small = QuantizedMatrix<float>::quantize(Matrix<float>(2, 3), QuantAxis::Column);
+    EXPECT_THROW(qa * small, std::invalid_argument);
+}
+
+// Тест границы глубины: при k * 127 * 127 на грани int32 сумма ещё точна, дальше исключение
+TEST(QuantizedMatrixTest, ProductDepthLimit) {
+    const size_t k = kernels::kInt8MaxDepth - 1;
+    Matrix<double> a(1, k);
+    Matrix<double> b(k, 1);
+    ++a;
+    ++b;
+    const auto qa = QuantizedMatrix<double>::quantize(a, QuantAxis::Row, QuantScheme::Symmetric);
+    const auto qb = QuantizedMatrix<double>::quantize(b, QuantAxis::Column, QuantScheme::Symmetric);
+    EXPECT_NEAR((qa * qb)(0, 0), static_cast<double>(k), 1e-9 * k);
+
+    Matrix<double> wide(1, k + 1);
+    Matrix<double> tall(k + 1, 1);
+    ++wide;
+    ++tall;
+    const auto qw = QuantizedMatrix<double>::quantize(wide, QuantAxis::Row, QuantScheme::Symmetric);
+    const auto qt = QuantizedMatrix<double>::quantize(tall, QuantAxis::Column, QuantScheme::Symmetric);
+    EXPECT_THROW(qw * qt, std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
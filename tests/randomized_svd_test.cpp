@@ -0,0 +1,167 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include "../include/linalg/randomized_svd.hpp"
+
+// Матрица со спектром decay^i и случайными сингулярными векторами
+static Matrix<double> decayingMatrix(int m, int n, double decay, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> dist;
+    const int r = std::min(m, n);
+    Matrix<double> x(m, r), y(n, r);
+    for (double& value : x) {
+        value = dist(gen);
+    }
+    for (double& value : y) {
+        value = dist(gen);
+    }
+    x = QR<double>(x).getQ();
+    y = QR<double>(y).getQ();
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < r; ++j) {
+            x(i, j) *= std::pow(decay, j);
+        }
+    }
+    Matrix<double> mat(m, n);
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            for (int p = 0; p < r; ++p) {
+                mat(i, j) += x(i, p) * y(j, p);
+            }
+        }
+    }
+    return mat;
+}
+
+// Ошибка лучшего приближения ранга k по теореме Эккарта-Янга
+static double optimalError(int r, int k, double decay) {
+    double sum = 0.0;
+    for (int i = k; i < r; ++i) {
+        sum += std::pow(decay, 2 * i);
+    }
+    return std::sqrt(sum);
+}
+
+TEST(RandomizedSVDTest, ExactLowRank) {
+    // Ранг 6: приближение ранга 6 восстанавливает матрицу
+    Matrix<double> mat = decayingMatrix(80, 50, 0.5, 1);
+    for (int i = 0; i < 80; ++i) {
+        for (int j = 6; j < 50; ++j) {
+            mat(i, j) = mat(i, j % 6) * (j + 1);
+        }
+    }
+    RandomizedSVD<double> rsvd(mat, 6);
+    Vector<double> expected = singularValues(mat);
+    Vector<double> s = rsvd.getSingularValues();
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_NEAR(s[i], expected[i], 1e-10 * expected[0]);
+    }
+    EXPECT_LT(rsvd.getRelativeError(), 1e-12);
+}
+
+TEST(RandomizedSVDTest, NearOptimalError) {
+    for (auto [m, n] : {std::pair{150, 90}, {90, 150}}) {
+        Matrix<double> mat = decayingMatrix(m, n, 0.8, m);
+        RandomizedSVD<double> rsvd(mat, 10);
+        const double optimal = optimalError(std::min(m, n), 10, 0.8);
+        EXPECT_LT(rsvd.getError(), 1.01 * optimal);
+        EXPECT_GE(rsvd.getError(), optimal * (1 - 1e-9));
+
+        Vector<double> s = rsvd.getSingularValues();
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_NEAR(s[i], std::pow(0.8, i), 1e-3);
+        }
+
+        // Ортонормальность U и V
+        Matrix<double> u = rsvd.getU();
+        Matrix<double> v = rsvd.getV();
+        for (int i = 0; i < 10; ++i) {
+            for (int j = 0; j < 10; ++j) {
+                double uu = 0.0, vv = 0.0;
+                for (int p = 0; p < m; ++p) {
+                    uu += u(p, i) * u(p, j);
+                }
+                for (int p = 0; p < n; ++p) {
+                    vv += v(p, i) * v(p, j);
+                }
+                EXPECT_NEAR(uu, i == j ? 1.0 : 0.0, 1e-12);
+                EXPECT_NEAR(vv, i == j ? 1.0 : 0.0, 1e-12);
+            }
+        }
+    }
+}
+
+TEST(RandomizedSVDTest, PowerIterationsSharpenFlatSpectrum) {
+    Matrix<double> mat = decayingMatrix(200, 120, 0.98, 4);
+    RandomizedOptions plain;
+    plain.oversampling = 2;
+    plain.powerIterations = 0;
+    RandomizedOptions sharpened = plain;
+    sharpened.powerIterations = 3;
+    const double before = RandomizedSVD<double>(mat, 10, plain).getError();
+    const double after = RandomizedSVD<double>(mat, 10, sharpened).getError();
+    EXPECT_LT(after, before);
+    EXPECT_LT(after, 1.02 * optimalError(120, 10, 0.98));
+}
+
+TEST(RandomizedSVDTest, ReconstructMatchesError) {
+    Matrix<double> mat = decayingMatrix(60, 40, 0.7, 2);
+    RandomizedSVD<double> rsvd(mat, 5);
+    Matrix<double> approx = rsvd.reconstruct();
+    double sum = 0.0;
+    for (int i = 0; i < 60; ++i) {
+        for (int j = 0; j < 40; ++j) {
+            sum += (mat(i, j) - approx(i, j)) * (mat(i, j) - approx(i, j));
+        }
+    }
+    EXPECT_NEAR(std::sqrt(sum), rsvd.getError(), 1e-12);
+
+    // Одинаковое зерно даёт одинаковый результат
+    RandomizedSVD<double> again(mat, 5);
+    EXPECT_EQ(again.getError(), rsvd.getError());
+}
+
+TEST(RandomizedSVDTest, InvalidArguments) {
+    Matrix<double> mat(10, 4);
+    EXPECT_THROW(RandomizedSVD<double>(mat, 5), std::invalid_argument);
+
+    RandomizedOptions options;
+    options.computeError = false;
+    RandomizedSVD<double> rsvd(decayingMatrix(10, 4, 0.5, 3), 2, options);
+    EXPECT_THROW(rsvd.getError(), std::logic_error);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -27,6 +27,8 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 #include <gtest/gtest.h>
+#include <type_traits>
+#include <utility>
 #include "../include/types/rational.hpp" // Предполагается, что Rational объявлен здесь
 
 class RationalTests : public ::testing::Test {
@@ -127,6 +129,21 @@ TEST_F(RationalTests, InputStream) {
     EXPECT_EQ(r.getDenominator(), 4);
 }
 
+TEST_F(RationalTests, MoveLeavesSource) {
+    static_assert(std::is_nothrow_move_constructible_v<Rational<int>>);
+    static_assert(std::is_nothrow_move_assignable_v<Rational<int>>);
+    static_assert(std::is_trivially_copyable_v<Rational<int>>);
+
+    // Перемещение — обычное копирование, источник не меняется
+    Rational<int> a(3, 4);
+    Rational<int> b(std::move(a));
+    EXPECT_EQ(a, Rational<int>(3, 4));
+    Rational<int> c;
+    c = std::move(b);
+    EXPECT_EQ(b, Rational<int>(3, 4));
+    EXPECT_EQ(c, Rational<int>(3, 4));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,112 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "../include/kernels/reduce.hpp"
+
+using kernels::Isa;
+using kernels::Summation;
+
+static std::vector<Isa> availableIsas() {
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+        if (isa <= kernels::supportedIsa()) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+// Сравнение с простыми циклами для всех длин и наборов инструкций
+template<typename T>
+static void checkReductions() {
+    for (Isa isa : availableIsas()) {
+        kernels::setIsa(isa);
+        for (size_t n = 1; n < 100; ++n) {
+            std::vector<T> x(n), y(n);
+            for (size_t i = 0; i < n; ++i) {
+                x[i] = static_cast<T>((i * 7) % 13) - static_cast<T>(6);
+                y[i] = static_cast<T>(i % 5 + 1);
+            }
+            T sum = 0, dot = 0, asum = 0, amax = 0;
+            size_t argmin = 0, argmax = 0;
+            for (size_t i = 0; i < n; ++i) {
+                sum += x[i];
+                dot += x[i] * y[i];
+                asum += x[i] < 0 ? -x[i] : x[i];
+                amax = std::max(amax, x[i] < 0 ? -x[i] : x[i]);
+                argmin = x[i] < x[argmin] ? i : argmin;
+                argmax = x[i] > x[argmax] ? i : argmax;
+            }
+            for (Summation mode : {Summation::Plain, Summation::Compensated}) {
+                EXPECT_EQ(kernels::sum(n, x.data(), mode), sum) << "n = " << n;
+                EXPECT_EQ(kernels::dot(n, x.data(), y.data(), mode), dot) << "n = " << n;
+                EXPECT_EQ(kernels::asum(n, x.data(), mode), asum) << "n = " << n;
+            }
+            EXPECT_EQ(kernels::amax(n, x.data()), amax);
+            const kernels::MinMax<T> m = kernels::minmax(n, x.data());
+            EXPECT_EQ(m.argmin, argmin);
+            EXPECT_EQ(m.argmax, argmax);
+            EXPECT_EQ(m.min, x[argmin]);
+            EXPECT_EQ(m.max, x[argmax]);
+        }
+    }
+    kernels::setIsa(Isa::AVX512);
+}
+
+TEST(ReduceTest, AllTypesAndInstructionSets) {
+    checkReductions<float>();
+    checkReductions<double>();
+    checkReductions<std::int32_t>();
+    checkReductions<std::int64_t>();
+}
+
+// Компенсированное суммирование не накапливает ошибку округления
+TEST(ReduceTest, CompensatedSummation) {
+    const size_t n = 1 << 22;
+    std::vector<float> x(n, 1.0f);
+    x[0] = 1e8f;
+
+    // Обычная сумма в float теряет единицы рядом с 1e8
+    const double exact = 1e8 + (n - 1);
+    EXPECT_NEAR(kernels::sum(n, x.data(), Summation::Compensated), exact, 8.0);
+    EXPECT_GT(std::abs(kernels::sum(n, x.data(), Summation::Plain) - exact), 8.0);
+
+    std::vector<double> z(1000, 3.0);
+    EXPECT_DOUBLE_EQ(kernels::nrm2(z.size(), z.data()), 3.0 * std::sqrt(1000.0));
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
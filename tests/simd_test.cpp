@@ -0,0 +1,121 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "../include/kernels/simd.hpp"
+
+using kernels::BinaryOp;
+using kernels::Isa;
+
+// Все наборы инструкций, которые поддерживает процессор
+static std::vector<Isa> availableIsas() {
+    std::vector<Isa> isas;
+    for (Isa isa : {Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+        if (isa <= kernels::supportedIsa()) {
+            isas.push_back(isa);
+        }
+    }
+    return isas;
+}
+
+// Сравнение с поэлементным вычислением для всех длин, включая хвосты
+template<BinaryOp op, typename T>
+static void checkBinary() {
+    for (Isa isa : availableIsas()) {
+        kernels::setIsa(isa);
+        for (size_t n = 0; n < 70; ++n) {
+            std::vector<T> a(n + 1), b(n + 1), out(n + 1);
+            for (size_t i = 0; i <= n; ++i) {
+                a[i] = static_cast<T>(3 * i + 1);
+                b[i] = static_cast<T>(i % 7 + 1);
+            }
+            // Смещение на один элемент делает данные невыровненными
+            kernels::binary<op>(n, a.data() + 1, b.data() + 1, out.data() + 1);
+            for (size_t i = 1; i <= n; ++i) {
+                T expected = op == BinaryOp::Add ? a[i] + b[i]
+                           : op == BinaryOp::Sub ? a[i] - b[i]
+                           : op == BinaryOp::Mul ? a[i] * b[i]
+                           : a[i] / b[i];
+                EXPECT_EQ(out[i], expected) << "n = " << n << ", isa = " << static_cast<int>(isa);
+            }
+            // На месте: результат в первом операнде
+            kernels::binary<op>(n, a.data(), b.data(), a.data());
+        }
+    }
+    kernels::setIsa(Isa::AVX512);
+}
+
+TEST(SimdTest, FloatingPointKernels) {
+    checkBinary<BinaryOp::Add, float>();
+    checkBinary<BinaryOp::Sub, float>();
+    checkBinary<BinaryOp::Mul, float>();
+    checkBinary<BinaryOp::Div, float>();
+    checkBinary<BinaryOp::Add, double>();
+    checkBinary<BinaryOp::Sub, double>();
+    checkBinary<BinaryOp::Mul, double>();
+    checkBinary<BinaryOp::Div, double>();
+}
+
+TEST(SimdTest, IntegerKernels) {
+    checkBinary<BinaryOp::Add, std::int32_t>();
+    checkBinary<BinaryOp::Sub, std::int32_t>();
+    checkBinary<BinaryOp::Mul, std::int32_t>();
+    checkBinary<BinaryOp::Add, std::int64_t>();
+    checkBinary<BinaryOp::Sub, std::int64_t>();
+    checkBinary<BinaryOp::Mul, std::int64_t>();
+}
+
+// Тест для поиска нуля перед делением
+TEST(SimdTest, AnyZero) {
+    for (Isa isa : availableIsas()) {
+        kernels::setIsa(isa);
+        for (size_t n = 1; n < 40; ++n) {
+            std::vector<double> x(n, 1.5);
+            EXPECT_FALSE(kernels::anyZero(n, x.data()));
+            for (size_t z = 0; z < n; ++z) {
+                x[z] = 0.0;
+                EXPECT_TRUE(kernels::anyZero(n, x.data()));
+                x[z] = 1.5;
+            }
+        }
+        std::vector<std::int32_t> y = {1, 2, 3, 4, 5, 6, 7, 8, 9, 0};
+        EXPECT_TRUE(kernels::anyZero(y.size(), y.data()));
+        EXPECT_FALSE(kernels::anyZero(y.size() - 1, y.data()));
+    }
+    kernels::setIsa(Isa::AVX512);
+    EXPECT_EQ(kernels::activeIsa(), kernels::supportedIsa());
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,170 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/types/sparse_matrix.hpp"
+
+// Тест для построения из COO
+TEST(SparseMatrixTest, BuildFromTriplets) {
+    CooBuilder<int> coo(3, 4);
+    coo.add(2, 1, 5);
+    coo.add(0, 3, 1);
+    coo.add(0, 0, 2);
+    coo.add(2, 1, 4);  // дубликат суммируется
+
+    SparseMatrix<int> mat = coo.build();
+
+    EXPECT_EQ(mat.getRows(), 3u);
+    EXPECT_EQ(mat.getCols(), 4u);
+    EXPECT_EQ(mat.nonZeros(), 3u);
+    EXPECT_EQ(mat.at(0, 0), 2);
+    EXPECT_EQ(mat.at(0, 3), 1);
+    EXPECT_EQ(mat.at(2, 1), 9);
+    EXPECT_EQ(mat.at(1, 1), 0);
+    EXPECT_EQ(mat.getOffsets(), (std::vector<size_t>{0, 2, 2, 3}));
+}
+
+TEST(SparseMatrixTest, DenseRoundTrip) {
+    Matrix<int> dense(2, 3);
+    dense[0][1] = 7;
+    dense[1][0] = -1; dense[1][2] = 4;
+
+    SparseMatrix<int> csr = SparseMatrix<int>::fromDense(dense);
+    SparseMatrix<int> csc = SparseMatrix<int>::fromDense(dense, SparseFormat::CSC);
+
+    EXPECT_EQ(csr.nonZeros(), 3u);
+    EXPECT_EQ(csc.getFormat(), SparseFormat::CSC);
+    EXPECT_TRUE(csr == csc);
+    EXPECT_TRUE(csr.toDense() == dense);
+    EXPECT_TRUE(csc.toDense() == dense);
+    EXPECT_TRUE(csc.toCSR() == csr);
+}
+
+// Тест для SpMV в обоих форматах
+TEST(SparseMatrixTest, MatrixVectorProduct) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const size_t n = 100000;
+    CooBuilder<double> coo(n, n);
+    for (size_t i = 0; i < n; ++i) {
+        coo.add(i, i, 2.0);
+        if (i > 0) coo.add(i, i - 1, -1.0);
+        if (i + 1 < n) coo.add(i, i + 1, -1.0);
+    }
+    Vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = static_cast<double>(i % 7);
+    }
+
+    Vector<double> y = coo.build() * x;
+    Vector<double> z = coo.build(SparseFormat::CSC) * x;
+    pool.resize(threads);
+
+    for (size_t i = 0; i < n; ++i) {
+        double expected = 2.0 * x[i];
+        if (i > 0) expected -= x[i - 1];
+        if (i + 1 < n) expected -= x[i + 1];
+        ASSERT_DOUBLE_EQ(y[i], expected);
+        ASSERT_DOUBLE_EQ(z[i], expected);
+    }
+}
+
+// Тест для SpMV в формате CSC: результат не зависит от числа потоков
+TEST(SparseMatrixTest, ScatterIsDeterministic) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+
+    // Каждая строка получает вклады из столбцов, разнесённых по разным кускам
+    const size_t n = 40000;
+    CooBuilder<double> coo(n, n);
+    for (size_t j = 0; j < n; ++j) {
+        for (size_t k = 0; k < 8; ++k) {
+            coo.add((j * 7 + k * 5003) % n, j, 0.1 * static_cast<double>((j + k) % 13) - 0.35);
+        }
+    }
+    const SparseMatrix<double> csc = coo.build(SparseFormat::CSC);
+    Vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = 1.0 / static_cast<double>(i % 11 + 1);
+    }
+
+    pool.resize(1);
+    const Vector<double> serial = csc * x;
+    pool.resize(3);
+    const Vector<double> three = csc * x;
+    pool.resize(threads);
+
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(serial[i], three[i]) << i;
+    }
+}
+
+// Тест для SpMM и сложения с плотной матрицей
+TEST(SparseMatrixTest, MatrixMatrixProductAndAddition) {
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> dist(-3, 3);
+    Matrix<int> dense(6, 5), other(5, 4), same(6, 5);
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            dense[i][j] = (i + j) % 3 == 0 ? dist(gen) : 0;
+            same[i][j] = dist(gen);
+        }
+    }
+    for (int i = 0; i < 5; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            other[i][j] = dist(gen);
+        }
+    }
+
+    SparseMatrix<int> sparse = SparseMatrix<int>::fromDense(dense, SparseFormat::CSC);
+
+    EXPECT_TRUE(sparse * other == dense * other);
+    Matrix<int> sum = same + sparse;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            EXPECT_EQ(sum[i][j], dense[i][j] + same[i][j]);
+        }
+    }
+}
+
+// Тесты на исключения
+TEST(SparseMatrixTest, Errors) {
+    CooBuilder<int> coo(2, 2);
+    EXPECT_THROW(coo.add(2, 0, 1), std::out_of_range);
+    EXPECT_THROW(SparseMatrix<int>(2, 2, SparseFormat::CSR, {0, 1, 1}, {0}, {}), std::invalid_argument);
+    EXPECT_THROW(coo.build() * Vector<int>(3), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,154 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/types/sparse_vector.hpp"
+
+// Тест для преобразования в плотный вектор и обратно
+TEST(SparseVectorTest, DenseRoundTrip) {
+    Vector<double> dense(6);
+    dense[1] = 2.0;
+    dense[4] = -3.0;
+
+    const auto sparse = SparseVector<double>::fromDense(dense);
+    EXPECT_EQ(sparse.size(), 6u);
+    EXPECT_EQ(sparse.nonZeros(), 2u);
+    EXPECT_EQ(sparse.getIndices(), (std::vector<size_t>{1, 4}));
+    EXPECT_DOUBLE_EQ(sparse.at(4), -3.0);
+    EXPECT_DOUBLE_EQ(sparse.at(0), 0.0);
+    EXPECT_EQ(sparse.toDense(), dense);
+    EXPECT_THROW(sparse.at(6), std::out_of_range);
+
+    EXPECT_THROW(SparseVector<double>(5, {3, 1}, {1.0, 2.0}), std::invalid_argument);
+    EXPECT_THROW(SparseVector<double>(5, {1, 5}, {1.0, 2.0}), std::invalid_argument);
+    EXPECT_THROW(SparseVector<double>(5, {1}, {1.0, 2.0}), std::invalid_argument);
+}
+
+// Тест для скалярного произведения с плотным и разреженным вектором
+TEST(SparseVectorTest, DotProducts) {
+    const SparseVector<double> a(10, {0, 3, 7}, {1.0, 2.0, 3.0});
+    const SparseVector<double> b(10, {3, 5, 7, 9}, {4.0, 5.0, 6.0, 7.0});
+
+    Vector<double> dense(10);
+    for (size_t i = 0; i < dense.size(); ++i) {
+        dense[i] = static_cast<double>(i);
+    }
+    EXPECT_DOUBLE_EQ(a.dot(dense), 0.0 + 6.0 + 21.0);
+    EXPECT_DOUBLE_EQ(a.dot(dense.slice(0, 10)), 27.0);
+    EXPECT_DOUBLE_EQ(a.dot(b), 2.0 * 4.0 + 3.0 * 6.0);
+    EXPECT_DOUBLE_EQ(b.dot(a), a.dot(b));
+    EXPECT_DOUBLE_EQ(a.dot(SparseVector<double>(10)), 0.0);
+
+    EXPECT_THROW(a.dot(Vector<double>(9)), std::invalid_argument);
+    EXPECT_THROW(a.dot(SparseVector<double>(9)), std::invalid_argument);
+}
+
+// Тест для сложения и вычитания слиянием
+TEST(SparseVectorTest, Merge) {
+    const SparseVector<int> a(8, {0, 2, 5}, {1, 2, 3});
+    const SparseVector<int> b(8, {2, 3, 7}, {-2, 4, 5});
+
+    const auto sum = a + b;
+    EXPECT_EQ(sum.getIndices(), (std::vector<size_t>{0, 3, 5, 7})); // 2 + (-2) = 0 выброшен
+    EXPECT_EQ(sum.getValues(), (std::vector<int>{1, 4, 3, 5}));
+
+    const auto difference = a - b;
+    EXPECT_EQ(difference.getIndices(), (std::vector<size_t>{0, 2, 3, 5, 7}));
+    EXPECT_EQ(difference.getValues(), (std::vector<int>{1, 4, -4, 3, -5}));
+
+    EXPECT_EQ((a - a).nonZeros(), 0u);
+    EXPECT_EQ((2 * a).getValues(), (std::vector<int>{2, 4, 6}));
+    EXPECT_EQ((a * 0).nonZeros(), 0u);
+    EXPECT_THROW(a + SparseVector<int>(7), std::invalid_argument);
+}
+
+// Тест для axpy, gather и scatter
+TEST(SparseVectorTest, AxpyGatherScatter) {
+    const SparseVector<double> x(5, {1, 3}, {2.0, -1.0});
+    Vector<double> y(5);
+    for (size_t i = 0; i < y.size(); ++i) {
+        y[i] = 1.0;
+    }
+
+    x.axpy(3.0, y);
+    EXPECT_DOUBLE_EQ(y[0], 1.0);
+    EXPECT_DOUBLE_EQ(y[1], 7.0);
+    EXPECT_DOUBLE_EQ(y[3], -2.0);
+
+    const auto g = SparseVector<double>::gather(y, {0, 3});
+    EXPECT_EQ(g.getValues(), (std::vector<double>{1.0, -2.0}));
+
+    x.scatter(y);
+    EXPECT_DOUBLE_EQ(y[1], 2.0);
+    EXPECT_DOUBLE_EQ(y[3], -1.0);
+    EXPECT_DOUBLE_EQ(y[4], 1.0);
+
+    EXPECT_THROW(SparseVector<double>::gather(y, {5}), std::invalid_argument);
+    Vector<double> shorter(4);
+    EXPECT_THROW(x.axpy(1.0, shorter), std::invalid_argument);
+}
+
+// Тест для длинных векторов: результат совпадает с плотным вычислением на всех наборах инструкций
+TEST(SparseVectorTest, MatchesDenseOnLongVectors) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::bernoulli_distribution present(0.01);
+
+    const size_t n = 200000;
+    Vector<double> da(n), db(n), x(n);
+    for (size_t i = 0; i < n; ++i) {
+        da[i] = present(gen) ? value(gen) : 0.0;
+        db[i] = present(gen) ? value(gen) : 0.0;
+        x[i] = value(gen);
+    }
+    const auto a = SparseVector<double>::fromDense(da);
+    const auto b = SparseVector<double>::fromDense(db);
+
+    const kernels::Isa isa = kernels::activeIsa();
+    for (kernels::Isa target : {kernels::Isa::Scalar, kernels::Isa::SSE2, kernels::Isa::AVX2, kernels::Isa::AVX512}) {
+        kernels::setIsa(target);
+        EXPECT_NEAR(a.dot(x), da.dot(x), 1e-9);
+    }
+    kernels::setIsa(isa);
+
+    EXPECT_NEAR(a.dot(b), da.dot(db), 1e-12);
+    // Короткий вектор против длинного: двоичный поиск вместо слияния
+    const SparseVector<double> shortVector(n, {b.getIndices()[0], b.getIndices()[5], n - 1}, {1.0, 2.0, 3.0});
+    EXPECT_NEAR(shortVector.dot(b), b.getValues()[0] + 2.0 * b.getValues()[5] + 3.0 * db[n - 1], 1e-12);
+
+    const Vector<double> sum = da + db;
+    EXPECT_EQ((a + b).toDense(), sum);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
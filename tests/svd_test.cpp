@@ -0,0 +1,148 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../include/linalg/eigen.hpp"
+#include "../include/linalg/svd.hpp"
+#include "test_utils.hpp"
+
+// Проверяет A = U diag(s) V^T и ортонормальность столбцов U и V
+static void expectDecomposition(const Matrix<double>& mat, const SVD<double>& svd, double tol) {
+    const int m = mat.getRows(), n = mat.getCols(), k = std::min(m, n);
+    Vector<double> s = svd.getSingularValues();
+    Matrix<double> u = svd.getU();
+    Matrix<double> v = svd.getV();
+    ASSERT_EQ(u.getRows(), m);
+    ASSERT_EQ(u.getCols(), k);
+    ASSERT_EQ(v.getRows(), n);
+    ASSERT_EQ(v.getCols(), k);
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (int p = 0; p < k; ++p) {
+                sum += u(i, p) * s[p] * v(j, p);
+            }
+            ASSERT_NEAR(sum, mat(i, j), tol);
+        }
+    }
+    for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < k; ++j) {
+            double uu = 0.0, vv = 0.0;
+            for (int p = 0; p < m; ++p) {
+                uu += u(p, i) * u(p, j);
+            }
+            for (int p = 0; p < n; ++p) {
+                vv += v(p, i) * v(p, j);
+            }
+            ASSERT_NEAR(uu, i == j ? 1.0 : 0.0, tol);
+            ASSERT_NEAR(vv, i == j ? 1.0 : 0.0, tol);
+        }
+    }
+    for (int i = 1; i < k; ++i) {
+        EXPECT_GE(s[i - 1], s[i]);
+    }
+}
+
+TEST(SVDTest, Diagonal) {
+    Matrix<double> mat(3, 2);
+    mat[0][0] = 2;
+    mat[1][1] = -3;
+
+    SVD<double> svd(mat);
+    Vector<double> s = svd.getSingularValues();
+
+    EXPECT_NEAR(s[0], 3.0, 1e-15);
+    EXPECT_NEAR(s[1], 2.0, 1e-15);
+    expectDecomposition(mat, svd, 1e-15);
+    EXPECT_NEAR(svd.cond(), 1.5, 1e-15);
+}
+
+TEST(SVDTest, TallAndWide) {
+    // Больше одной панели QR и нечётное число столбцов для круговой схемы
+    for (auto [m, n] : {std::pair{1, 1}, {5, 3}, {3, 5}, {120, 71}, {71, 120}, {90, 90}}) {
+        Matrix<double> mat = randomMatrix(m, n, m * 1000 + n);
+        SVD<double> svd(mat);
+        expectDecomposition(mat, svd, 1e-12);
+        EXPECT_EQ(svd.rank(), static_cast<size_t>(std::min(m, n)));
+    }
+}
+
+TEST(SVDTest, MatchesEigenvaluesOfGram) {
+    Matrix<double> mat = randomMatrix(60, 25, 5);
+    Matrix<double> gram(25, 25);
+    for (int i = 0; i < 25; ++i) {
+        for (int j = 0; j < 25; ++j) {
+            for (int p = 0; p < 60; ++p) {
+                gram(i, j) += mat(p, i) * mat(p, j);
+            }
+        }
+    }
+    Vector<double> s = singularValues(mat);
+    Vector<double> w = symmetricEigenvalues(gram);
+    for (int i = 0; i < 25; ++i) {
+        EXPECT_NEAR(s[i] * s[i], w[24 - i], 1e-11);
+    }
+}
+
+TEST(SVDTest, RankDeficient) {
+    // Последние столбцы повторяют первые семь
+    Matrix<double> mat = randomMatrix(40, 30, 9);
+    for (int i = 0; i < 40; ++i) {
+        for (int j = 7; j < 30; ++j) {
+            mat(i, j) = 2.0 * mat(i, j % 7);
+        }
+    }
+    SVD<double> svd(mat);
+    expectDecomposition(mat, svd, 1e-12);
+    EXPECT_EQ(svd.rank(), 7u);
+
+    // Полностью нулевая матрица: U всё равно ортонормальна
+    Matrix<double> zero(4, 3);
+    SVD<double> empty(zero);
+    expectDecomposition(zero, empty, 1e-15);
+    EXPECT_EQ(empty.rank(), 0u);
+}
+
+TEST(SVDTest, ValuesOnly) {
+    Matrix<double> mat = randomMatrix(50, 30, 2);
+    Vector<double> full = SVD<double>(mat).getSingularValues();
+    SVD<double> svd(mat, false);
+    Vector<double> s = svd.getSingularValues();
+    for (int i = 0; i < 30; ++i) {
+        EXPECT_NEAR(s[i], full[i], 1e-12);
+    }
+    EXPECT_THROW(svd.getU(), std::logic_error);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
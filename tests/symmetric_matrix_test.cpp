@@ -0,0 +1,96 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include "../include/types/symmetric_matrix.hpp"
+#include "test_utils.hpp"
+
+// Тест для упаковки и общего элемента (i, j) == (j, i)
+TEST(SymmetricMatrixTest, StorageAndRoundTrip) {
+    SymmetricMatrix<int> sym(3);
+    sym(0, 1) = 5;
+    sym(2, 2) = 1;
+    sym(2, 0) = -3;
+
+    EXPECT_EQ(sym.at(1, 0), 5);
+    EXPECT_EQ(sym.at(0, 2), -3);
+
+    Matrix<int> dense = sym.toDense();
+    EXPECT_EQ(dense[0][1], 5);
+    EXPECT_EQ(dense[1][0], 5);
+    EXPECT_EQ(dense[0][2], -3);
+    EXPECT_EQ(dense[2][0], -3);
+    EXPECT_TRUE(SymmetricMatrix<int>::fromDense(dense).toDense() == dense);
+}
+
+// Тест для SYMV и SYMM в сравнении с плотным умножением
+TEST(SymmetricMatrixTest, Products) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const size_t n = 300;
+    Matrix<double> dense = randomSymmetric(n, 1);
+    Matrix<double> b = randomSymmetric(n, 2);
+    Vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = std::cos(static_cast<double>(i));
+    }
+
+    SymmetricMatrix<double> sym = SymmetricMatrix<double>::fromDense(dense);
+    Vector<double> y = sym * x;
+    Vector<double> expectedY = dense * x;
+    Matrix<double> c = sym * b;
+    Matrix<double> expectedC = dense * b;
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_NEAR(y[i], expectedY[i], 1e-10);
+        for (size_t j = 0; j < n; ++j) {
+            EXPECT_NEAR(c[i][j], expectedC[i][j], 1e-10);
+        }
+    }
+
+    pool.resize(threads);
+}
+
+// Тест для ошибок
+TEST(SymmetricMatrixTest, Errors) {
+    SymmetricMatrix<double> sym(3);
+
+    EXPECT_THROW(sym(3, 0), std::out_of_range);
+    EXPECT_THROW(sym.at(0, 3), std::out_of_range);
+    EXPECT_THROW(sym * Vector<double>(2), std::invalid_argument);
+    EXPECT_THROW(sym * Matrix<double>(2, 2), std::invalid_argument);
+    EXPECT_THROW(SymmetricMatrix<double>::fromDense(Matrix<double>(3, 2)), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,137 @@
+/*
+ * COPYRIGHT (c) 2024 Massonskyi
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ *    may be used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include "../include/types/triangular_matrix.hpp"
+#include "test_utils.hpp"
+
+// Тест для упаковки и распаковки
+TEST(TriangularMatrixTest, DenseRoundTrip) {
+    Matrix<int> dense(3, 3);
+    dense[0][0] = 1; dense[0][1] = 2; dense[0][2] = 3;
+    dense[1][0] = 4; dense[1][1] = 5; dense[1][2] = 6;
+    dense[2][0] = 7; dense[2][1] = 8; dense[2][2] = 9;
+
+    TriangularMatrix<int> lower = TriangularMatrix<int>::fromDense(dense);
+    TriangularMatrix<int> upper = TriangularMatrix<int>::fromDense(dense, Triangle::Upper);
+
+    EXPECT_EQ(lower.at(2, 1), 8);
+    EXPECT_EQ(lower.at(0, 2), 0);
+    EXPECT_EQ(upper.at(1, 2), 6);
+    EXPECT_EQ(upper.at(2, 0), 0);
+
+    Matrix<int> l = lower.toDense();
+    Matrix<int> u = upper.toDense();
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            EXPECT_EQ(l[i][j], j <= i ? dense[i][j] : 0);
+            EXPECT_EQ(u[i][j], j >= i ? dense[i][j] : 0);
+        }
+    }
+}
+
+// Тест для TRMV и TRMM в сравнении с плотным умножением
+TEST(TriangularMatrixTest, Products) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const size_t n = 150;
+    Matrix<double> dense = randomMatrix(n, n, 1, -1.0, 1.0, 4.0);
+    Matrix<double> b = randomMatrix(n, n, 2, -1.0, 1.0, 4.0);
+    Vector<double> x(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = std::sin(static_cast<double>(i));
+    }
+
+    for (Triangle triangle : {Triangle::Lower, Triangle::Upper}) {
+        TriangularMatrix<double> tri = TriangularMatrix<double>::fromDense(dense, triangle);
+        Matrix<double> full = tri.toDense();
+        Vector<double> y = tri * x;
+        Vector<double> expectedY = full * x;
+        Matrix<double> c = tri * b;
+        Matrix<double> expectedC = full * b;
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(y[i], expectedY[i], 1e-10);
+            for (size_t j = 0; j < n; ++j) {
+                EXPECT_NEAR(c[i][j], expectedC[i][j], 1e-10);
+            }
+        }
+    }
+
+    pool.resize(threads);
+}
+
+// Тест для TRSV и TRSM
+TEST(TriangularMatrixTest, Solve) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const size_t n = 120;
+    Matrix<double> dense = randomMatrix(n, n, 3, -1.0, 1.0, 4.0);
+    Matrix<double> b = randomMatrix(n, n, 4, -1.0, 1.0, 4.0);
+    Vector<double> rhs(n);
+    for (size_t i = 0; i < n; ++i) {
+        rhs[i] = 1.0 + i % 5;
+    }
+
+    for (Triangle triangle : {Triangle::Lower, Triangle::Upper}) {
+        TriangularMatrix<double> tri = TriangularMatrix<double>::fromDense(dense, triangle);
+        Vector<double> r = tri * tri.solve(rhs);
+        Matrix<double> c = tri * tri.solve(b);
+        for (size_t i = 0; i < n; ++i) {
+            EXPECT_NEAR(r[i], rhs[i], 1e-9);
+            for (size_t j = 0; j < n; ++j) {
+                EXPECT_NEAR(c[i][j], b[i][j], 1e-9);
+            }
+        }
+    }
+
+    pool.resize(threads);
+}
+
+// Тест для ошибок
+TEST(TriangularMatrixTest, Errors) {
+    TriangularMatrix<double> tri(3, Triangle::Upper);
+    tri(0, 0) = 1.0;
+    tri(1, 1) = 1.0;
+
+    EXPECT_THROW(tri(2, 1), std::out_of_range);
+    EXPECT_THROW(tri.at(3, 0), std::out_of_range);
+    EXPECT_THROW(tri.solve(Vector<double>(3)), std::invalid_argument);
+    EXPECT_THROW(tri * Vector<double>(2), std::invalid_argument);
+    EXPECT_THROW(TriangularMatrix<double>::fromDense(Matrix<double>(2, 3)), std::invalid_argument);
+}
+
+// Запуск тестов
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
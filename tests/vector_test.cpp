@@ -28,8 +28,50 @@
  */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <utility>
 #include "../include/types/vector.hpp"  // Убедитесь, что путь к вашему файлу Vector.h верный
 
+// Счётчик выделений памяти для проверки, что цепочки операций не копируют буферы
+static std::atomic<size_t> gAllocations{0};
+
+void* operator new(size_t size) {
+    ++gAllocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t align) {
+    ++gAllocations;
+    const size_t a = static_cast<size_t>(align);
+    if (void* p = std::aligned_alloc(a, (size + a - 1) / a * a)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// Не встраиваются: иначе GCC видит пару operator new / free и выдаёт -Wmismatched-new-delete
+[[gnu::noinline]] void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
 // Тест для конструктора
 TEST(VectorTest, DefaultConstructor) {
     Vector<int> vec;
@@ -203,6 +245,432 @@ TEST(VectorTest, Input) {
     EXPECT_EQ(vec[2], 3);
 }
 
+// Тест для вектора фиксированного размера
+TEST(VectorTest, FixedSizeArithmetic) {
+    constexpr Vector<double, 3> a(1.0, 2.0, 3.0);
+    constexpr Vector<double, 3> b(4.0, 5.0, 6.0);
+
+    // Операции вычисляются на этапе компиляции
+    static_assert((a + b) == Vector<double, 3>(5.0, 7.0, 9.0));
+    static_assert(a.dot(b) == 32.0);
+    static_assert(a.cross(b) == Vector<double, 3>(-3.0, 6.0, -3.0));
+    static_assert(sizeof(Vector<float, 4>) == 4 * sizeof(float));
+
+    Vector<double, 3> c = a;
+    c += b;
+    c *= Vector<double, 3>::filled(2.0);
+    EXPECT_EQ(c, (Vector<double, 3>(10.0, 14.0, 18.0)));
+    EXPECT_EQ(c / 2.0, a + b);
+    EXPECT_EQ(-a, a * -1.0);
+    EXPECT_THROW(c[3], std::out_of_range);
+    EXPECT_THROW((a / Vector<double, 3>(1.0, 0.0, 1.0)), std::invalid_argument);
+}
+
+// Тест для преобразования между фиксированным и динамическим вектором
+TEST(VectorTest, FixedSizeDynamicInterop) {
+    Vector<int, 3> fixed(1, 2, 3);
+    Vector<int> dynamic = fixed.toDynamic();
+
+    EXPECT_EQ(dynamic.size(), 3u);
+    EXPECT_EQ(dynamic[2], 3);
+    EXPECT_EQ((Vector<int, 3>(dynamic)), fixed);
+    EXPECT_THROW((Vector<int, 2>(dynamic)), std::invalid_argument);
+}
+
+// Тест для ленивых выражений: вычисление за один проход
+TEST(VectorTest, FusedExpression) {
+    Vector<int> a(4), b(4), c(4), d(4);
+    for (int i = 0; i < 4; ++i) {
+        a[i] = i;
+        b[i] = 2;
+        c[i] = i + 1;
+        d[i] = 1;
+    }
+
+    Vector<int> result = a + b * c - d;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(result[i], i + 2 * (i + 1) - 1);
+    }
+
+    // Присваивание в себя переиспользует буфер
+    const int* buffer = a.begin();
+    a = a * c + a;
+    EXPECT_EQ(a.begin(), buffer);
+    EXPECT_EQ(a[3], 3 * 4 + 3);
+
+    EXPECT_THROW(a + Vector<int>(3), std::invalid_argument);
+    EXPECT_THROW(a / (b - b), std::invalid_argument);
+}
+
+// Тест для составного присваивания на месте
+TEST(VectorTest, InPlaceCompoundAssignment) {
+    Vector<double> a(3), b(3);
+    a[0] = 1.0; a[1] = 2.0; a[2] = 3.0;
+    b[0] = 2.0; b[1] = 2.0; b[2] = 2.0;
+
+    const double* buffer = a.begin();
+    a += b * b;
+    a -= b;
+    a *= b;
+    a /= b + b;
+    EXPECT_EQ(a.begin(), buffer);
+    EXPECT_DOUBLE_EQ(a[0], 1.5);
+    EXPECT_DOUBLE_EQ(a[1], 2.0);
+    EXPECT_DOUBLE_EQ(a[2], 2.5);
+
+    EXPECT_THROW(a /= b - b, std::invalid_argument);
+    EXPECT_DOUBLE_EQ(a[0], 1.5); // при ошибке вектор не изменяется
+    EXPECT_THROW(a += Vector<double>(2), std::invalid_argument);
+}
+
+// Тест для редукций
+TEST(VectorTest, Reductions) {
+    Vector<double> a(5), b(5);
+    const double values[] = {3.0, -4.0, 1.0, -4.0, 5.0};
+    for (int i = 0; i < 5; ++i) {
+        a[i] = values[i];
+        b[i] = 1.0 + i;
+    }
+
+    EXPECT_DOUBLE_EQ(a.sum(), 1.0);
+    EXPECT_DOUBLE_EQ(a.mean(), 0.2);
+    EXPECT_DOUBLE_EQ(a.dot(b), 3.0 - 8.0 + 3.0 - 16.0 + 25.0);
+    EXPECT_DOUBLE_EQ(a.norm1(), 17.0);
+    EXPECT_DOUBLE_EQ(a.norm2(), std::sqrt(67.0));
+    EXPECT_DOUBLE_EQ(a.normInf(), 5.0);
+    EXPECT_DOUBLE_EQ(a.min(), -4.0);
+    EXPECT_DOUBLE_EQ(a.max(), 5.0);
+    EXPECT_EQ(a.argmin(), 1u); // первое вхождение
+    EXPECT_EQ(a.argmax(), 4u);
+
+    Vector<int> c(3);
+    c[0] = 7; c[1] = -2; c[2] = 7;
+    EXPECT_EQ(c.sum(), 12);
+    EXPECT_EQ(c.norm1(), 16);
+    EXPECT_EQ(c.argmax(), 0u);
+
+    EXPECT_THROW(Vector<double>().min(), std::invalid_argument);
+    EXPECT_THROW(Vector<double>().mean(), std::invalid_argument);
+    EXPECT_THROW(a.dot(Vector<double>(2)), std::invalid_argument);
+    EXPECT_EQ(Vector<double>().sum(), 0.0);
+}
+
+// Тест для длинных векторов: параллельная и компенсированная редукция
+TEST(VectorTest, LongReductions) {
+    auto& pool = kernels::ThreadPool::instance();
+    const size_t threads = pool.size();
+    pool.resize(4);
+
+    const size_t n = 1000003;
+    Vector<float> x(n);
+    for (size_t i = 0; i < n; ++i) {
+        x[i] = 0.1f;
+    }
+    x[n / 2] = -3.0f;
+    x[n - 1] = 2.5f;
+
+    const double exact = 0.1f * (n - 2) - 3.0 + 2.5;
+    const float plain = x.sum();
+    const float compensated = x.sum(kernels::Summation::Compensated);
+    EXPECT_NEAR(compensated, exact, 1e-7 * exact);
+    EXPECT_LE(std::abs(compensated - exact), std::abs(plain - exact));
+    EXPECT_EQ(x.argmin(), n / 2);
+    EXPECT_EQ(x.argmax(), n - 1);
+    EXPECT_FLOAT_EQ(x.normInf(), 3.0f);
+
+    // Результат не зависит от числа потоков
+    pool.resize(1);
+    EXPECT_EQ(x.sum(), plain);
+    EXPECT_EQ(x.sum(kernels::Summation::Compensated), compensated);
+
+    pool.resize(threads);
+}
+
+// Тест для срезов: изменения через представление видны в векторе
+TEST(VectorTest, Slices) {
+    Vector<double> v(8);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = static_cast<double>(i);
+    }
+
+    auto middle = v.slice(2, 4);
+    EXPECT_EQ(middle.size(), 4u);
+    EXPECT_EQ(middle.begin(), v.begin() + 2);
+    middle[0] = 20.0;
+    EXPECT_DOUBLE_EQ(v[2], 20.0);
+    EXPECT_DOUBLE_EQ(middle.sum(), 20.0 + 3.0 + 4.0 + 5.0);
+    EXPECT_EQ(middle.argmax(), 0u);
+
+    // Каждый второй элемент, начиная с первого
+    auto odd = v.slice(1, 4, 2);
+    EXPECT_EQ(odd.size(), 4u);
+    EXPECT_DOUBLE_EQ(odd[3], 7.0);
+    EXPECT_DOUBLE_EQ(odd.sum(), 1.0 + 3.0 + 5.0 + 7.0);
+    EXPECT_DOUBLE_EQ(odd.dot(middle), 1.0 * 20.0 + 3.0 * 3.0 + 5.0 * 4.0 + 7.0 * 5.0);
+
+    const Vector<double> copy(odd);
+    EXPECT_EQ(copy.size(), 4u);
+    EXPECT_DOUBLE_EQ(copy[2], 5.0);
+
+    EXPECT_THROW(v.slice(6, 3), std::out_of_range);
+    EXPECT_THROW(v.slice(1, 5, 2), std::out_of_range);
+    EXPECT_THROW(v.slice(0, 2, 0), std::out_of_range);
+    EXPECT_THROW(middle[4], std::out_of_range);
+    EXPECT_EQ(v.getData().size(), 8u);
+}
+
+// Тест для выражений над представлениями
+TEST(VectorTest, ViewExpressions) {
+    Vector<double> v(6);
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = static_cast<double>(i + 1);
+    }
+
+    // Сумма двух половин вектора без копирования
+    const Vector<double> halves = v.slice(0, 3) + v.slice(3, 3);
+    EXPECT_DOUBLE_EQ(halves[0], 5.0);
+    EXPECT_DOUBLE_EQ(halves[2], 9.0);
+
+    // Запись выражения в срез
+    v.slice(0, 3) = halves + halves;
+    EXPECT_DOUBLE_EQ(v[0], 10.0);
+    EXPECT_DOUBLE_EQ(v[2], 18.0);
+    EXPECT_DOUBLE_EQ(v[3], 4.0);
+
+    // Составные операции на страйдовом представлении
+    auto even = v.slice(0, 3, 2);
+    Vector<double> ones(3);
+    ones[0] = ones[1] = ones[2] = 1.0;
+    even += ones;
+    EXPECT_DOUBLE_EQ(v[0], 11.0);
+    EXPECT_DOUBLE_EQ(v[1], 14.0);
+    EXPECT_DOUBLE_EQ(v[4], 6.0);
+    even -= even;
+    EXPECT_DOUBLE_EQ(v[2], 0.0);
+
+    EXPECT_THROW(v.slice(0, 2) = halves, std::invalid_argument);
+    EXPECT_THROW(v.slice(0, 3).dot(v.slice(0, 2)), std::invalid_argument);
+
+    // Перекрывающееся копирование сдвигает элементы
+    Vector<int> w(5);
+    for (size_t i = 0; i < w.size(); ++i) {
+        w[i] = static_cast<int>(i);
+    }
+    w.slice(1, 4) = w.slice(0, 4);
+    EXPECT_EQ(w[1], 0);
+    EXPECT_EQ(w[4], 3);
+}
+
+// Тест для выражений над перекрывающимися срезами одного вектора
+TEST(VectorTest, OverlappingViewExpressions) {
+    // Достаточно длинный вектор, чтобы вычисление делилось на части
+    const size_t n = 1 << 18;
+    Vector<double> v(n);
+    for (size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<double>(i % 7);
+    }
+    const Vector<double> original = v;
+
+    // Каждый элемент получает сумму со старым соседом, а не префиксную сумму
+    v.slice(1, n - 1) += v.slice(0, n - 1);
+    EXPECT_DOUBLE_EQ(v[0], original[0]);
+    for (size_t i = 1; i < n; ++i) {
+        ASSERT_DOUBLE_EQ(v[i], original[i] + original[i - 1]) << i;
+    }
+
+    v = original;
+    v.slice(0, n - 1) = v.slice(1, n - 1) * 2.0 + v.slice(0, n - 1);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        ASSERT_DOUBLE_EQ(v[i], 2.0 * original[i + 1] + original[i]) << i;
+    }
+    EXPECT_DOUBLE_EQ(v[n - 1], original[n - 1]);
+
+    // Страйдовые срезы со сдвигом на шаг
+    Vector<int> w(9);
+    for (size_t i = 0; i < w.size(); ++i) {
+        w[i] = static_cast<int>(i);
+    }
+    w.slice(2, 4, 2) += w.slice(0, 4, 2);
+    EXPECT_EQ(w[2], 2);
+    EXPECT_EQ(w[4], 6);
+    EXPECT_EQ(w[6], 10);
+    EXPECT_EQ(w[8], 14);
+    w.slice(1, 4, 2) = w.slice(0, 4, 2) + w.slice(1, 4, 2);
+    EXPECT_EQ(w[1], 1);
+    EXPECT_EQ(w[3], 5);
+
+    // Тождественный псевдоним вычисляется на месте
+    Vector<double> u(4);
+    u[0] = u[1] = u[2] = u[3] = 1.5;
+    u.slice(0, 4) *= u.slice(0, 4);
+    EXPECT_DOUBLE_EQ(u[3], 2.25);
+
+    // Срез самого вектора с другим размером
+    u = u.slice(1, 2) + u.slice(2, 2);
+    EXPECT_EQ(u.size(), 2u);
+    EXPECT_DOUBLE_EQ(u[0], 4.5);
+}
+
+// Тест для скаляров в выражениях
+TEST(VectorTest, ScalarBroadcast) {
+    Vector<double> x(5), y(5);
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = static_cast<double>(i);
+        y[i] = 1.0;
+    }
+
+    // y = a * x + y без промежуточных векторов
+    const double* buffer = y.begin();
+    y = 2.0 * x + y;
+    EXPECT_EQ(y.begin(), buffer);
+    EXPECT_DOUBLE_EQ(y[4], 9.0);
+
+    const Vector<double> shifted = x - 1.0;
+    EXPECT_DOUBLE_EQ(shifted[0], -1.0);
+    const Vector<double> scaled = x * 3 / 2.0;
+    EXPECT_DOUBLE_EQ(scaled[3], 4.5);
+    const Vector<double> mirrored = 10.0 - x;
+    EXPECT_DOUBLE_EQ(mirrored[4], 6.0);
+
+    y *= 0.5;
+    y += 1.0;
+    EXPECT_DOUBLE_EQ(y[4], 5.5);
+    y.slice(0, 2) -= 1.0;
+    y.slice(1, 2, 3) /= 2.0;
+    EXPECT_DOUBLE_EQ(y[0], 1.5 - 1.0);
+    EXPECT_DOUBLE_EQ(y[1], (2.5 - 1.0) / 2.0);
+    EXPECT_DOUBLE_EQ(y[4], 5.5 / 2.0);
+
+    EXPECT_THROW(x / 0.0, std::invalid_argument);
+    EXPECT_THROW(1.0 / x, std::invalid_argument); // x[0] == 0
+    EXPECT_THROW(y /= 0.0, std::invalid_argument);
+    EXPECT_DOUBLE_EQ(y[4], 5.5 / 2.0); // вектор не изменился
+}
+
+TEST(VectorTest, BoundsPolicies) {
+    Vector<double> checked(3);
+    EXPECT_THROW(checked[3], std::out_of_range);
+    checked.unchecked(2) = 5.0;
+    EXPECT_DOUBLE_EQ(checked[2], 5.0);
+
+    // Без проверки индексов operator[] — обычное обращение к памяти
+    Vector<double, Dynamic, Unchecked> fast(checked);
+    fast[0] = 1.0;
+    EXPECT_DOUBLE_EQ(fast[0], 1.0);
+    EXPECT_DOUBLE_EQ(fast[2], 5.0);
+
+    // Выражения и редукции работают независимо от политики
+    const Vector<double, Dynamic, Unchecked> sum = fast + fast;
+    EXPECT_DOUBLE_EQ(sum.unchecked(2), 10.0);
+    EXPECT_DOUBLE_EQ(sum.sum(), 12.0);
+    EXPECT_DOUBLE_EQ(fast.dot(checked), 25.0);
+
+    // DebugChecked проверяет индексы только без NDEBUG
+    Vector<double, Dynamic, DebugChecked> debug(2);
+    if constexpr (DebugChecked::kEnabled) {
+        EXPECT_THROW(debug[2], std::out_of_range);
+    }
+    EXPECT_NO_THROW(debug[1]);
+
+    constexpr Vector<int, 3, Unchecked> small(1, 2, 3);
+    static_assert(small[2] == 3);
+    static_assert(small.unchecked(0) == 1);
+}
+
+TEST(VectorTest, CopyOnWrite) {
+    Vector<double> source(4);
+    source[0] = 1.0;
+    // Копия вектора, отдавшего ссылку на элемент, получает свой буфер
+    Vector<double> a = source;
+    EXPECT_NE(std::as_const(a).begin(), std::as_const(source).begin());
+    const Vector<double> b = a;
+    // Копия делит буфер с оригиналом до первой записи
+    EXPECT_EQ(std::as_const(a).begin(), b.begin());
+
+    a[1] = 2.0;
+    EXPECT_NE(std::as_const(a).begin(), b.begin());
+    EXPECT_DOUBLE_EQ(a[1], 2.0);
+    EXPECT_DOUBLE_EQ(b[1], 0.0);
+    EXPECT_DOUBLE_EQ(b[0], 1.0);
+
+    // Единственный владелец пишет на месте, без копирования
+    const double* before = std::as_const(a).begin();
+    a[2] = 3.0;
+    EXPECT_EQ(std::as_const(a).begin(), before);
+
+    // Составное присваивание разделяемого вектора читает старые значения
+    Vector<double> c = a;
+    c += a;
+    EXPECT_DOUBLE_EQ(c[2], 6.0);
+    EXPECT_DOUBLE_EQ(a[2], 3.0);
+
+    Vector<double> d(2);
+    d = a;
+    EXPECT_EQ(d.size(), 4u);
+    EXPECT_EQ(d.begin()[1], 2.0);
+    EXPECT_EQ(d, a);
+}
+
+TEST(VectorTest, CopyDoesNotSeeEarlierReferences) {
+    Vector<double> a(4);
+    double& r = a[0];
+    Vector<double> b = a;
+    r = 5.0;
+    EXPECT_DOUBLE_EQ(a[0], 5.0);
+    EXPECT_DOUBLE_EQ(b[0], 0.0);
+
+    // То же для представления, взятого до копирования
+    auto tail = a.slice(2, 2);
+    Vector<double> c;
+    c = a;
+    tail[0] = 7.0;
+    EXPECT_DOUBLE_EQ(a[2], 7.0);
+    EXPECT_DOUBLE_EQ(c[2], 0.0);
+}
+
+TEST(VectorTest, RvalueOperatorsReuseBuffer) {
+    static_assert(std::is_nothrow_move_constructible_v<Vector<double>>);
+    static_assert(std::is_nothrow_move_assignable_v<Vector<double>>);
+
+    Vector<double> a(64), b(64), c(64);
+    for (size_t i = 0; i < 64; ++i) {
+        a[i] = double(i);
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+    const auto twice = [](const Vector<double>& v) { return Vector<double>(v * 2.0); };
+
+    // Цепочка выделяет память только под первый временный вектор
+    size_t before = gAllocations;
+    Vector<double> t = a + b;
+    const double* buffer = std::as_const(t).begin();
+    Vector<double> r = std::move(t) * 2.0 - c + b;
+    EXPECT_EQ(gAllocations - before, 1u);
+    EXPECT_EQ(std::as_const(r).begin(), buffer);
+    EXPECT_DOUBLE_EQ(r[5], 11.0);
+
+    // Временный правый операнд тоже переиспользуется
+    before = gAllocations;
+    Vector<double> s = a - twice(b);
+    EXPECT_EQ(gAllocations - before, 1u);
+    EXPECT_DOUBLE_EQ(s[5], 3.0);
+
+    before = gAllocations;
+    Vector<double> u = 1.0 - (twice(a) + twice(b)) / 2.0;
+    EXPECT_EQ(gAllocations - before, 2u);
+    EXPECT_DOUBLE_EQ(u[5], -5.0);
+
+    before = gAllocations;
+    Vector<double> w;
+    w = std::move(u);
+    w = a + b; // размер совпадает — буфер переиспользуется
+    EXPECT_EQ(gAllocations - before, 0u);
+    EXPECT_DOUBLE_EQ(w[5], 6.0);
+
+    // Операнды-lvalue остаются ленивыми выражениями
+    static_assert(!std::is_same_v<decltype(a + b), Vector<double>>);
+}
+
 // Запуск тестов
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);